@@ -0,0 +1,608 @@
+// Mesures de performance des structures du moteur, sans fenêtre ni OpenGL.
+// Compilation : g++ Benchmarks.cpp TransformStore.cpp Bounds.cpp SpatialIndex.cpp ForestGenerator.cpp Heightfield.cpp ParticleEmitter.cpp JobSystem.cpp Flock.cpp StaticBatcher.cpp -O2 -pthread -o Benchmarks
+// Utilisation : Benchmarks [nom] (toutes les mesures sans argument)
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <thread>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "TransformStore.hpp"
+#include "Bounds.hpp"
+#include "SpatialIndex.hpp"
+#include "ForestGenerator.hpp"
+#include "Heightfield.hpp"
+#include "ParticleEmitter.hpp"
+#include "JobSystem.hpp"
+#include "Flock.hpp"
+#include "StaticBatcher.hpp"
+
+
+// Meilleur temps de plusieurs essais, en millisecondes
+template<typename Function>
+double measureMs(Function function, int repeats)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; r++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        function();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// Afficher une ligne de résultat : temps et éléments traités par seconde
+void printResult(const std::string& name, double ms, size_t count, const std::string& unit)
+{
+    std::cout << "  " << name << " : " << ms << " ms, " << (count / (ms / 1000.0)) / 1e6 << " M " << unit << "/s" << std::endl;
+}
+
+// Nombre flottant aléatoire entre a et b
+float randomRange(float a, float b)
+{
+    return a + (b - a) * (float)rand() / (float)RAND_MAX;
+}
+
+
+// Matrices de modèle et des normales : glm (translate * rotate * scale, inverse transposée) contre TransformStore
+void benchmarkTransforms()
+{
+    const size_t count = 100000;
+    std::cout << "Transformations (" << count << " objets)" << std::endl;
+
+    std::vector<glm::vec3> positions(count), scales(count);
+    std::vector<float> rotations(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        positions[i] = glm::vec3(randomRange(-150.0f, 150.0f), 0.0f, randomRange(-150.0f, 150.0f));
+        rotations[i] = randomRange(0.0f, 360.0f);
+        scales[i] = glm::vec3(randomRange(0.5f, 2.0f));
+    }
+
+    // Chemin d'origine : une matrice glm par objet
+    std::vector<TransformMatrices> glmMatrices(count);
+    double glmMs = measureMs([&]()
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            glm::mat4 model = glm::mat4(1.0f);
+            model = glm::translate(model, positions[i]);
+            model = glm::rotate(model, glm::radians(rotations[i]), glm::vec3(0.0f, 1.0f, 0.0f));
+            model = glm::scale(model, scales[i]);
+
+            glm::mat3 normal = glm::transpose(glm::inverse(glm::mat3(model)));
+            glmMatrices[i].world = model;
+            for (int c = 0; c < 3; c++)
+            {
+                glmMatrices[i].normal[c] = glm::vec4(normal[c], 0.0f);
+            }
+        }
+    }, 10);
+
+    TransformStore store;
+    for (size_t i = 0; i < count; i++)
+    {
+        store.add(positions[i], rotations[i], scales[i], false);
+    }
+
+    // Tous les objets déplacés : drapeaux puis calcul 4 objets à la fois
+    double storeMs = measureMs([&]()
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            store.setPosition((uint32_t)i, positions[i]);
+        }
+        store.update();
+    }, 10);
+
+    // Noyau seul (rotation et échelle déjà en SoA)
+    double kernelMs = measureMs([&]() { store.updateAll(); }, 10);
+
+    // Aucun objet modifié : les matrices en cache sont réutilisées
+    double cachedMs = measureMs([&]() { store.update(); }, 10);
+
+    // Écart maximal avec glm
+    float maxError = 0.0f;
+    for (size_t i = 0; i < count; i++)
+    {
+        const TransformMatrices& m = store.getMatrices((uint32_t)i);
+        for (int c = 0; c < 4; c++)
+        {
+            glm::vec4 d = glm::abs(m.world[c] - glmMatrices[i].world[c]);
+            maxError = glm::max(maxError, glm::max(glm::max(d.x, d.y), glm::max(d.z, d.w)));
+        }
+        for (int c = 0; c < 3; c++)
+        {
+            glm::vec4 d = glm::abs(m.normal[c] - glmMatrices[i].normal[c]);
+            maxError = glm::max(maxError, glm::max(glm::max(d.x, d.y), d.z));
+        }
+    }
+
+    printResult("glm", glmMs, count, "matrices");
+    printResult("TransformStore (tous modifies)", storeMs, count, "matrices");
+    printResult("TransformStore (noyau seul)", kernelMs, count, "matrices");
+    std::cout << "  TransformStore (aucun modifie) : " << cachedMs << " ms" << std::endl;
+    std::cout << "  Ecart maximal avec glm : " << maxError << std::endl;
+}
+
+
+// Index spatial contre parcours de toutes les boîtes (SoA SIMD), pour une forêt de densité constante
+// (un objet par 100 unités², comme la grille de la scène)
+void benchmarkSpatialIndex()
+{
+    const size_t counts[3] = { 10000, 100000, 1000000 };
+
+    for (size_t count : counts)
+    {
+        float worldSize = std::sqrt((float)count) * 10.0f;
+        std::cout << "Index spatial (" << count << " objets, zone de " << worldSize << " unites)" << std::endl;
+
+        std::vector<AABB> boxes(count);
+        AABBArray flatBoxes;
+        for (size_t i = 0; i < count; i++)
+        {
+            glm::vec3 center(randomRange(-0.5f, 0.5f) * worldSize, 0.0f, randomRange(-0.5f, 0.5f) * worldSize);
+            glm::vec3 extents(randomRange(0.3f, 2.0f), randomRange(1.0f, 6.0f), randomRange(0.3f, 2.0f));
+            boxes[i].min = center - glm::vec3(extents.x, 0.0f, extents.z);
+            boxes[i].max = center + glm::vec3(extents.x, extents.y * 2.0f, extents.z);
+            flatBoxes.push(boxes[i]);
+        }
+
+        // Profondeur : cellules les plus fines d'environ 5 unités
+        int depth = 1;
+        while (depth < 11 && worldSize / (float)(1 << depth) > 5.0f)
+        {
+            depth = depth + 1;
+        }
+        depth = depth + 1;
+
+        SpatialIndex index;
+        double buildMs = measureMs([&]()
+        {
+            index.init(glm::vec2(-0.5f * worldSize), worldSize, depth);
+            for (size_t i = 0; i < count; i++)
+            {
+                index.insert((uint32_t)i, boxes[i]);
+            }
+        }, 3);
+
+        // Caméra au centre, même projection que la scène
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(1.0f, 2.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        Frustum frustum = extractFrustum(projection * view);
+
+        std::vector<uint8_t> visible(count);
+        size_t flatVisible = 0;
+        double flatFrustumMs = measureMs([&]() { flatVisible = frustumCullAABB(flatBoxes, frustum, visible.data()); }, 10);
+
+        std::vector<uint32_t> result;
+        double indexFrustumMs = measureMs([&]() { result.clear(); index.queryFrustum(frustum, result); }, 10);
+        size_t indexVisible = result.size();
+
+        // Sphère d'une lampe (rayon 20)
+        std::vector<uint32_t> flatSphere;
+        double flatSphereMs = measureMs([&]()
+        {
+            flatSphere.clear();
+            for (size_t i = 0; i < count; i++)
+            {
+                glm::vec3 d = glm::max(glm::max(boxes[i].min - glm::vec3(5.0f), glm::vec3(5.0f) - boxes[i].max), glm::vec3(0.0f));
+                if (glm::dot(d, d) <= 400.0f)
+                {
+                    flatSphere.push_back((uint32_t)i);
+                }
+            }
+        }, 10);
+        double indexSphereMs = measureMs([&]() { result.clear(); index.querySphere(glm::vec3(5.0f), 20.0f, result); }, 10);
+        size_t indexSphere = result.size();
+
+        // Rayon horizontal sur 100 unités
+        double indexRayMs = measureMs([&]() { result.clear(); index.queryRay(glm::vec3(0.0f, 1.0f, 0.0f), glm::normalize(glm::vec3(1.0f, 0.0f, 0.3f)), 100.0f, result); }, 10);
+        size_t indexRay = result.size();
+
+        // 1 % des objets déplacés de quelques unités
+        size_t moved = count / 100;
+        double moveMs = measureMs([&]()
+        {
+            for (size_t k = 0; k < moved; k++)
+            {
+                size_t i = (k * 7919) % count;
+                glm::vec3 offset(randomRange(-3.0f, 3.0f), 0.0f, randomRange(-3.0f, 3.0f));
+                boxes[i].min = boxes[i].min + offset;
+                boxes[i].max = boxes[i].max + offset;
+                index.move((uint32_t)i, boxes[i]);
+            }
+        }, 3);
+
+        std::cout << "  Construction : " << buildMs << " ms" << std::endl;
+        std::cout << "  Pyramide : boites " << flatFrustumMs << " ms, index " << indexFrustumMs << " ms (" << flatVisible << " / " << indexVisible << " visibles)" << std::endl;
+        std::cout << "  Sphere : boites " << flatSphereMs << " ms, index " << indexSphereMs << " ms (" << flatSphere.size() << " / " << indexSphere << " touches)" << std::endl;
+        std::cout << "  Rayon : index " << indexRayMs << " ms (" << indexRay << " traverses)" << std::endl;
+        std::cout << "  Deplacement de " << moved << " objets : " << moveMs << " ms" << std::endl;
+    }
+}
+
+
+// Générateur de forêt : objets générés par seconde sur 1 thread et sur tous les threads,
+// et vérification que le résultat est identique dans les deux cas
+void benchmarkForest()
+{
+    ForestSettings settings;
+    settings.seed = 7;
+    settings.worldMin = glm::vec2(-1024.0f);
+    settings.worldSize = 2048.0f;
+    settings.species = { { 0, 8.0f }, { 1, 8.0f }, { 2, 8.0f }, { 3, 2.0f }, { 4, 2.0f }, { 5, 2.0f } };
+    settings.densities = { { 28.0f, 0.0f }, { 36.0f, 1.0f } };
+    ForestGenerator generator(settings);
+
+    int threadCount = (int)std::max(std::thread::hardware_concurrency(), 1u);
+    std::cout << "Foret (" << generator.getTilesPerSide() * generator.getTilesPerSide() << " tuiles, zone de " << settings.worldSize << " unites)" << std::endl;
+
+    std::vector<ForestInstance> single, parallel;
+    double singleMs = measureMs([&]() { single = generator.generate(1); }, 3);
+    double parallelMs = measureMs([&]() { parallel = generator.generate(threadCount); }, 3);
+
+    // Même graine : mêmes objets, dans le même ordre
+    bool identical = single.size() == parallel.size();
+    for (size_t i = 0; identical && i < single.size(); i++)
+    {
+        identical = single[i].model == parallel[i].model && single[i].position == parallel[i].position && single[i].yaw == parallel[i].yaw;
+    }
+
+    // Distance minimale effective (grille de cellules de minDistance pour ne comparer que les voisins)
+    float minDistance = 1e30f;
+    int cells = (int)(settings.worldSize / settings.minDistance) + 1;
+    std::vector<std::vector<uint32_t>> grid((size_t)cells * cells);
+    auto cellOf = [&](const glm::vec3& p) { return glm::clamp(glm::ivec2((glm::vec2(p.x, p.z) - settings.worldMin) / settings.minDistance), 0, cells - 1); };
+    for (size_t i = 0; i < single.size(); i++)
+    {
+        glm::ivec2 c = cellOf(single[i].position);
+        grid[(size_t)c.y * cells + c.x].push_back((uint32_t)i);
+    }
+    for (size_t i = 0; i < single.size(); i++)
+    {
+        glm::ivec2 c = cellOf(single[i].position);
+        for (int z = std::max(c.y - 1, 0); z <= std::min(c.y + 1, cells - 1); z++)
+        {
+            for (int x = std::max(c.x - 1, 0); x <= std::min(c.x + 1, cells - 1); x++)
+            {
+                for (uint32_t j : grid[(size_t)z * cells + x])
+                {
+                    if (j != i)
+                    {
+                        minDistance = std::min(minDistance, glm::length(single[i].position - single[j].position));
+                    }
+                }
+            }
+        }
+    }
+
+    printResult("1 thread", singleMs, single.size(), "objets");
+    printResult(std::to_string(threadCount) + " threads", parallelMs, parallel.size(), "objets");
+    std::cout << "  " << single.size() << " objets, distance minimale " << minDistance << " (" << settings.minDistance << " demandee), resultats " << (identical ? "identiques" : "DIFFERENTS") << std::endl;
+}
+
+// Carte de hauteur : requêtes de hauteur isolées (caméra, végétation) et bandes d'échantillons
+// envoyées au terrain quand sa fenêtre avance
+void benchmarkTerrain()
+{
+    const size_t count = 1000000;
+    HeightfieldSettings settings;
+    settings.seed = 7;
+    Heightfield heightfield(settings);
+    std::cout << "Terrain (" << count << " requetes, " << settings.octaves << " octaves)" << std::endl;
+
+    std::vector<glm::vec2> positions(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        positions[i] = glm::vec2(randomRange(-4000.0f, 4000.0f), randomRange(-4000.0f, 4000.0f));
+    }
+
+    float sum = 0.0f;
+    double queryMs = measureMs([&]()
+    {
+        for (const glm::vec2& position : positions)
+        {
+            sum = sum + heightfield.getHeight(position.x, position.y);
+        }
+    }, 3);
+
+    // Bande de 16 lignes d'une fenêtre de 1024 échantillons
+    std::vector<float> strip(16 * 1024);
+    double stripMs = measureMs([&]() { heightfield.getSamples(3000, -2000, 1024, 16, strip.data()); }, 10);
+
+    printResult("Hauteurs", queryMs, count, "requetes");
+    printResult("Bande 1024 x 16", stripMs, strip.size(), "echantillons");
+    std::cout << "  Hauteur moyenne " << sum / (3.0f * count) << " (" << heightfield.getMinHeight() << " a " << heightfield.getMaxHeight() << ")" << std::endl;
+}
+
+// Lots statiques : construction complète, puis reconstruction après un déplacement dans la même cellule,
+// un déplacement vers une autre cellule et un retrait (seuls les lots touchés doivent être refaits)
+void benchmarkStaticBatches()
+{
+    const size_t count = 2000;
+    const uint32_t materialCount = 8;
+    const float cellSize = 20.0f;
+    std::cout << "Lots statiques (" << count << " objets, " << materialCount << " materiaux, cellules de " << cellSize << " unites)" << std::endl;
+
+    // Un maillage de 300 sommets par matériau
+    std::vector<std::vector<Vertex>> meshes(materialCount);
+    std::vector<AABB> meshBounds(materialCount);
+    for (uint32_t m = 0; m < materialCount; m++)
+    {
+        for (int v = 0; v < 300; v++)
+        {
+            Vertex vertex;
+            vertex.position = glm::vec3(randomRange(-1.0f, 1.0f), randomRange(0.0f, 3.0f), randomRange(-1.0f, 1.0f));
+            vertex.normal = glm::normalize(vertex.position + glm::vec3(0.0f, 0.1f, 0.0f));
+            vertex.texCoords = glm::vec2(randomRange(0.0f, 1.0f), randomRange(0.0f, 1.0f));
+            meshes[m].push_back(vertex);
+            meshBounds[m].expand(vertex.position);
+        }
+    }
+
+    std::vector<glm::mat4> worlds(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        glm::vec3 position(randomRange(-150.0f, 150.0f), 0.0f, randomRange(-150.0f, 150.0f));
+        worlds[i] = glm::rotate(glm::translate(glm::mat4(1.0f), position), randomRange(0.0f, 6.28f), glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    StaticBatcher batcher;
+    size_t built = 0;
+    double buildMs = measureMs([&]()
+    {
+        batcher.init(glm::vec2(-160.0f), cellSize);
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t material = (uint32_t)(i % materialCount);
+            batcher.add((uint32_t)i, meshes[material], meshBounds[material], material, worlds[i], true);
+        }
+        built = batcher.rebuild();
+    }, 3);
+
+    // Un objet monté d'une unité (même cellule), décalé d'une cellule, puis retiré ; rien ensuite
+    uint32_t object = (uint32_t)(count / 2);
+    size_t rebuilt[4];
+    double rebuildMs[4];
+    glm::mat4 raised = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f)) * worlds[object];
+    glm::mat4 shifted = glm::translate(glm::mat4(1.0f), glm::vec3(cellSize, 0.0f, 0.0f)) * raised;
+    batcher.move(object, raised);
+    rebuildMs[0] = measureMs([&]() { rebuilt[0] = batcher.rebuild(); }, 1);
+    batcher.move(object, shifted);
+    rebuildMs[1] = measureMs([&]() { rebuilt[1] = batcher.rebuild(); }, 1);
+    batcher.remove(object);
+    rebuildMs[2] = measureMs([&]() { rebuilt[2] = batcher.rebuild(); }, 1);
+    rebuildMs[3] = measureMs([&]() { rebuilt[3] = batcher.rebuild(); }, 1);
+
+    const char* names[4] = { "Deplacement dans la cellule", "Changement de cellule", "Retrait", "Aucun changement" };
+    const size_t expected[4] = { 1, 2, 1, 0 };
+    printResult("Construction complete, " + std::to_string(built) + " lots", buildMs, count, "objets");
+    for (int k = 0; k < 4; k++)
+    {
+        std::cout << "  " << names[k] << " : " << rebuildMs[k] << " ms, " << rebuilt[k] << " lot(s) refait(s)" << (rebuilt[k] == expected[k] ? "" : " (attendu : " + std::to_string(expected[k]) + ")") << std::endl;
+    }
+    std::cout << "  " << batcher.getObjectCount() << " objets dans les lots" << std::endl;
+}
+
+// Particules : une image de plusieurs centaines d'émetteurs (émission, mouvement, retrait des mortes, écriture
+// des instances), en AoS scalaire (référence), en SoA SIMD sur 1 thread puis sur tous les threads
+void benchmarkParticles()
+{
+    const size_t emitterCount = 1024;
+    const float deltaTime = 1.0f / 60.0f;
+    ParticleLayerSettings settings;
+    settings.capacity = 256;
+    settings.rate = 400.0f;
+    settings.minLife = 0.4f;
+    settings.maxLife = 0.8f;
+    settings.velocitySpread = glm::vec3(0.3f);
+    settings.acceleration = glm::vec3(0.0f, 1.5f, 0.0f);
+    settings.drag = 0.5f;
+    settings.startSize = 0.6f;
+    settings.endSize = 0.15f;
+    settings.startColor = glm::vec4(1.0f, 0.45f, 0.1f, 0.0f);
+    settings.endColor = glm::vec4(0.3f, 0.05f, 0.0f, 0.0f);
+
+    // Référence : une particule par structure, mêmes calculs une particule à la fois
+    struct Particle
+    {
+        glm::vec3 position, velocity;
+        float age, invLife;
+    };
+    std::vector<std::vector<Particle>> reference(emitterCount);
+    std::vector<float> pending(emitterCount, 0.0f);
+    std::vector<ParticleInstance> referenceOut(emitterCount * settings.capacity);
+    auto referenceFrame = [&]()
+    {
+        for (size_t e = 0; e < emitterCount; e++)
+        {
+            std::vector<Particle>& list = reference[e];
+            pending[e] = pending[e] + settings.rate * deltaTime * randomRange(0.5f, 1.5f);
+            for (; pending[e] >= 1.0f; pending[e] = pending[e] - 1.0f)
+            {
+                if (list.size() < settings.capacity)
+                {
+                    glm::vec3 spread(randomRange(-1.0f, 1.0f), randomRange(-1.0f, 1.0f), randomRange(-1.0f, 1.0f));
+                    list.push_back({ glm::vec3((float)e, 0.0f, 0.0f), settings.velocity + spread * settings.velocitySpread, 0.0f, 1.0f / randomRange(settings.minLife, settings.maxLife) });
+                }
+            }
+
+            float damping = std::max(1.0f - settings.drag * deltaTime, 0.0f);
+            for (Particle& particle : list)
+            {
+                particle.velocity = (particle.velocity + settings.acceleration * deltaTime) * damping;
+                particle.position = particle.position + particle.velocity * deltaTime;
+                particle.age = particle.age + deltaTime;
+            }
+            for (size_t i = 0; i < list.size();)
+            {
+                if (list[i].age * list[i].invLife >= 1.0f)
+                {
+                    list[i] = list.back();
+                    list.pop_back();
+                }
+                else
+                {
+                    i++;
+                }
+            }
+
+            ParticleInstance* out = &referenceOut[e * settings.capacity];
+            for (size_t i = 0; i < list.size(); i++)
+            {
+                float t = std::min(list[i].age * list[i].invLife, 1.0f);
+                out[i].position = glm::vec4(list[i].position, glm::mix(settings.startSize, settings.endSize, t));
+                out[i].color = glm::mix(settings.startColor, settings.endColor, t);
+            }
+        }
+    };
+
+    std::vector<ParticleEmitter> emitters;
+    for (size_t e = 0; e < emitterCount; e++)
+    {
+        emitters.push_back(ParticleEmitter(glm::vec3((float)e, 0.0f, 0.0f), (uint32_t)(e + 1)));
+        emitters.back().addLayer(settings);
+    }
+    std::vector<ParticleInstance> out(emitterCount * settings.capacity);
+    auto emitterJob = [&](size_t e)
+    {
+        emitters[e].update(deltaTime);
+        emitters[e].writeInstances(&out[e * settings.capacity]);
+    };
+
+    int threadCount = (int)std::max(std::thread::hardware_concurrency(), 1u);
+    JobSystem single, parallel;
+    single.init(1);
+    parallel.init(threadCount);
+
+    // Régime établi : les émetteurs sont pleins avant les mesures
+    for (int frame = 0; frame < 120; frame++)
+    {
+        referenceFrame();
+        single.run(emitterCount, emitterJob);
+    }
+    size_t referenceCount = 0;
+    for (const std::vector<Particle>& list : reference)
+    {
+        referenceCount = referenceCount + list.size();
+    }
+    size_t particleCount = 0;
+    for (const ParticleEmitter& emitter : emitters)
+    {
+        particleCount = particleCount + emitter.getParticleCount();
+    }
+    std::cout << "Particules (" << emitterCount << " emetteurs, " << particleCount << " particules vivantes)" << std::endl;
+
+    double referenceMs = measureMs(referenceFrame, 20);
+    double singleMs = measureMs([&]() { single.run(emitterCount, emitterJob); }, 20);
+    double parallelMs = measureMs([&]() { parallel.run(emitterCount, emitterJob); }, 20);
+
+    printResult("AoS scalaire", referenceMs, referenceCount, "particules");
+    printResult("SoA SIMD, 1 thread", singleMs, particleCount, "particules");
+    printResult("SoA SIMD, " + std::to_string(threadCount) + " threads", parallelMs, particleCount, "particules");
+    std::cout << "  Particules par ms : " << (size_t)(referenceCount / referenceMs) << " (AoS), " << (size_t)(particleCount / singleMs) << " (SIMD), "
+              << (size_t)(particleCount / parallelMs) << " (SIMD, " << threadCount << " threads)" << std::endl;
+}
+
+// Nuée d'oiseaux : temps d'un pas pour des nuées de plus en plus grandes (densité constante : zone de vol
+// agrandie avec le nombre d'oiseaux), sur 1 thread et sur tous les threads, et plus grande nuée tenue dans
+// un budget de simulation fixe par image ; recherche des voisins sans grille (toutes les paires) en référence
+void benchmarkBirds()
+{
+    const double budgetMs = 2.0;
+    const float deltaTime = 1.0f / 60.0f;
+    int threadCount = (int)std::max(std::thread::hardware_concurrency(), 1u);
+    JobSystem single, parallel;
+    single.init(1);
+    parallel.init(threadCount);
+    std::cout << "Oiseaux (budget de " << budgetMs << " ms par image)" << std::endl;
+
+    size_t singleBest = 0, parallelBest = 0;
+    for (size_t count = 1000; count <= 32000; count = count * 2)
+    {
+        FlockSettings settings;
+        settings.count = count;
+        settings.radius = 120.0f * std::sqrt((float)count / 2000.0f);
+        Flock flock;
+        flock.init(settings);
+
+        // Nuées formées avant les mesures
+        for (int step = 0; step < 60; step++)
+        {
+            flock.update(deltaTime, parallel);
+        }
+
+        double singleMs = measureMs([&]() { flock.update(deltaTime, single); }, 5);
+        double parallelMs = measureMs([&]() { flock.update(deltaTime, parallel); }, 5);
+        printResult(std::to_string(count) + " oiseaux, 1 thread", singleMs, count, "oiseaux");
+        printResult(std::to_string(count) + " oiseaux, " + std::to_string(threadCount) + " threads", parallelMs, count, "oiseaux");
+        singleBest = singleMs <= budgetMs ? count : singleBest;
+        parallelBest = parallelMs <= budgetMs ? count : parallelBest;
+    }
+
+    // Référence : voisins de chaque oiseau parmi tous les autres
+    FlockSettings settings;
+    Flock flock;
+    flock.init(settings);
+    for (int step = 0; step < 60; step++)
+    {
+        flock.update(deltaTime, parallel);
+    }
+    size_t neighbors = 0;
+    float radius2 = settings.neighborRadius * settings.neighborRadius;
+    double bruteMs = measureMs([&]()
+    {
+        neighbors = 0;
+        for (size_t i = 0; i < flock.size(); i++)
+        {
+            glm::vec3 position = flock.getPosition(i);
+            for (size_t j = 0; j < flock.size(); j++)
+            {
+                glm::vec3 offset = flock.getPosition(j) - position;
+                neighbors = neighbors + (glm::dot(offset, offset) < radius2 ? 1 : 0);
+            }
+        }
+    }, 3);
+    printResult(std::to_string(flock.size()) + " oiseaux, voisins sans grille", bruteMs, flock.size(), "oiseaux");
+    std::cout << "  Oiseaux par image dans le budget : " << singleBest << " (1 thread), " << parallelBest << " (" << threadCount << " threads)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    struct Benchmark
+    {
+        std::string name;
+        void (*function)();
+    };
+
+    std::vector<Benchmark> benchmarks =
+    {
+        { "transforms", benchmarkTransforms },
+        { "spatial", benchmarkSpatialIndex },
+        { "forest", benchmarkForest },
+        { "terrain", benchmarkTerrain },
+        { "batches", benchmarkStaticBatches },
+        { "particles", benchmarkParticles },
+        { "birds", benchmarkBirds }
+    };
+
+    srand(1);
+    for (const auto& benchmark : benchmarks)
+    {
+        if (argc < 2 || benchmark.name == argv[1])
+        {
+            benchmark.function();
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
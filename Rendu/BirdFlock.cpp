@@ -0,0 +1,108 @@
+#include "BirdFlock.hpp"
+#include <cstddef>
+#include <chrono>
+
+
+BirdFlock::BirdFlock() : mJobs(nullptr), mTexture(nullptr), mModelScale(1.0f), mRadius(0.0f), mHalfSpan(1.0f), mUpdateMs(0.0), mVertexCount(0), mVAO(0), mMeshVBO(0), mInstanceVBO(0)
+{
+}
+
+BirdFlock::~BirdFlock()
+{
+    glDeleteVertexArrays(1, &mVAO);
+    glDeleteBuffers(1, &mMeshVBO);
+    glDeleteBuffers(1, &mInstanceVBO);
+}
+
+// Copie du maillage d'un oiseau dans un VAO propre (attributs d'instance 3 et 4), buffer pour toute la nuée
+void BirdFlock::init(const Mesh* mesh, Texture2D* texture, glm::vec3 modelScale, const FlockSettings& settings, JobSystem& jobs)
+{
+    mJobs = &jobs;
+    mTexture = texture;
+    mModelScale = modelScale;
+    mInstances.clear();
+    if(mesh == nullptr || mesh->getVertexCount() == 0 || texture == nullptr)
+    {
+        mVertexCount = 0;
+        return;
+    }
+
+    mFlock.init(settings);
+    const AABB& bounds = mesh->getBounds();
+    glm::vec3 extent = glm::max(glm::abs(bounds.min), glm::abs(bounds.max)) * modelScale;
+    mHalfSpan = glm::max(extent.z, 1e-3f);
+    mRadius = glm::length(extent) + 0.5f * mHalfSpan; // Ailes levées comprises
+    mVertexCount = mesh->getVertexCount();
+
+    if(mVAO == 0)
+    {
+        glGenVertexArrays(1, &mVAO);
+        glGenBuffers(1, &mMeshVBO);
+        glGenBuffers(1, &mInstanceVBO);
+    }
+    glBindVertexArray(mVAO);
+
+    const std::vector<Vertex>& vertices = mesh->getVertices();
+    glBindBuffer(GL_ARRAY_BUFFER, mMeshVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, texCoords));
+    glEnableVertexAttribArray(2);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, mFlock.size() * sizeof(BirdInstance), NULL, GL_STREAM_DRAW);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(BirdInstance), (GLvoid*)offsetof(BirdInstance, position));
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(BirdInstance), (GLvoid*)offsetof(BirdInstance, velocity));
+    glVertexAttribDivisor(4, 1);
+    glEnableVertexAttribArray(4);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Pas de simulation (temps CPU mesuré), puis oiseaux visibles dans le buffer orphelin : pas d'attente du GPU
+void BirdFlock::update(float deltaTime, const Frustum& frustum)
+{
+    if(mVertexCount == 0)
+    {
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    mFlock.update(glm::min(deltaTime, 0.05f), *mJobs); // Pas borné : une image lente ne disperse pas la nuée
+    mUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    mInstances.resize(mFlock.size());
+    mInstances.resize(mFlock.writeInstances(mInstances.data(), frustum, mRadius));
+
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, mFlock.size() * sizeof(BirdInstance), NULL, GL_STREAM_DRAW);
+    if(!mInstances.empty())
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, mInstances.size() * sizeof(BirdInstance), mInstances.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void BirdFlock::draw(ShaderProgram& shader, float time)
+{
+    if(mInstances.empty())
+    {
+        return;
+    }
+
+    shader.use();
+    mTexture->bind(0);
+    shader.setUniform("modelScale", mModelScale);
+    shader.setUniform("halfSpan", mHalfSpan);
+    shader.setUniform("time", time);
+
+    glBindVertexArray(mVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, mVertexCount, (GLsizei)mInstances.size());
+    glBindVertexArray(0);
+}
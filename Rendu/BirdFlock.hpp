@@ -0,0 +1,47 @@
+#ifndef BIRD_FLOCK_HPP
+#define BIRD_FLOCK_HPP
+
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Texture2D.hpp"
+#include "Mesh.hpp"
+#include "Bounds.hpp"
+#include "Flock.hpp"
+#include "JobSystem.hpp"
+
+#define GLEW_STATIC
+
+// Oiseaux de la scène : la nuée (Flock) est simulée sur les threads du JobSystem à chaque image, les oiseaux
+// dans la pyramide de vue sont envoyés dans un buffer d'instances (orphelin puis glBufferSubData) et
+// dessinés en un seul appel instancié ; bird.vert oriente chaque oiseau selon sa vitesse et bat des ailes.
+class BirdFlock
+{
+public:
+    BirdFlock();
+    ~BirdFlock();
+
+    void init(const Mesh* mesh, Texture2D* texture, glm::vec3 modelScale, const FlockSettings& settings, JobSystem& jobs); // Oiseaux, VAO et buffer d'instances
+    void update(float deltaTime, const Frustum& frustum); // Un pas de simulation, puis envoi des oiseaux visibles
+    void draw(ShaderProgram& shader, float time); // Dessiner les oiseaux visibles (view, projection et éclairage fixés par l'appelant)
+
+    size_t getCount() const { return mFlock.size(); } // Oiseaux simulés
+    size_t getDrawnCount() const { return mInstances.size(); } // Oiseaux dessinés dans l'image
+    double getUpdateMs() const { return mUpdateMs; } // Temps CPU du dernier pas de simulation
+
+private:
+    Flock mFlock;
+    JobSystem* mJobs;
+    Texture2D* mTexture;
+    glm::vec3 mModelScale;
+    float mRadius; // Rayon de la sphère englobante d'un oiseau (élimination)
+    float mHalfSpan; // Demi-envergure (battement d'ailes)
+    double mUpdateMs;
+    std::vector<BirdInstance> mInstances; // Oiseaux visibles de l'image
+    GLsizei mVertexCount;
+    GLuint mVAO, mMeshVBO, mInstanceVBO;
+};
+
+#endif // BIRD_FLOCK_HPP
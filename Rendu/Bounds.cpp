@@ -0,0 +1,173 @@
+#include "Bounds.hpp"
+#include "Simd.hpp"
+
+
+// Agrandir la boîte pour contenir un point
+void AABB::expand(const glm::vec3& point)
+{
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+}
+
+// Boîte englobante d'une boîte transformée (méthode d'Arvo : centre + demi-taille)
+AABB transformAABB(const AABB& box, const glm::mat4& matrix)
+{
+    if(box.isEmpty())
+    {
+        return box;
+    }
+
+    glm::vec3 center = glm::vec3(matrix * glm::vec4(box.getCenter(), 1.0f));
+    glm::vec3 extents = box.getExtents();
+    glm::vec3 newExtents;
+
+    for(int i = 0; i < 3; i = i + 1)
+    {
+        newExtents[i] = glm::abs(matrix[0][i]) * extents.x + glm::abs(matrix[1][i]) * extents.y + glm::abs(matrix[2][i]) * extents.z;
+    }
+
+    AABB result;
+    result.min = center - newExtents;
+    result.max = center + newExtents;
+    return result;
+}
+
+
+// Plans de la pyramide d'une matrice vue-projection (méthode de Gribb et Hartmann) :
+// chaque plan est une somme ou une différence de la 4e ligne et d'une autre ligne
+Frustum extractFrustum(const glm::mat4& viewProjection)
+{
+    glm::vec4 rows[4];
+    for(int r = 0; r < 4; r = r + 1)
+    {
+        rows[r] = glm::vec4(viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]);
+    }
+
+    Frustum frustum;
+    for(int p = 0; p < 6; p = p + 1)
+    {
+        glm::vec4 plane = (p % 2 == 0) ? rows[3] + rows[p / 2] : rows[3] - rows[p / 2];
+        frustum.planes[p] = plane / glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+// AABBArray-----------------------------------------------------
+
+// Vider le tableau
+void AABBArray::clear()
+{
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+    mCount = 0;
+}
+
+// Ajouter une boîte
+void AABBArray::push(const AABB& box)
+{
+    // Nouveau groupe de 4 : on le remplit de boîtes vides qui ne passent aucun test
+    if(mCount % 4 == 0)
+    {
+        minX.resize(mCount + 4, FLT_MAX); minY.resize(mCount + 4, FLT_MAX); minZ.resize(mCount + 4, FLT_MAX);
+        maxX.resize(mCount + 4, -FLT_MAX); maxY.resize(mCount + 4, -FLT_MAX); maxZ.resize(mCount + 4, -FLT_MAX);
+    }
+
+    mCount = mCount + 1;
+    set(mCount - 1, box);
+}
+
+// Retirer la dernière boîte (remplacée par une boîte vide, le groupe de 4 vide est libéré)
+void AABBArray::pop()
+{
+    if(mCount == 0)
+    {
+        return;
+    }
+
+    mCount = mCount - 1;
+    set(mCount, AABB());
+    if(mCount % 4 == 0)
+    {
+        minX.resize(mCount); minY.resize(mCount); minZ.resize(mCount);
+        maxX.resize(mCount); maxY.resize(mCount); maxZ.resize(mCount);
+    }
+}
+
+// Modifier une boîte
+void AABBArray::set(size_t index, const AABB& box)
+{
+    minX[index] = box.min.x; minY[index] = box.min.y; minZ[index] = box.min.z;
+    maxX[index] = box.max.x; maxY[index] = box.max.y; maxZ[index] = box.max.z;
+}
+
+// Lire une boîte
+AABB AABBArray::get(size_t index) const
+{
+    AABB box;
+    box.min = glm::vec3(minX[index], minY[index], minZ[index]);
+    box.max = glm::vec3(maxX[index], maxY[index], maxZ[index]);
+    return box;
+}
+
+
+// Test sphère / boîtes, 4 boîtes à la fois.
+// Distance au carré entre le centre et la boîte : somme des max(min - c, 0, c - max)²
+void sphereAABBMask(const AABBArray& boxes, const glm::vec3& center, float radius, uint32_t bit, uint32_t* masks)
+{
+    float4 cx(center.x), cy(center.y), cz(center.z);
+    float4 r2(radius * radius);
+    float4 zero = float4::zero();
+
+    for(size_t i = 0; i < boxes.paddedSize(); i = i + 4)
+    {
+        float4 dx = max4(max4(float4::load(&boxes.minX[i]) - cx, cx - float4::load(&boxes.maxX[i])), zero);
+        float4 dy = max4(max4(float4::load(&boxes.minY[i]) - cy, cy - float4::load(&boxes.maxY[i])), zero);
+        float4 dz = max4(max4(float4::load(&boxes.minZ[i]) - cz, cz - float4::load(&boxes.maxZ[i])), zero);
+        int hits = movemask(cmple(dx * dx + dy * dy + dz * dz, r2));
+
+        if(hits == 0)
+        {
+            continue;
+        }
+
+        for(int k = 0; k < 4; k = k + 1)
+        {
+            if((hits & (1 << k)) && i + k < boxes.size())
+            {
+                masks[i + k] |= bit;
+            }
+        }
+    }
+}
+
+// Test pyramide de vue / boîtes, 4 boîtes à la fois. Pour chaque plan, seul le coin le plus avancé
+// dans la direction de la normale est testé : s'il est derrière un plan, toute la boîte l'est.
+// Le signe de la normale est le même pour les 4 boîtes, le coin est donc choisi une fois par plan.
+size_t frustumCullAABB(const AABBArray& boxes, const Frustum& frustum, uint8_t* visible)
+{
+    size_t visibleCount = 0;
+    float4 zero = float4::zero();
+
+    for(size_t i = 0; i < boxes.paddedSize(); i = i + 4)
+    {
+        int inside = 0xF;
+        for(int p = 0; p < 6 && inside != 0; p = p + 1)
+        {
+            const glm::vec4& plane = frustum.planes[p];
+            float4 x = float4::load(plane.x >= 0.0f ? &boxes.maxX[i] : &boxes.minX[i]);
+            float4 y = float4::load(plane.y >= 0.0f ? &boxes.maxY[i] : &boxes.minY[i]);
+            float4 z = float4::load(plane.z >= 0.0f ? &boxes.maxZ[i] : &boxes.minZ[i]);
+            float4 d = float4(plane.x) * x + float4(plane.y) * y + float4(plane.z) * z + float4(plane.w);
+            inside = inside & movemask(cmpge(d, zero));
+        }
+
+        size_t count = glm::min(boxes.size() - i, (size_t)4);
+        for(size_t k = 0; k < count; k = k + 1)
+        {
+            visible[i + k] = (uint8_t)((inside >> k) & 1);
+            visibleCount = visibleCount + visible[i + k];
+        }
+    }
+
+    return visibleCount;
+}
@@ -0,0 +1,60 @@
+#ifndef BOUNDS_HPP
+#define BOUNDS_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cfloat>
+#include <glm/glm.hpp>
+
+// Boîte englobante alignée sur les axes
+struct AABB
+{
+    glm::vec3 min = glm::vec3(FLT_MAX); // Coin minimum
+    glm::vec3 max = glm::vec3(-FLT_MAX); // Coin maximum
+
+    void expand(const glm::vec3& point); // Agrandir la boîte pour contenir un point
+    bool isEmpty() const { return min.x > max.x; } // Boîte vide
+    glm::vec3 getCenter() const { return (min + max) * 0.5f; } // Centre
+    glm::vec3 getExtents() const { return (max - min) * 0.5f; } // Demi-taille
+};
+
+AABB transformAABB(const AABB& box, const glm::mat4& matrix); // Boîte englobante d'une boîte transformée
+
+// Pyramide de vue : 6 plans normalisés (xyz : normale vers l'intérieur, w : distance)
+struct Frustum
+{
+    glm::vec4 planes[6]; // Gauche, droite, bas, haut, proche, lointain
+};
+
+Frustum extractFrustum(const glm::mat4& viewProjection); // Plans de la pyramide d'une matrice vue-projection
+
+
+// Tableau de boîtes stockées en SoA (une colonne par composante) pour les tests SIMD.
+// La taille est toujours complétée à un multiple de 4 avec des boîtes vides.
+class AABBArray
+{
+public:
+    void clear(); // Vider le tableau
+    void push(const AABB& box); // Ajouter une boîte
+    void pop(); // Retirer la dernière boîte
+    void set(size_t index, const AABB& box); // Modifier une boîte
+    AABB get(size_t index) const; // Lire une boîte
+
+    size_t size() const { return mCount; } // Nombre de boîtes
+    size_t paddedSize() const { return minX.size(); } // Nombre de boîtes avec le remplissage
+
+    std::vector<float> minX, minY, minZ; // Coins minimum
+    std::vector<float> maxX, maxY, maxZ; // Coins maximum
+
+private:
+    size_t mCount = 0; // Nombre de boîtes réelles
+};
+
+// Test sphère / boîtes : ajoute le bit 'bit' au masque de chaque boîte touchée par la sphère
+void sphereAABBMask(const AABBArray& boxes, const glm::vec3& center, float radius, uint32_t bit, uint32_t* masks);
+
+// Test pyramide de vue / boîtes : visible[i] = 1 si la boîte i est au moins en partie dans la pyramide.
+// Renvoie le nombre de boîtes visibles.
+size_t frustumCullAABB(const AABBArray& boxes, const Frustum& frustum, uint8_t* visible);
+
+#endif // BOUNDS_HPP
@@ -0,0 +1,294 @@
+#include "Bvh.hpp"
+#include "Bounds.hpp"
+#include "Simd.hpp"
+
+
+// Construire la hiérarchie à partir de triangles (3 sommets consécutifs par triangle)
+void Bvh::build(const std::vector<glm::vec3>& triangleVertices)
+{
+    uint32_t triangleCount = (uint32_t)(triangleVertices.size() / 3);
+
+    mTriangles.resize(triangleCount);
+    mIndices.resize(triangleCount);
+    std::vector<glm::vec3> centroids(triangleCount);
+
+    for(uint32_t i = 0; i < triangleCount; i = i + 1)
+    {
+        const glm::vec3& a = triangleVertices[i * 3];
+        const glm::vec3& b = triangleVertices[i * 3 + 1];
+        const glm::vec3& c = triangleVertices[i * 3 + 2];
+
+        mTriangles[i].v0 = a;
+        mTriangles[i].e1 = b - a;
+        mTriangles[i].e2 = c - a;
+        centroids[i] = (a + b + c) / 3.0f;
+        mIndices[i] = i;
+    }
+
+    // Au plus 2n - 1 noeuds : la réservation évite toute réallocation pendant la construction
+    mNodes.clear();
+    mNodes.reserve(triangleCount * 2 + 1);
+
+    Node root;
+    root.leftFirst = 0;
+    root.count = triangleCount;
+    mNodes.push_back(root);
+
+    if(triangleCount == 0)
+    {
+        return;
+    }
+
+    updateBounds(0);
+    subdivide(0, centroids);
+
+    // Réordonner les triangles dans l'ordre des feuilles pour des accès contigus
+    std::vector<Triangle> ordered(triangleCount);
+    for(uint32_t i = 0; i < triangleCount; i = i + 1)
+    {
+        ordered[i] = mTriangles[mIndices[i]];
+    }
+    mTriangles.swap(ordered);
+    mIndices.clear();
+}
+
+// Boîte englobante des triangles d'un noeud
+void Bvh::updateBounds(uint32_t nodeIndex)
+{
+    Node& node = mNodes[nodeIndex];
+    AABB box;
+
+    for(uint32_t i = 0; i < node.count; i = i + 1)
+    {
+        const Triangle& tri = mTriangles[mIndices[node.leftFirst + i]];
+        box.expand(tri.v0);
+        box.expand(tri.v0 + tri.e1);
+        box.expand(tri.v0 + tri.e2);
+    }
+
+    node.min = box.min;
+    node.max = box.max;
+}
+
+// Aire de surface d'une boîte (heuristique SAH)
+static float surfaceArea(const AABB& box)
+{
+    if(box.isEmpty())
+    {
+        return 0.0f;
+    }
+
+    glm::vec3 size = box.max - box.min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+// Découper un noeud récursivement, plan de coupe choisi par SAH sur des intervalles
+void Bvh::subdivide(uint32_t nodeIndex, std::vector<glm::vec3>& centroids)
+{
+    uint32_t first = mNodes[nodeIndex].leftFirst;
+    uint32_t count = mNodes[nodeIndex].count;
+
+    if(count <= MAX_LEAF_TRIANGLES)
+    {
+        return;
+    }
+
+    // Boîte des centres des triangles
+    AABB centroidBox;
+    for(uint32_t i = 0; i < count; i = i + 1)
+    {
+        centroidBox.expand(centroids[mIndices[first + i]]);
+    }
+
+    int bestAxis = -1;
+    int bestSplit = 0;
+    float bestCost = FLT_MAX;
+
+    for(int axis = 0; axis < 3; axis = axis + 1)
+    {
+        float extent = centroidBox.max[axis] - centroidBox.min[axis];
+        if(extent <= 0.0f)
+        {
+            continue;
+        }
+
+        AABB binBox[BIN_COUNT];
+        uint32_t binCount[BIN_COUNT] = { 0 };
+        float scale = (float)BIN_COUNT / extent;
+
+        for(uint32_t i = 0; i < count; i = i + 1)
+        {
+            uint32_t index = mIndices[first + i];
+            int bin = glm::min(BIN_COUNT - 1, (int)((centroids[index][axis] - centroidBox.min[axis]) * scale));
+            const Triangle& tri = mTriangles[index];
+            binBox[bin].expand(tri.v0);
+            binBox[bin].expand(tri.v0 + tri.e1);
+            binBox[bin].expand(tri.v0 + tri.e2);
+            binCount[bin] = binCount[bin] + 1;
+        }
+
+        // Balayage : aires et nombres cumulés à gauche et à droite de chaque plan
+        float leftArea[BIN_COUNT - 1], rightArea[BIN_COUNT - 1];
+        uint32_t leftCount[BIN_COUNT - 1], rightCount[BIN_COUNT - 1];
+        AABB leftBox, rightBox;
+        uint32_t leftSum = 0, rightSum = 0;
+
+        for(int i = 0; i < BIN_COUNT - 1; i = i + 1)
+        {
+            leftSum = leftSum + binCount[i];
+            leftCount[i] = leftSum;
+            if(!binBox[i].isEmpty()) { leftBox.expand(binBox[i].min); leftBox.expand(binBox[i].max); }
+            leftArea[i] = surfaceArea(leftBox);
+
+            int j = BIN_COUNT - 1 - i;
+            rightSum = rightSum + binCount[j];
+            rightCount[j - 1] = rightSum;
+            if(!binBox[j].isEmpty()) { rightBox.expand(binBox[j].min); rightBox.expand(binBox[j].max); }
+            rightArea[j - 1] = surfaceArea(rightBox);
+        }
+
+        for(int i = 0; i < BIN_COUNT - 1; i = i + 1)
+        {
+            float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+            if(cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i + 1;
+            }
+        }
+    }
+
+    // Découper ne coûte pas moins cher que garder une feuille
+    AABB nodeBox;
+    nodeBox.min = mNodes[nodeIndex].min;
+    nodeBox.max = mNodes[nodeIndex].max;
+    if(bestAxis < 0 || bestCost >= count * surfaceArea(nodeBox))
+    {
+        return;
+    }
+
+    // Partition des triangles autour du plan choisi
+    float scale = (float)BIN_COUNT / (centroidBox.max[bestAxis] - centroidBox.min[bestAxis]);
+    uint32_t i = first;
+    uint32_t j = first + count;
+    while(i < j)
+    {
+        int bin = glm::min(BIN_COUNT - 1, (int)((centroids[mIndices[i]][bestAxis] - centroidBox.min[bestAxis]) * scale));
+        if(bin < bestSplit)
+        {
+            i = i + 1;
+        }
+        else
+        {
+            j = j - 1;
+            uint32_t tmp = mIndices[i];
+            mIndices[i] = mIndices[j];
+            mIndices[j] = tmp;
+        }
+    }
+
+    uint32_t leftCountFinal = i - first;
+    if(leftCountFinal == 0 || leftCountFinal == count)
+    {
+        return;
+    }
+
+    // Création des deux enfants (consécutifs)
+    uint32_t leftIndex = (uint32_t)mNodes.size();
+    Node left, right;
+    left.leftFirst = first;
+    left.count = leftCountFinal;
+    right.leftFirst = i;
+    right.count = count - leftCountFinal;
+    mNodes.push_back(left);
+    mNodes.push_back(right);
+
+    mNodes[nodeIndex].leftFirst = leftIndex;
+    mNodes[nodeIndex].count = 0;
+
+    updateBounds(leftIndex);
+    updateBounds(leftIndex + 1);
+    subdivide(leftIndex, centroids);
+    subdivide(leftIndex + 1, centroids);
+}
+
+// Masque des rayons actifs du paquet qui touchent au moins un triangle.
+// Le parcours s'arrête dès que tous les rayons actifs sont occultés.
+int Bvh::occluded(const RayPacket& packet, int activeMask) const
+{
+    if(mNodes.empty() || mTriangles.empty())
+    {
+        return 0;
+    }
+
+    float4 ox = float4::load(packet.ox), oy = float4::load(packet.oy), oz = float4::load(packet.oz);
+    float4 dx = float4::load(packet.dx), dy = float4::load(packet.dy), dz = float4::load(packet.dz);
+    float4 tMax = float4::load(packet.tMax);
+    float4 one(1.0f), zero = float4::zero();
+    float4 invDx = one / dx, invDy = one / dy, invDz = one / dz;
+    float4 detEpsilon(1e-8f), tEpsilon(1e-4f);
+
+    int hitMask = 0;
+    uint32_t stack[128];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while(stackSize > 0)
+    {
+        const Node& node = mNodes[stack[--stackSize]];
+
+        // Test des plans (slabs) de la boîte pour les 4 rayons
+        float4 t1 = (float4(node.min.x) - ox) * invDx, t2 = (float4(node.max.x) - ox) * invDx;
+        float4 tNear = min4(t1, t2), tFar = max4(t1, t2);
+        t1 = (float4(node.min.y) - oy) * invDy; t2 = (float4(node.max.y) - oy) * invDy;
+        tNear = max4(tNear, min4(t1, t2)); tFar = min4(tFar, max4(t1, t2));
+        t1 = (float4(node.min.z) - oz) * invDz; t2 = (float4(node.max.z) - oz) * invDz;
+        tNear = max4(tNear, min4(t1, t2)); tFar = min4(tFar, max4(t1, t2));
+
+        int lanes = movemask(cmple(tNear, tFar) & cmpge(tFar, zero) & cmple(tNear, tMax)) & activeMask & ~hitMask;
+        if(lanes == 0)
+        {
+            continue;
+        }
+
+        if(node.count == 0)
+        {
+            if(stackSize + 2 <= 128)
+            {
+                stack[stackSize++] = node.leftFirst + 1;
+                stack[stackSize++] = node.leftFirst;
+            }
+            continue;
+        }
+
+        // Feuille : intersection rayons / triangles (Möller-Trumbore)
+        for(uint32_t i = 0; i < node.count; i = i + 1)
+        {
+            const Triangle& tri = mTriangles[node.leftFirst + i];
+            float4 e1x(tri.e1.x), e1y(tri.e1.y), e1z(tri.e1.z);
+            float4 e2x(tri.e2.x), e2y(tri.e2.y), e2z(tri.e2.z);
+
+            float4 px = dy * e2z - dz * e2y, py = dz * e2x - dx * e2z, pz = dx * e2y - dy * e2x;
+            float4 det = e1x * px + e1y * py + e1z * pz;
+            float4 invDet = one / det;
+
+            float4 tx = ox - float4(tri.v0.x), ty = oy - float4(tri.v0.y), tz = oz - float4(tri.v0.z);
+            float4 u = (tx * px + ty * py + tz * pz) * invDet;
+            float4 qx = ty * e1z - tz * e1y, qy = tz * e1x - tx * e1z, qz = tx * e1y - ty * e1x;
+            float4 v = (dx * qx + dy * qy + dz * qz) * invDet;
+            float4 t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+            float4 hit = cmpgt(abs4(det), detEpsilon) & cmpge(u, zero) & cmpge(v, zero) & cmple(u + v, one)
+                       & cmpgt(t, tEpsilon) & cmplt(t, tMax);
+            hitMask |= movemask(hit) & lanes;
+        }
+
+        if((hitMask & activeMask) == activeMask)
+        {
+            break;
+        }
+    }
+
+    return hitMask & activeMask;
+}
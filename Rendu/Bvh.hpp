@@ -0,0 +1,52 @@
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Paquet de 4 rayons en SoA, testés ensemble avec SIMD
+struct RayPacket
+{
+    float ox[4], oy[4], oz[4]; // Origines
+    float dx[4], dy[4], dz[4]; // Directions
+    float tMax[4]; // Distance maximale de chaque rayon
+};
+
+// Hiérarchie de volumes englobants (BVH) sur des triangles en espace monde,
+// utilisée pour les requêtes d'occultation du précalcul d'éclairage.
+class Bvh
+{
+public:
+    void build(const std::vector<glm::vec3>& triangleVertices); // Construire à partir de triangles (3 sommets consécutifs)
+    int occluded(const RayPacket& packet, int activeMask) const; // Masque des rayons actifs qui touchent un triangle
+
+    size_t getTriangleCount() const { return mTriangles.size(); }
+    size_t getNodeCount() const { return mNodes.size(); }
+
+private:
+    struct Node
+    {
+        glm::vec3 min; // Boîte englobante
+        uint32_t leftFirst; // Premier enfant (noeud interne) ou premier triangle (feuille)
+        glm::vec3 max;
+        uint32_t count; // Nombre de triangles (0 : noeud interne)
+    };
+
+    struct Triangle
+    {
+        glm::vec3 v0, e1, e2; // Sommet et arêtes (Möller-Trumbore)
+    };
+
+    void subdivide(uint32_t nodeIndex, std::vector<glm::vec3>& centroids); // Découper un noeud récursivement
+    void updateBounds(uint32_t nodeIndex); // Boîte englobante des triangles d'un noeud
+
+    std::vector<Node> mNodes; // Noeuds, la racine est le noeud 0
+    std::vector<Triangle> mTriangles; // Triangles réordonnés par feuille
+    std::vector<uint32_t> mIndices; // Ordre des triangles pendant la construction
+
+    static const uint32_t MAX_LEAF_TRIANGLES = 4; // Taille maximale d'une feuille
+    static const int BIN_COUNT = 8; // Nombre d'intervalles pour l'heuristique SAH
+};
+
+#endif // BVH_HPP
@@ -20,6 +20,11 @@ glm::mat4 Camera::getViewMatrix() const
     return glm::lookAt(mPosition, mTargetPos, mUp);
 }
 
+Frustum Camera::getFrustum(const glm::mat4& projection) const
+{
+    return extractFrustum(projection * getViewMatrix());
+}
+
 const glm::vec3& Camera::getLook() const
 {
     return mLook;
@@ -4,11 +4,14 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 
+#include "Bounds.hpp"
+
 class Camera 
 {
 public :
 
     glm::mat4 getViewMatrix() const; // Retourne la matrice de vue
+    Frustum getFrustum(const glm::mat4& projection) const; // Retourne les plans de la pyramide de vue
 
     virtual void setPosition(const glm::vec3& position) {} // Definir la position de la camera
     virtual void rotate(float yaw, float pitch) {} // Rotation de la camera en degres
@@ -5,6 +5,13 @@
 int Display::gWindowWidth = 1920;
 int Display::gWindowHeight = 1080;
 bool Display::gFlashlightOn = false;
+bool Display::gDeferredShading = false;
+bool Display::gBakedLighting = true;
+bool Display::gOcclusionCulling = true;
+bool Display::gOcclusionQueries = true;
+bool Display::gGpuDriven = false;
+bool Display::gStaticBatching = true;
+bool Display::gGrass = true;
 bool Display::gFullScreen = true;
 bool Display::VSync = true;
 
@@ -112,7 +119,11 @@ void Display::showFPS(GLFWwindow* gWindow)
         outs.precision(3); // 3 chiffres après la virgule
         outs << std::fixed
              << APP_TITLE << "   "
-             << "FPS: " << fps; 
+             << "FPS: " << fps;
+        if(!mStats.empty())
+        {
+            outs << "   " << mStats;
+        }
         glfwSetWindowTitle(gWindow, outs.str().c_str());
 
         frameCount = 0;
@@ -181,11 +192,16 @@ void Display::update(double elapsedTime)
         fpsCamera.move(currentMoveSpeed * (float)elapsedTime * -fpsCamera.getUp());
     }
 
-    // Vérification de la hauteur pour empêcher de traverser le sol
-    if(fpsCamera.getPosition().y < GROUND_HEIGHT)
+    // Vérification de la hauteur pour empêcher de traverser le sol (hauteur du relief sous la caméra)
+    glm::vec3 pos = fpsCamera.getPosition();
+    float groundHeight = GROUND_HEIGHT;
+    if(mGround != nullptr)
+    {
+        groundHeight = groundHeight + mGround->getHeight(pos.x, pos.z);
+    }
+    if(pos.y < groundHeight)
     {
-        glm::vec3 pos = fpsCamera.getPosition();
-        pos.y = GROUND_HEIGHT;  // Contraindre la hauteur au-dessus du sol
+        pos.y = groundHeight;  // Contraindre la hauteur au-dessus du sol
         fpsCamera.setPosition(pos);
     }
 }
@@ -230,6 +246,48 @@ void Display::glfw_onKey(GLFWwindow* gWindow, int key, int scancode, int action,
         }
     }
 
+    // Touche F3 : basculer entre rendu direct et rendu différé
+    if(key == GLFW_KEY_F3 && action == GLFW_PRESS)
+    {
+        gDeferredShading = !gDeferredShading;
+    }
+
+    // Touche F4 : activer/désactiver l'éclairage précalculé
+    if(key == GLFW_KEY_F4 && action == GLFW_PRESS)
+    {
+        gBakedLighting = !gBakedLighting;
+    }
+
+    // Touche F5 : activer/désactiver l'élimination des objets cachés
+    if(key == GLFW_KEY_F5 && action == GLFW_PRESS)
+    {
+        gOcclusionCulling = !gOcclusionCulling;
+    }
+
+    // Touche F6 : activer/désactiver les requêtes d'occlusion GPU
+    if(key == GLFW_KEY_F6 && action == GLFW_PRESS)
+    {
+        gOcclusionQueries = !gOcclusionQueries;
+    }
+
+    // Touche F7 : basculer entre la file de rendu et la scène éliminée et dessinée par le GPU
+    if(key == GLFW_KEY_F7 && action == GLFW_PRESS)
+    {
+        gGpuDriven = !gGpuDriven;
+    }
+
+    // Touche F8 : activer/désactiver les lots statiques du village
+    if(key == GLFW_KEY_F8 && action == GLFW_PRESS)
+    {
+        gStaticBatching = !gStaticBatching;
+    }
+
+    // Touche F9 : activer/désactiver l'herbe
+    if(key == GLFW_KEY_F9 && action == GLFW_PRESS)
+    {
+        gGrass = !gGrass;
+    }
+
     // Touche F : activer/désactiver la lampe torche
     if (key == GLFW_KEY_F && action == GLFW_PRESS)
 	{
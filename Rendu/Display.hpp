@@ -3,11 +3,13 @@
 
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 
 #include "Camera.hpp"
+#include "Heightfield.hpp"
 
 #define GLEW_STATIC
 
@@ -18,6 +20,8 @@ public:
 
     bool initOpenGL();
     void showFPS(GLFWwindow* gWindow);
+    void setStats(const std::string& stats) { mStats = stats; } // Statistiques de rendu affichées dans le titre
+    void setGround(const Heightfield* ground) { mGround = ground; } // Relief sous la caméra (nullptr : sol plat en 0)
     void update(double elapsedTime);
     void static glfw_onFramebufferSize(GLFWwindow* gWindow, int width, int height);
     void static glfw_onKey(GLFWwindow* gWindow, int key, int scancode, int action, int mode);
@@ -28,6 +32,13 @@ public:
     static int gWindowHeight;
 
     static bool gFlashlightOn;
+    static bool gDeferredShading; // Rendu différé (true) ou direct (false)
+    static bool gBakedLighting; // Éclairage statique précalculé (rendu direct)
+    static bool gOcclusionCulling; // Élimination des objets cachés par les occultants
+    static bool gOcclusionQueries; // Requêtes d'occlusion GPU et rendu conditionnel
+    static bool gGpuDriven; // Élimination et dessin indirect par le GPU (rendu direct, OpenGL 4.3)
+    static bool gStaticBatching; // Objets statiques du village dessinés par lots pré-transformés
+    static bool gGrass; // Herbe instanciée autour de la caméra
 
 private:
     const char* APP_TITLE = "Rendu OpenGL - Clément Furnon";
@@ -37,6 +48,9 @@ private:
     static bool VSync; 
     glm::vec4 gClearColor = glm::vec4(0.392f, 0.667f, 0.922f, 1.0f);
 
+    std::string mStats; // Statistiques de rendu
+    const Heightfield* mGround = nullptr; // Relief du terrain
+
     FPSCamera &fpsCamera;
     glm::vec3 moveDirection;
 
@@ -45,7 +59,7 @@ private:
     float currentMoveSpeed = NORMAL_MOVE_SPEED; // Vitesse de déplacement actuelle
 
     const float MOUSE_SENSITIVITY = 0.1f;
-    const float GROUND_HEIGHT = 1.5f; 
+    const float GROUND_HEIGHT = 1.5f; // Hauteur des yeux au-dessus du sol
 };
 
 #endif // CAMERA_HPP
\ No newline at end of file
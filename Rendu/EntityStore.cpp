@@ -0,0 +1,174 @@
+#include "EntityStore.hpp"
+#include <algorithm>
+
+
+// Vider le stockage
+void EntityStore::clear()
+{
+    mModels.clear();
+    mPosX.clear(); mPosY.clear(); mPosZ.clear();
+    mYaw.clear();
+    mScaleX.clear(); mScaleY.clear(); mScaleZ.clear();
+    mBounds.clear();
+    mFlags.clear();
+    mIds.clear();
+    mIndices.clear();
+    mFreeIds.clear();
+}
+
+// Ajouter une entité à la fin des colonnes (boîte vide tant que setBounds n'est pas appelé)
+EntityId EntityStore::add(uint32_t model, glm::vec3 position, float yaw, glm::vec3 scale, uint8_t flags)
+{
+    EntityId id;
+    if(!mFreeIds.empty())
+    {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+    }
+    else
+    {
+        id = (EntityId)mIndices.size();
+        mIndices.push_back(INVALID_ENTITY);
+    }
+
+    mIndices[id] = (uint32_t)mIds.size();
+    mIds.push_back(id);
+    mModels.push_back(model);
+    mPosX.push_back(position.x); mPosY.push_back(position.y); mPosZ.push_back(position.z);
+    mYaw.push_back(yaw);
+    mScaleX.push_back(scale.x); mScaleY.push_back(scale.y); mScaleZ.push_back(scale.z);
+    mBounds.push(AABB());
+    mFlags.push_back(flags);
+    return id;
+}
+
+// Ajouter des colonnes entières (chargement d'une scène) : copies en bloc, seules l'échelle
+// et les identifiants sont calculés par entité
+void EntityStore::addBatch(size_t count, const uint32_t* models, const float* posX, const float* posY, const float* posZ, const float* yaw, const uint8_t* flags, const std::vector<glm::vec3>& modelScales)
+{
+    size_t first = size();
+    mModels.insert(mModels.end(), models, models + count);
+    mPosX.insert(mPosX.end(), posX, posX + count);
+    mPosY.insert(mPosY.end(), posY, posY + count);
+    mPosZ.insert(mPosZ.end(), posZ, posZ + count);
+    mYaw.insert(mYaw.end(), yaw, yaw + count);
+    mFlags.insert(mFlags.end(), flags, flags + count);
+
+    mScaleX.resize(first + count); mScaleY.resize(first + count); mScaleZ.resize(first + count);
+    mIds.resize(first + count);
+    for(size_t i = first; i < first + count; i = i + 1)
+    {
+        glm::vec3 scale = (mModels[i] < modelScales.size()) ? modelScales[mModels[i]] : glm::vec3(1.0f);
+        mScaleX[i] = scale.x; mScaleY[i] = scale.y; mScaleZ[i] = scale.z;
+        mBounds.push(AABB());
+
+        mIds[i] = (EntityId)mIndices.size();
+        mIndices.push_back((uint32_t)i);
+    }
+}
+
+// Copier toutes les colonnes d'un index vers un autre
+void EntityStore::moveEntity(uint32_t from, uint32_t to)
+{
+    mModels[to] = mModels[from];
+    mPosX[to] = mPosX[from]; mPosY[to] = mPosY[from]; mPosZ[to] = mPosZ[from];
+    mYaw[to] = mYaw[from];
+    mScaleX[to] = mScaleX[from]; mScaleY[to] = mScaleY[from]; mScaleZ[to] = mScaleZ[from];
+    mBounds.set(to, mBounds.get(from));
+    mFlags[to] = mFlags[from];
+    mIds[to] = mIds[from];
+    mIndices[mIds[to]] = to;
+}
+
+// Retirer une entité : la dernière prend sa place, les colonnes restent contiguës
+void EntityStore::remove(EntityId id)
+{
+    if(!isValid(id))
+    {
+        return;
+    }
+
+    uint32_t index = mIndices[id];
+    uint32_t last = (uint32_t)mIds.size() - 1;
+    if(index != last)
+    {
+        moveEntity(last, index);
+    }
+
+    mModels.pop_back();
+    mPosX.pop_back(); mPosY.pop_back(); mPosZ.pop_back();
+    mYaw.pop_back();
+    mScaleX.pop_back(); mScaleY.pop_back(); mScaleZ.pop_back();
+    mBounds.pop();
+    mFlags.pop_back();
+    mIds.pop_back();
+
+    mIndices[id] = INVALID_ENTITY;
+    mFreeIds.push_back(id);
+}
+
+// Déplacer une entité
+void EntityStore::setPosition(uint32_t index, glm::vec3 position)
+{
+    mPosX[index] = position.x;
+    mPosY[index] = position.y;
+    mPosZ[index] = position.z;
+}
+
+// Tourner une entité (degrés)
+void EntityStore::setYaw(uint32_t index, float yaw)
+{
+    mYaw[index] = yaw;
+}
+
+// Entrelacer les bits de deux coordonnées de 16 bits (x sur les bits pairs, z sur les bits impairs)
+uint32_t EntityStore::mortonCode(uint32_t x, uint32_t z)
+{
+    auto spread = [](uint32_t v)
+    {
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    return spread(x) | (spread(z) << 1);
+}
+
+// Réordonner toutes les colonnes selon le code de Morton des positions XZ (quantifiées sur 16 bits dans le monde).
+// Le tri est stable : les entités d'une même case gardent leur ordre d'ajout.
+void EntityStore::sortMorton(glm::vec2 worldMin, float worldSize)
+{
+    size_t count = size();
+    std::vector<uint32_t> codes(count);
+    for(size_t i = 0; i < count; i = i + 1)
+    {
+        glm::vec2 cell = glm::clamp((glm::vec2(mPosX[i], mPosZ[i]) - worldMin) / worldSize, 0.0f, 1.0f) * 65535.0f;
+        codes[i] = mortonCode((uint32_t)cell.x, (uint32_t)cell.y);
+    }
+
+    std::vector<uint32_t> order(count);
+    for(size_t i = 0; i < count; i = i + 1)
+    {
+        order[i] = (uint32_t)i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&codes](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+
+    // Nouvelles colonnes dans l'ordre trié
+    EntityStore sorted;
+    sorted.mIndices.assign(mIndices.size(), INVALID_ENTITY);
+    sorted.mFreeIds = mFreeIds;
+    for(uint32_t from : order)
+    {
+        sorted.mIndices[mIds[from]] = (uint32_t)sorted.mIds.size();
+        sorted.mIds.push_back(mIds[from]);
+        sorted.mModels.push_back(mModels[from]);
+        sorted.mPosX.push_back(mPosX[from]); sorted.mPosY.push_back(mPosY[from]); sorted.mPosZ.push_back(mPosZ[from]);
+        sorted.mYaw.push_back(mYaw[from]);
+        sorted.mScaleX.push_back(mScaleX[from]); sorted.mScaleY.push_back(mScaleY[from]); sorted.mScaleZ.push_back(mScaleZ[from]);
+        sorted.mBounds.push(mBounds.get(from));
+        sorted.mFlags.push_back(mFlags[from]);
+    }
+
+    *this = std::move(sorted);
+}
@@ -0,0 +1,77 @@
+#ifndef ENTITY_STORE_HPP
+#define ENTITY_STORE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Bounds.hpp"
+
+typedef uint32_t EntityId; // Identifiant stable d'une entité (ne change pas quand le stockage est réordonné)
+const EntityId INVALID_ENTITY = 0xFFFFFFFF;
+
+// Entités de la scène stockées en SoA : une colonne par champ (modèle, position, rotation Y,
+// échelle, boîte englobante, drapeaux), toutes dans le même ordre. Les passes qui parcourent
+// les entités (transformations, élimination, soumission) lisent seulement les colonnes utiles,
+// en continu. Le stockage peut être trié selon la courbe de Morton des positions XZ : les entités
+// proches dans la scène sont proches en mémoire. Le retrait déplace la dernière entité à la place
+// de l'entité retirée ; les index changent donc, mais pas les identifiants.
+class EntityStore
+{
+public:
+    enum Flags : uint8_t
+    {
+        CAST_SHADOW = 1, // L'entité projette une ombre du soleil
+        STATIC = 2 // L'entité ne bouge jamais
+    };
+
+    void clear(); // Vider le stockage
+    EntityId add(uint32_t model, glm::vec3 position, float yaw, glm::vec3 scale, uint8_t flags); // Ajouter une entité (rotation en degrés, boîte vide)
+    void addBatch(size_t count, const uint32_t* models, const float* posX, const float* posY, const float* posZ, const float* yaw, const uint8_t* flags, const std::vector<glm::vec3>& modelScales); // Ajouter des colonnes entières (échelle de chaque modèle dans modelScales, 1 au-delà)
+    void remove(EntityId id); // Retirer une entité (la dernière prend sa place)
+    void sortMorton(glm::vec2 worldMin, float worldSize); // Réordonner selon la courbe de Morton des positions XZ
+
+    size_t size() const { return mIds.size(); } // Nombre d'entités
+    bool isValid(EntityId id) const { return id < mIndices.size() && mIndices[id] != INVALID_ENTITY; } // Entité présente
+    uint32_t getIndex(EntityId id) const { return mIndices[id]; } // Index d'une entité dans les colonnes
+    EntityId getId(uint32_t index) const { return mIds[index]; } // Identifiant de l'entité d'un index
+
+    // Colonnes, par index
+    uint32_t getModel(uint32_t index) const { return mModels[index]; } // Identifiant du modèle (ModelHandle)
+    glm::vec3 getPosition(uint32_t index) const { return glm::vec3(mPosX[index], mPosY[index], mPosZ[index]); }
+    float getYaw(uint32_t index) const { return mYaw[index]; } // Rotation Y en degrés
+    glm::vec3 getScale(uint32_t index) const { return glm::vec3(mScaleX[index], mScaleY[index], mScaleZ[index]); }
+    uint8_t getFlags(uint32_t index) const { return mFlags[index]; }
+    bool castsShadow(uint32_t index) const { return (mFlags[index] & CAST_SHADOW) != 0; }
+    const AABBArray& getBounds() const { return mBounds; } // Boîtes englobantes en monde (tests SIMD)
+
+    void setPosition(uint32_t index, glm::vec3 position); // Déplacer une entité
+    void setYaw(uint32_t index, float yaw); // Tourner une entité (degrés)
+    void setBounds(uint32_t index, const AABB& box) { mBounds.set(index, box); } // Boîte englobante en monde
+
+    // Parcourir les entités par lots contigus : f(premier index, index de fin exclu)
+    template<typename Function>
+    void forEachBatch(size_t batchSize, Function f) const
+    {
+        for(size_t first = 0; first < size(); first = first + batchSize)
+        {
+            f((uint32_t)first, (uint32_t)glm::min(first + batchSize, size()));
+        }
+    }
+
+private:
+    void moveEntity(uint32_t from, uint32_t to); // Copier toutes les colonnes d'un index vers un autre
+    static uint32_t mortonCode(uint32_t x, uint32_t z); // Entrelacer les bits de deux coordonnées de 16 bits
+
+    std::vector<uint32_t> mModels; // Modèles
+    std::vector<float> mPosX, mPosY, mPosZ; // Positions
+    std::vector<float> mYaw; // Rotations Y
+    std::vector<float> mScaleX, mScaleY, mScaleZ; // Échelles
+    AABBArray mBounds; // Boîtes englobantes
+    std::vector<uint8_t> mFlags; // Drapeaux
+    std::vector<EntityId> mIds; // Identifiant de chaque index
+    std::vector<uint32_t> mIndices; // Index de chaque identifiant (INVALID_ENTITY : libre)
+    std::vector<EntityId> mFreeIds; // Identifiants libérés, réutilisés par add
+};
+
+#endif // ENTITY_STORE_HPP
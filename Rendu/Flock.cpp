@@ -0,0 +1,323 @@
+#include "Flock.hpp"
+#include "Simd.hpp"
+#include <cmath>
+#include <algorithm>
+
+// Oiseaux par tâche du JobSystem
+static const size_t BIRDS_PER_JOB = 256;
+
+// Cellules voisines d'un oiseau, la sienne en premier (les voisins les plus proches comptent avant la limite)
+static const int NEIGHBOR_CELLS[27][3] =
+{
+    { 0, 0, 0 },
+    { -1, -1, -1 }, { 0, -1, -1 }, { 1, -1, -1 }, { -1, 0, -1 }, { 0, 0, -1 }, { 1, 0, -1 }, { -1, 1, -1 }, { 0, 1, -1 }, { 1, 1, -1 },
+    { -1, -1, 0 }, { 0, -1, 0 }, { 1, -1, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { -1, 1, 0 }, { 0, 1, 0 }, { 1, 1, 0 },
+    { -1, -1, 1 }, { 0, -1, 1 }, { 1, -1, 1 }, { -1, 0, 1 }, { 0, 0, 1 }, { 1, 0, 1 }, { -1, 1, 1 }, { 0, 1, 1 }, { 1, 1, 1 }
+};
+
+
+// Mélange 64 bits (finaliseur de splitmix64)
+static uint64_t mix64(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Nombre aléatoire n° counter d'une graine, dans [0, 1[ (générateur à compteur : aucun état)
+static float randomFloat(uint64_t key, uint32_t counter)
+{
+    return (float)(mix64(key + (uint64_t)(counter + 1) * 0x9e3779b97f4a7c15ull) >> 40) / 16777216.0f;
+}
+
+// Somme des 4 voies
+static float sum4(float4 value)
+{
+    float lanes[4];
+    value.store(lanes);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// Nombre de bits d'un masque de 4 voies
+static size_t countBits(int mask)
+{
+    return (size_t)((mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1));
+}
+
+
+Flock::Flock() : mCount(0), mInvCellSize(1.0f), mBucketMask(0)
+{
+}
+
+// Oiseaux tirés dans la moitié centrale de la zone de vol, directions au hasard : les groupes se forment en vol
+void Flock::init(const FlockSettings& settings)
+{
+    mSettings = settings;
+    mCount = settings.count;
+    mInvCellSize = 1.0f / settings.neighborRadius;
+
+    uint32_t bucketCount = 64;
+    while(bucketCount < 2 * mCount)
+    {
+        bucketCount = bucketCount * 2;
+    }
+    mBucketMask = bucketCount - 1;
+    mBuckets.assign(mCount, 0);
+    mBucketStart.assign(bucketCount + 1, 0);
+
+    size_t size = ((mCount + 3) & ~(size_t)3) + 4;
+    std::vector<float>* columns[14] = { &mPositionX, &mPositionY, &mPositionZ, &mVelocityX, &mVelocityY, &mVelocityZ, &mPhase,
+                                        &mSortedX, &mSortedY, &mSortedZ, &mSortedVelocityX, &mSortedVelocityY, &mSortedVelocityZ, &mSortedPhase };
+    for(std::vector<float>* column : columns)
+    {
+        column->assign(size, 0.0f);
+    }
+
+    uint64_t key = mix64(settings.seed);
+    float speed = 0.5f * (settings.minSpeed + settings.maxSpeed);
+    for(size_t i = 0; i < mCount; i = i + 1)
+    {
+        uint32_t counter = (uint32_t)i * 5;
+        float angle = randomFloat(key, counter) * 6.2831853f;
+        float distance = 0.5f * settings.radius * std::sqrt(randomFloat(key, counter + 1));
+        float heading = randomFloat(key, counter + 3) * 6.2831853f;
+        mPositionX[i] = settings.center.x + distance * std::cos(angle);
+        mPositionY[i] = glm::mix(settings.minHeight, settings.maxHeight, randomFloat(key, counter + 2));
+        mPositionZ[i] = settings.center.z + distance * std::sin(angle);
+        mVelocityX[i] = speed * std::cos(heading);
+        mVelocityY[i] = 0.0f;
+        mVelocityZ[i] = speed * std::sin(heading);
+        mPhase[i] = randomFloat(key, counter + 4) * 6.2831853f;
+    }
+}
+
+// Hachage des coordonnées entières de la cellule (les cellules d'une même case sont séparées par le test de distance)
+uint32_t Flock::getBucket(int x, int y, int z) const
+{
+    return (((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u) ^ ((uint32_t)z * 83492791u)) & mBucketMask;
+}
+
+// Tri par comptage : nombre d'oiseaux par case, débuts des cases, puis copie de chaque oiseau à sa place
+void Flock::buildGrid()
+{
+    uint32_t bucketCount = mBucketMask + 1;
+    std::fill(mBucketStart.begin(), mBucketStart.end(), 0);
+    for(size_t i = 0; i < mCount; i = i + 1)
+    {
+        int x = (int)std::floor(mPositionX[i] * mInvCellSize);
+        int y = (int)std::floor(mPositionY[i] * mInvCellSize);
+        int z = (int)std::floor(mPositionZ[i] * mInvCellSize);
+        mBuckets[i] = getBucket(x, y, z);
+        mBucketStart[mBuckets[i]] = mBucketStart[mBuckets[i]] + 1;
+    }
+
+    uint32_t start = 0;
+    for(uint32_t b = 0; b <= bucketCount; b = b + 1)
+    {
+        uint32_t count = mBucketStart[b];
+        mBucketStart[b] = start;
+        start = start + count;
+    }
+
+    for(size_t i = 0; i < mCount; i = i + 1)
+    {
+        uint32_t j = mBucketStart[mBuckets[i]];
+        mBucketStart[mBuckets[i]] = j + 1;
+        mSortedX[j] = mPositionX[i];
+        mSortedY[j] = mPositionY[i];
+        mSortedZ[j] = mPositionZ[i];
+        mSortedVelocityX[j] = mVelocityX[i];
+        mSortedVelocityY[j] = mVelocityY[i];
+        mSortedVelocityZ[j] = mVelocityZ[i];
+        mSortedPhase[j] = mPhase[i];
+    }
+
+    // Chaque début a avancé jusqu'au début de la case suivante : décalage d'une case
+    for(uint32_t b = bucketCount; b > 0; b = b - 1)
+    {
+        mBucketStart[b] = mBucketStart[b - 1];
+    }
+    mBucketStart[0] = 0;
+}
+
+// Voisins de chaque oiseau rangé, 4 à la fois dans les cases des 27 cellules autour de lui (une case n'est lue
+// qu'une fois même si plusieurs cellules y tombent ; liste des cases gardée pour les oiseaux suivants de la même
+// cellule, contigus après le rangement), jusqu'à maxNeighbors ; puis alignement, cohésion,
+// séparation et retour dans la zone de vol. Les oiseaux mis à jour sont écrits dans les colonnes principales,
+// dans l'ordre du rangement (les oiseaux proches restent proches en mémoire au pas suivant).
+void Flock::updateRange(size_t first, size_t last, float deltaTime)
+{
+    const FlockSettings& settings = mSettings;
+    float4 zero = float4::zero();
+    float4 one(1.0f);
+    float4 epsilon(1e-4f);
+    float4 lanes(0.0f, 1.0f, 2.0f, 3.0f);
+    float4 neighborRadius2(settings.neighborRadius * settings.neighborRadius);
+    float4 separationRadius2(settings.separationRadius * settings.separationRadius);
+    glm::ivec3 listCell(0);
+    uint32_t buckets[27];
+    int bucketCount = 0;
+
+    for(size_t i = first; i < last; i = i + 1)
+    {
+        glm::vec3 position(mSortedX[i], mSortedY[i], mSortedZ[i]);
+        glm::vec3 velocity(mSortedVelocityX[i], mSortedVelocityY[i], mSortedVelocityZ[i]);
+        float4 x(position.x), y(position.y), z(position.z);
+        glm::ivec3 cell((int)std::floor(position.x * mInvCellSize), (int)std::floor(position.y * mInvCellSize), (int)std::floor(position.z * mInvCellSize));
+        if(bucketCount == 0 || cell != listCell)
+        {
+            listCell = cell;
+            bucketCount = 0;
+            for(int c = 0; c < 27; c = c + 1)
+            {
+                uint32_t bucket = getBucket(cell.x + NEIGHBOR_CELLS[c][0], cell.y + NEIGHBOR_CELLS[c][1], cell.z + NEIGHBOR_CELLS[c][2]);
+                if(std::find(buckets, buckets + bucketCount, bucket) == buckets + bucketCount)
+                {
+                    buckets[bucketCount] = bucket;
+                    bucketCount = bucketCount + 1;
+                }
+            }
+        }
+
+        float4 count = zero;
+        float4 offsetX = zero, offsetY = zero, offsetZ = zero; // Positions des voisins relatives à l'oiseau
+        float4 velocityX = zero, velocityY = zero, velocityZ = zero;
+        float4 separationX = zero, separationY = zero, separationZ = zero;
+        size_t found = 0;
+
+        for(int c = 0; c < bucketCount && found < settings.maxNeighbors; c = c + 1)
+        {
+            uint32_t bucket = buckets[c];
+            uint32_t end = mBucketStart[bucket + 1];
+            float4 endLane((float)end);
+            for(uint32_t j = mBucketStart[bucket]; j < end && found < settings.maxNeighbors; j = j + 4)
+            {
+                float4 dx = float4::load(&mSortedX[j]) - x;
+                float4 dy = float4::load(&mSortedY[j]) - y;
+                float4 dz = float4::load(&mSortedZ[j]) - z;
+                float4 distance2 = dx * dx + dy * dy + dz * dz;
+
+                // Voisin : dans la portée, pas l'oiseau lui-même, dans la case
+                float4 near = cmplt(distance2, neighborRadius2) & cmpgt(distance2, zero) & cmplt(lanes + float4((float)j), endLane);
+                int mask = movemask(near);
+                if(mask == 0)
+                {
+                    continue;
+                }
+                found = found + countBits(mask);
+
+                count = count + (one & near);
+                offsetX = offsetX + (dx & near);
+                offsetY = offsetY + (dy & near);
+                offsetZ = offsetZ + (dz & near);
+                velocityX = velocityX + (float4::load(&mSortedVelocityX[j]) & near);
+                velocityY = velocityY + (float4::load(&mSortedVelocityY[j]) & near);
+                velocityZ = velocityZ + (float4::load(&mSortedVelocityZ[j]) & near);
+
+                // Séparation : s'écarter d'autant plus que le voisin est proche (1 / distance)
+                float4 close = cmplt(distance2, separationRadius2) & near;
+                float4 inverse = one / max4(distance2, epsilon);
+                separationX = separationX - ((dx * inverse) & close);
+                separationY = separationY - ((dy * inverse) & close);
+                separationZ = separationZ - ((dz * inverse) & close);
+            }
+        }
+
+        glm::vec3 acceleration(0.0f);
+        float neighbors = sum4(count);
+        if(neighbors > 0.0f)
+        {
+            glm::vec3 meanVelocity = glm::vec3(sum4(velocityX), sum4(velocityY), sum4(velocityZ)) / neighbors;
+            glm::vec3 meanOffset = glm::vec3(sum4(offsetX), sum4(offsetY), sum4(offsetZ)) / neighbors;
+            acceleration = acceleration + (meanVelocity - velocity) * settings.alignmentWeight;
+            acceleration = acceleration + meanOffset * settings.cohesionWeight;
+            acceleration = acceleration + glm::vec3(sum4(separationX), sum4(separationY), sum4(separationZ)) * settings.separationWeight;
+        }
+
+        // Retour dans la zone de vol, proportionnel au dépassement, et vol à plat de préférence
+        glm::vec2 fromCenter = glm::vec2(position.x - settings.center.x, position.z - settings.center.z);
+        float horizontal = glm::length(fromCenter);
+        if(horizontal > settings.radius)
+        {
+            glm::vec2 back = -fromCenter / horizontal * (horizontal - settings.radius) * settings.boundsWeight;
+            acceleration = acceleration + glm::vec3(back.x, 0.0f, back.y);
+        }
+        if(position.y < settings.minHeight)
+        {
+            acceleration.y = acceleration.y + (settings.minHeight - position.y) * settings.boundsWeight;
+        }
+        else if(position.y > settings.maxHeight)
+        {
+            acceleration.y = acceleration.y - (position.y - settings.maxHeight) * settings.boundsWeight;
+        }
+        acceleration.y = acceleration.y - velocity.y * settings.boundsWeight;
+
+        float accelerationLength = glm::length(acceleration);
+        if(accelerationLength > settings.maxAcceleration)
+        {
+            acceleration = acceleration * (settings.maxAcceleration / accelerationLength);
+        }
+
+        velocity = velocity + acceleration * deltaTime;
+        float speed = glm::length(velocity);
+        velocity = speed > 1e-4f ? velocity * (glm::clamp(speed, settings.minSpeed, settings.maxSpeed) / speed) : glm::vec3(settings.minSpeed, 0.0f, 0.0f);
+        position = position + velocity * deltaTime;
+
+        mPositionX[i] = position.x;
+        mPositionY[i] = position.y;
+        mPositionZ[i] = position.z;
+        mVelocityX[i] = velocity.x;
+        mVelocityY[i] = velocity.y;
+        mVelocityZ[i] = velocity.z;
+        mPhase[i] = mSortedPhase[i];
+    }
+}
+
+// Grille sur le thread appelant (rapide, linéaire), puis règles par paquets d'oiseaux sur les threads
+void Flock::update(float deltaTime, JobSystem& jobs)
+{
+    if(mCount == 0)
+    {
+        return;
+    }
+
+    buildGrid();
+    size_t jobCount = (mCount + BIRDS_PER_JOB - 1) / BIRDS_PER_JOB;
+    jobs.run(jobCount, [&](size_t job)
+    {
+        updateRange(job * BIRDS_PER_JOB, std::min(mCount, (job + 1) * BIRDS_PER_JOB), deltaTime);
+    });
+}
+
+// Sphères des oiseaux contre les 6 plans, 4 oiseaux à la fois ; seuls les oiseaux visibles sont écrits
+size_t Flock::writeInstances(BirdInstance* out, const Frustum& frustum, float radius) const
+{
+    size_t written = 0;
+    float4 minDistance(-radius);
+    for(size_t i = 0; i < mCount; i = i + 4)
+    {
+        float4 x = float4::load(&mPositionX[i]);
+        float4 y = float4::load(&mPositionY[i]);
+        float4 z = float4::load(&mPositionZ[i]);
+        int inside = mCount - i >= 4 ? 0xF : (1 << (mCount - i)) - 1;
+        for(int p = 0; p < 6 && inside != 0; p = p + 1)
+        {
+            const glm::vec4& plane = frustum.planes[p];
+            float4 d = float4(plane.x) * x + float4(plane.y) * y + float4(plane.z) * z + float4(plane.w);
+            inside = inside & movemask(cmpge(d, minDistance));
+        }
+
+        for(int k = 0; k < 4 && inside != 0; k = k + 1)
+        {
+            if((inside >> k) & 1)
+            {
+                size_t b = i + k;
+                float flap = glm::clamp(0.4f + 2.0f * mVelocityY[b] / mSettings.maxSpeed, 0.15f, 1.0f); // Plané en piqué, battement en montée
+                out[written].position = glm::vec4(mPositionX[b], mPositionY[b], mPositionZ[b], mPhase[b]);
+                out[written].velocity = glm::vec4(mVelocityX[b], mVelocityY[b], mVelocityZ[b], flap);
+                written = written + 1;
+            }
+        }
+    }
+    return written;
+}
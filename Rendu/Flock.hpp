@@ -0,0 +1,83 @@
+#ifndef FLOCK_HPP
+#define FLOCK_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Bounds.hpp"
+#include "JobSystem.hpp"
+
+// Paramètres de la nuée d'oiseaux
+struct FlockSettings
+{
+    uint32_t seed = 1; // Même graine, mêmes oiseaux au départ
+    size_t count = 2000; // Nombre d'oiseaux
+    glm::vec3 center = glm::vec3(0.0f, 45.0f, 0.0f); // Centre de la zone de vol
+    float radius = 120.0f; // Rayon horizontal de la zone de vol
+    float minHeight = 35.0f; // Hauteurs de vol (au-dessus des arbres des collines)
+    float maxHeight = 60.0f;
+    float neighborRadius = 5.0f; // Portée de l'alignement et de la cohésion (côté des cellules de la grille)
+    float separationRadius = 1.5f; // Distance en dessous de laquelle deux oiseaux s'écartent
+    size_t maxNeighbors = 16; // Voisins pris en compte au plus (coût d'un oiseau borné dans les nuées denses)
+    float minSpeed = 6.0f; // Vitesse de vol
+    float maxSpeed = 12.0f;
+    float separationWeight = 8.0f; // Poids des trois règles et du retour dans la zone de vol
+    float alignmentWeight = 1.5f;
+    float cohesionWeight = 0.8f;
+    float boundsWeight = 0.5f;
+    float maxAcceleration = 20.0f; // Virages au plus serré
+};
+
+// Oiseau prêt à dessiner, lu par bird.vert (attributs 3 et 4, un pas par instance)
+struct BirdInstance
+{
+    glm::vec4 position; // Position, phase du battement d'ailes
+    glm::vec4 velocity; // Vitesse (direction du vol), amplitude du battement (1 en montée, faible en piqué)
+};
+
+// Nuée d'oiseaux (boids) : chaque oiseau suit ses voisins (alignement, cohésion) sans s'en approcher
+// (séparation) et revient vers la zone de vol. Les oiseaux sont en SoA ; à chaque pas, ils sont rangés par
+// cellule d'une grille uniforme (côté : la portée des voisins) dont les cellules sont hachées dans une table
+// de taille fixe (tri par comptage), si bien que les voisins d'une cellule sont contigus en mémoire et
+// testés 4 à la fois (SIMD) dans les 27 cellules autour de l'oiseau. Les oiseaux sont répartis par paquets
+// sur les threads (JobSystem) : chacun lit les colonnes rangées et écrit les siennes, le résultat ne dépend
+// pas du nombre de threads.
+class Flock
+{
+public:
+    Flock();
+
+    void init(const FlockSettings& settings); // Tirer les oiseaux dans la zone de vol
+    void update(float deltaTime, JobSystem& jobs); // Un pas de simulation (grille, puis règles sur les threads)
+    size_t writeInstances(BirdInstance* out, const Frustum& frustum, float radius) const; // Écrire les oiseaux dans la pyramide de vue (sphère de rayon radius), renvoie leur nombre
+
+    size_t size() const { return mCount; }
+    const FlockSettings& getSettings() const { return mSettings; }
+    glm::vec3 getPosition(size_t index) const { return glm::vec3(mPositionX[index], mPositionY[index], mPositionZ[index]); }
+    glm::vec3 getVelocity(size_t index) const { return glm::vec3(mVelocityX[index], mVelocityY[index], mVelocityZ[index]); }
+
+private:
+    void buildGrid(); // Ranger les oiseaux par cellule dans les colonnes triées
+    void updateRange(size_t first, size_t last, float deltaTime); // Règles des oiseaux rangés de first à last
+    uint32_t getBucket(int x, int y, int z) const; // Case de la table d'une cellule de la grille
+
+    FlockSettings mSettings;
+    size_t mCount;
+    float mInvCellSize;
+    uint32_t mBucketMask; // Taille de la table - 1 (puissance de 2)
+
+    // Oiseaux, colonnes complétées à un multiple de 4 (+ 4 pour les lectures par groupes de 4)
+    std::vector<float> mPositionX, mPositionY, mPositionZ;
+    std::vector<float> mVelocityX, mVelocityY, mVelocityZ;
+    std::vector<float> mPhase; // Phase du battement d'ailes (propre à chaque oiseau)
+
+    // Oiseaux rangés par case de la table, lus par tous les threads pendant un pas
+    std::vector<float> mSortedX, mSortedY, mSortedZ;
+    std::vector<float> mSortedVelocityX, mSortedVelocityY, mSortedVelocityZ;
+    std::vector<float> mSortedPhase;
+    std::vector<uint32_t> mBuckets; // Case de chaque oiseau
+    std::vector<uint32_t> mBucketStart; // Premier oiseau rangé de chaque case (+ fin de la dernière)
+};
+
+#endif // FLOCK_HPP
@@ -0,0 +1,203 @@
+#include "ForestGenerator.hpp"
+#include <cmath>
+#include <thread>
+#include <atomic>
+
+
+// Mélange 64 bits (finaliseur de splitmix64)
+static uint64_t mix64(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Clé d'une tuile : graine et coordonnées de la tuile
+static uint64_t tileKey(uint32_t seed, int tileX, int tileZ)
+{
+    return mix64(((uint64_t)seed << 32) ^ mix64(((uint64_t)(uint32_t)tileX << 32) | (uint32_t)tileZ));
+}
+
+// Nombre aléatoire n° counter d'une tuile (générateur à compteur : aucun état)
+static uint64_t randomBits(uint64_t key, uint32_t counter)
+{
+    return mix64(key + (uint64_t)(counter + 1) * 0x9e3779b97f4a7c15ull);
+}
+
+// Nombre aléatoire dans [0, 1[
+static float randomFloat(uint64_t key, uint32_t counter)
+{
+    return (float)(randomBits(key, counter) >> 40) / 16777216.0f;
+}
+
+// Nombres tirés par candidat : position x et z, priorité, rotation, espèce, densité
+static const uint32_t RANDOMS_PER_CANDIDATE = 6;
+
+
+ForestGenerator::ForestGenerator(const ForestSettings& settings) : mSettings(settings)
+{
+    mSettings.minDistance = glm::min(mSettings.minDistance, mSettings.tileSize);
+    mTilesPerSide = glm::max((int)std::ceil(mSettings.worldSize / mSettings.tileSize), 1);
+    mCandidatesPerTile = (int)std::round(mSettings.candidateDensity * mSettings.tileSize * mSettings.tileSize);
+
+    float total = 0.0f;
+    for(const ForestSpecies& species : mSettings.species)
+    {
+        total = total + species.weight;
+        mCumulativeWeights.push_back(total);
+    }
+    for(float& weight : mCumulativeWeights)
+    {
+        weight = weight / total;
+    }
+}
+
+// Candidats d'une tuile : positions uniformes dans la tuile et priorités aléatoires
+void ForestGenerator::getCandidates(int tileX, int tileZ, std::vector<Candidate>& candidates) const
+{
+    uint64_t key = tileKey(mSettings.seed, tileX, tileZ);
+    glm::vec2 tileMin = mSettings.worldMin + glm::vec2((float)tileX, (float)tileZ) * mSettings.tileSize;
+
+    for(int c = 0; c < mCandidatesPerTile; c = c + 1)
+    {
+        uint32_t counter = (uint32_t)c * RANDOMS_PER_CANDIDATE;
+        Candidate candidate;
+        candidate.position = tileMin + glm::vec2(randomFloat(key, counter), randomFloat(key, counter + 1)) * mSettings.tileSize;
+        candidate.priority = randomBits(key, counter + 2);
+        candidates.push_back(candidate);
+    }
+}
+
+// Densité interpolée dans la table (distance au centre)
+float ForestGenerator::getDensity(glm::vec2 position) const
+{
+    const std::vector<ForestDensity>& table = mSettings.densities;
+    if(table.empty())
+    {
+        return 1.0f;
+    }
+
+    float distance = glm::length(position - mSettings.center);
+    if(distance <= table.front().distance)
+    {
+        return table.front().density;
+    }
+
+    for(size_t i = 1; i < table.size(); i = i + 1)
+    {
+        if(distance < table[i].distance)
+        {
+            float t = (distance - table[i - 1].distance) / (table[i].distance - table[i - 1].distance);
+            return glm::mix(table[i - 1].density, table[i].density, t);
+        }
+    }
+    return table.back().density;
+}
+
+// Modèle tiré selon les poids cumulés
+uint32_t ForestGenerator::pickSpecies(float random) const
+{
+    for(size_t i = 0; i < mCumulativeWeights.size(); i = i + 1)
+    {
+        if(random < mCumulativeWeights[i])
+        {
+            return mSettings.species[i].model;
+        }
+    }
+    return mSettings.species.back().model;
+}
+
+// Générer une tuile : candidats gardés par l'amincissement de Matérn contre les candidats de la tuile
+// et de ses 8 voisines, puis par la table de densité, espèce et rotation tirées par candidat
+void ForestGenerator::generateTile(int tileX, int tileZ, std::vector<ForestInstance>& instances) const
+{
+    if(mSettings.species.empty())
+    {
+        return;
+    }
+
+    std::vector<Candidate> own;
+    getCandidates(tileX, tileZ, own);
+
+    std::vector<Candidate> neighbours;
+    for(int dz = -1; dz <= 1; dz = dz + 1)
+    {
+        for(int dx = -1; dx <= 1; dx = dx + 1)
+        {
+            getCandidates(tileX + dx, tileZ + dz, neighbours);
+        }
+    }
+
+    uint64_t key = tileKey(mSettings.seed, tileX, tileZ);
+    glm::vec2 worldMax = mSettings.worldMin + mSettings.worldSize;
+    float minDistance2 = mSettings.minDistance * mSettings.minDistance;
+
+    for(size_t c = 0; c < own.size(); c = c + 1)
+    {
+        const Candidate& candidate = own[c];
+        if(candidate.position.x >= worldMax.x || candidate.position.y >= worldMax.y)
+        {
+            continue; // Dernière tuile partielle
+        }
+
+        // Un candidat plus prioritaire trop proche élimine celui-ci (le candidat lui-même a la même priorité)
+        bool kept = true;
+        for(const Candidate& other : neighbours)
+        {
+            glm::vec2 d = other.position - candidate.position;
+            if(other.priority > candidate.priority && glm::dot(d, d) < minDistance2)
+            {
+                kept = false;
+                break;
+            }
+        }
+
+        uint32_t counter = (uint32_t)c * RANDOMS_PER_CANDIDATE;
+        if(!kept || randomFloat(key, counter + 5) >= getDensity(candidate.position))
+        {
+            continue;
+        }
+
+        ForestInstance instance;
+        instance.model = pickSpecies(randomFloat(key, counter + 4));
+        instance.position = glm::vec3(candidate.position.x, 0.0f, candidate.position.y);
+        instance.yaw = randomFloat(key, counter + 3) * 360.0f;
+        instances.push_back(instance);
+    }
+}
+
+// Générer toutes les tuiles sur threadCount threads (un compteur partagé distribue les tuiles),
+// puis les mettre bout à bout dans l'ordre des tuiles : le résultat ne dépend pas du nombre de threads
+std::vector<ForestInstance> ForestGenerator::generate(int threadCount) const
+{
+    size_t tileCount = (size_t)mTilesPerSide * mTilesPerSide;
+    std::vector<std::vector<ForestInstance>> tiles(tileCount);
+    std::atomic<size_t> nextTile(0);
+
+    auto worker = [&]()
+    {
+        for(size_t t = nextTile++; t < tileCount; t = nextTile++)
+        {
+            generateTile((int)(t % mTilesPerSide), (int)(t / mTilesPerSide), tiles[t]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(int t = 1; t < threadCount; t = t + 1)
+    {
+        threads.emplace_back(worker);
+    }
+    worker(); // Le thread appelant travaille aussi
+
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<ForestInstance> instances;
+    for(const std::vector<ForestInstance>& tile : tiles)
+    {
+        instances.insert(instances.end(), tile.begin(), tile.end());
+    }
+    return instances;
+}
@@ -0,0 +1,77 @@
+#ifndef FOREST_GENERATOR_HPP
+#define FOREST_GENERATOR_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Espèce de la forêt : modèle et poids dans le tirage (probabilité = poids / somme des poids)
+struct ForestSpecies
+{
+    uint32_t model; // Identifiant du modèle (ModelHandle)
+    float weight;
+};
+
+// Point de la table de densité : fraction des emplacements gardés selon la distance au centre (interpolée)
+struct ForestDensity
+{
+    float distance;
+    float density; // 0 : clairière, 1 : forêt dense
+};
+
+// Paramètres de la forêt
+struct ForestSettings
+{
+    uint32_t seed = 1; // Même graine, même forêt, quel que soit le nombre de threads ou la plateforme
+    glm::vec2 worldMin = glm::vec2(-150.0f); // Zone couverte (XZ)
+    float worldSize = 300.0f;
+    glm::vec2 center = glm::vec2(0.0f); // Centre des distances de la table de densité
+    float tileSize = 32.0f; // Côté d'une tuile (générée indépendamment des autres)
+    float minDistance = 5.0f; // Distance minimale entre deux objets (au plus tileSize)
+    float candidateDensity = 0.03f; // Candidats par unité carrée avant l'élimination des voisins trop proches
+    std::vector<ForestSpecies> species; // Table des probabilités des modèles
+    std::vector<ForestDensity> densities; // Table des densités, triée par distance (vide : densité 1)
+};
+
+// Objet généré
+struct ForestInstance
+{
+    uint32_t model;
+    glm::vec3 position;
+    float yaw; // Rotation Y en degrés
+};
+
+// Générateur procédural de forêt, tuile par tuile. Chaque nombre aléatoire est le hachage de
+// (graine, tuile, compteur) : une tuile ne dépend d'aucun état partagé et peut être générée sur
+// n'importe quel thread. L'espacement de Poisson est obtenu par amincissement de Matérn (type II) :
+// chaque candidat reçoit une priorité aléatoire et n'est gardé que si aucun candidat plus
+// prioritaire n'est à moins de minDistance. Les candidats des 8 tuiles voisines sont recalculés
+// (même hachage), la distance minimale est donc respectée aussi entre les tuiles.
+class ForestGenerator
+{
+public:
+    explicit ForestGenerator(const ForestSettings& settings);
+
+    std::vector<ForestInstance> generate(int threadCount) const; // Toutes les tuiles, résultat dans l'ordre des tuiles
+    void generateTile(int tileX, int tileZ, std::vector<ForestInstance>& instances) const; // Une tuile (ajoutée à instances)
+
+    int getTilesPerSide() const { return mTilesPerSide; }
+
+private:
+    struct Candidate
+    {
+        glm::vec2 position;
+        uint64_t priority;
+    };
+
+    void getCandidates(int tileX, int tileZ, std::vector<Candidate>& candidates) const; // Candidats d'une tuile (ajoutés)
+    float getDensity(glm::vec2 position) const; // Densité interpolée dans la table
+    uint32_t pickSpecies(float random) const; // Modèle tiré selon les poids
+
+    ForestSettings mSettings;
+    int mTilesPerSide;
+    int mCandidatesPerTile;
+    std::vector<float> mCumulativeWeights; // Poids cumulés des espèces, normalisés
+};
+
+#endif // FOREST_GENERATOR_HPP
@@ -0,0 +1,153 @@
+#include "ForestHlod.hpp"
+#include <cmath>
+#include <cstddef>
+
+
+ForestHlod::ForestHlod() : mReplacedCount(0), mVAO(0), mVBO(0)
+{
+}
+
+ForestHlod::~ForestHlod()
+{
+    glDeleteVertexArrays(1, &mVAO);
+    glDeleteBuffers(1, &mVBO);
+}
+
+// Carte verticale d'un arbre : quad centré sur la sphère englobante, texturé par une image de l'atlas
+// (right : axe horizontal de l'image dans l'espace du modèle, même construction que le précalcul)
+void ForestHlod::addCard(std::vector<Vertex>& vertices, const HlodTree& tree, const glm::vec3& right, const glm::vec2& frame, int frames) const
+{
+    const glm::vec2 corners[6] = { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) };
+
+    float c = std::cos(tree.yaw);
+    float s = std::sin(tree.yaw);
+    glm::vec3 worldRight(c * right.x + s * right.z, 0.0f, -s * right.x + c * right.z);
+    glm::vec3 center = glm::vec3(tree.sphere);
+    float radius = tree.sphere.w;
+
+    for(const glm::vec2& corner : corners)
+    {
+        Vertex vertex;
+        vertex.position = center + (worldRight * corner.x + glm::vec3(0.0f, corner.y, 0.0f)) * radius;
+        vertex.texCoord = glm::vec3((frame + corner * 0.5f + 0.5f) / (float)frames, (float)tree.layer);
+        vertex.rotation = glm::vec2(c, s);
+        vertices.push_back(vertex);
+    }
+}
+
+// Fusionner les arbres par cellule : un proxy de deux cartes croisées par arbre, tous les proxys dans un seul VBO
+void ForestHlod::build(const std::vector<HlodTree>& trees, size_t objectCount, glm::vec2 worldMin, float worldSize, float cellSize, int frames)
+{
+    int cellsPerSide = glm::max((int)std::ceil(worldSize / cellSize), 1);
+
+    // Arbres de chaque cellule de la grille (cellules vides ignorées)
+    std::vector<std::vector<const HlodTree*>> gridTrees(cellsPerSide * cellsPerSide);
+    for(const HlodTree& tree : trees)
+    {
+        int x = glm::clamp((int)std::floor((tree.sphere.x - worldMin.x) / cellSize), 0, cellsPerSide - 1);
+        int z = glm::clamp((int)std::floor((tree.sphere.z - worldMin.y) / cellSize), 0, cellsPerSide - 1);
+        gridTrees[z * cellsPerSide + x].push_back(&tree);
+    }
+
+    // Images latérales de l'hémi-octaèdre : vues depuis +x (axe de l'image -z) et depuis +z (axe de l'image +x)
+    const glm::vec2 frameX((float)(frames - 1), (float)(frames - 1));
+    const glm::vec2 frameZ((float)(frames - 1), 0.0f);
+
+    mCells.clear();
+    mCellBounds.clear();
+    mObjectCells.assign(objectCount, -1);
+    std::vector<Vertex> vertices;
+    for(const auto& cellTrees : gridTrees)
+    {
+        if(cellTrees.empty())
+        {
+            continue;
+        }
+
+        Cell cell;
+        AABB bounds;
+        cell.first = (GLint)vertices.size();
+        for(const HlodTree* tree : cellTrees)
+        {
+            addCard(vertices, *tree, glm::vec3(0.0f, 0.0f, -1.0f), frameX, frames);
+            addCard(vertices, *tree, glm::vec3(1.0f, 0.0f, 0.0f), frameZ, frames);
+
+            bounds.expand(glm::vec3(tree->sphere) - tree->sphere.w);
+            bounds.expand(glm::vec3(tree->sphere) + tree->sphere.w);
+            cell.objects.push_back(tree->object);
+            mObjectCells[tree->object] = (int32_t)mCells.size();
+        }
+        cell.count = (GLsizei)vertices.size() - cell.first;
+
+        mCells.push_back(cell);
+        mCellBounds.push(bounds);
+    }
+    mCellVisible.assign(mCellBounds.paddedSize(), 0);
+
+    if(mVAO == 0)
+    {
+        glGenVertexArrays(1, &mVAO);
+        glGenBuffers(1, &mVBO);
+    }
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, texCoord));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, rotation));
+    glEnableVertexAttribArray(2);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Choisir les cellules remplacées (distance à la boîte, avec hystérésis) et les proxys visibles de l'image
+void ForestHlod::update(const glm::vec3& viewPos, const Frustum& frustum, float distance, float hysteresis)
+{
+    frustumCullAABB(mCellBounds, frustum, mCellVisible.data());
+
+    mDrawFirsts.clear();
+    mDrawCounts.clear();
+    mReplacedCount = 0;
+    for(size_t i = 0; i < mCells.size(); i = i + 1)
+    {
+        Cell& cell = mCells[i];
+        AABB bounds = mCellBounds.get(i);
+        glm::vec3 d = glm::max(glm::max(bounds.min - viewPos, viewPos - bounds.max), glm::vec3(0.0f));
+        float cellDistance = glm::length(d);
+
+        float threshold = cell.replaced ? distance - hysteresis * 0.5f : distance + hysteresis * 0.5f;
+        cell.replaced = cellDistance > threshold;
+
+        if(cell.replaced)
+        {
+            mReplacedCount = mReplacedCount + cell.objects.size();
+            if(mCellVisible[i])
+            {
+                mDrawFirsts.push_back(cell.first);
+                mDrawCounts.push_back(cell.count);
+            }
+        }
+    }
+}
+
+// L'objet est dessiné par le proxy de sa cellule
+bool ForestHlod::isReplaced(uint32_t object) const
+{
+    return object < mObjectCells.size() && mObjectCells[object] >= 0 && mCells[mObjectCells[object]].replaced;
+}
+
+// Dessiner les proxys visibles en un seul appel
+void ForestHlod::draw(ShaderProgram& shader)
+{
+    if(mDrawFirsts.empty())
+    {
+        return;
+    }
+
+    shader.use();
+    glBindVertexArray(mVAO);
+    glMultiDrawArrays(GL_TRIANGLES, mDrawFirsts.data(), mDrawCounts.data(), (GLsizei)mDrawFirsts.size());
+    glBindVertexArray(0);
+}
@@ -0,0 +1,71 @@
+#ifndef FOREST_HLOD_HPP
+#define FOREST_HLOD_HPP
+
+#include <vector>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Bounds.hpp"
+
+#define GLEW_STATIC
+
+// Arbre à fusionner dans le proxy de sa cellule
+struct HlodTree
+{
+    uint32_t object; // Index de l'objet dans la scène
+    glm::vec4 sphere; // Sphère englobante en monde (centre, rayon)
+    float yaw; // Rotation Y en radians
+    int layer; // Couche de l'atlas d'imposteurs du modèle
+};
+
+// Niveaux de détail hiérarchiques de la forêt : les arbres de chaque cellule d'une grille XZ sont
+// fusionnés au chargement en un seul maillage proxy (deux cartes croisées par arbre, texturées
+// par les images latérales des atlas d'imposteurs). Les cellules lointaines sont dessinées en un
+// seul appel (glMultiDrawArrays) à la place de leurs arbres, les cellules proches arbre par arbre.
+class ForestHlod
+{
+public:
+    ForestHlod();
+    ~ForestHlod();
+
+    void build(const std::vector<HlodTree>& trees, size_t objectCount, glm::vec2 worldMin, float worldSize, float cellSize, int frames); // Fusionner les arbres par cellule (frames : directions par côté de l'atlas)
+    void update(const glm::vec3& viewPos, const Frustum& frustum, float distance, float hysteresis); // Choisir les cellules remplacées et visibles
+
+    bool isReplaced(uint32_t object) const; // L'objet est dessiné par le proxy de sa cellule
+    void draw(ShaderProgram& shader); // Dessiner les proxys visibles (atlas liés par l'appelant)
+
+    size_t getCellCount() const { return mCells.size(); } // Cellules avec au moins un arbre
+    int getDrawnCount() const { return (int)mDrawFirsts.size(); } // Proxys dessinés dans l'image
+    size_t getReplacedCount() const { return mReplacedCount; } // Arbres remplacés dans l'image
+
+private:
+    struct Vertex
+    {
+        glm::vec3 position; // Position en monde
+        glm::vec3 texCoord; // Coordonnées dans l'atlas et couche
+        glm::vec2 rotation; // Cosinus et sinus de la rotation Y de l'arbre (normales de l'atlas)
+    };
+
+    struct Cell
+    {
+        std::vector<uint32_t> objects; // Arbres de la cellule
+        GLint first = 0; // Premier sommet du proxy
+        GLsizei count = 0; // Nombre de sommets du proxy
+        bool replaced = false; // Proxy utilisé à la place des arbres
+    };
+
+    void addCard(std::vector<Vertex>& vertices, const HlodTree& tree, const glm::vec3& right, const glm::vec2& frame, int frames) const; // Carte verticale d'un arbre
+
+    std::vector<Cell> mCells;
+    AABBArray mCellBounds; // Boîte de chaque cellule (tests SIMD contre la pyramide de vue)
+    std::vector<uint8_t> mCellVisible;
+    std::vector<int32_t> mObjectCells; // Cellule de chaque objet (-1 : pas dans un proxy)
+    std::vector<GLint> mDrawFirsts; // Proxys de l'image
+    std::vector<GLsizei> mDrawCounts;
+    size_t mReplacedCount;
+    GLuint mVAO, mVBO;
+};
+
+#endif // FOREST_HLOD_HPP
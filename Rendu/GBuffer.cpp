@@ -0,0 +1,133 @@
+#include "GBuffer.hpp"
+#include <iostream>
+
+
+GBuffer::GBuffer() : mFBO(0), mAlbedo(0), mNormal(0), mDepth(0), mEmptyVAO(0), mWidth(0), mHeight(0)
+{
+}
+
+GBuffer::~GBuffer()
+{
+    deleteTextures();
+    glDeleteFramebuffers(1, &mFBO);
+    glDeleteVertexArrays(1, &mEmptyVAO);
+}
+
+// Création du framebuffer et des textures
+bool GBuffer::init(int width, int height)
+{
+    mWidth = width;
+    mHeight = height;
+
+    glGenFramebuffers(1, &mFBO);
+    glGenVertexArrays(1, &mEmptyVAO); // Le profil core exige un VAO lié pour dessiner
+
+    createTextures();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if(status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "Erreur : G-buffer incomplet (" << status << ")" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Recréer les textures si la fenêtre change de taille
+void GBuffer::resize(int width, int height)
+{
+    if(width == mWidth && height == mHeight)
+    {
+        return;
+    }
+
+    mWidth = width;
+    mHeight = height;
+    deleteTextures();
+    createTextures();
+}
+
+// Création des textures attachées
+void GBuffer::createTextures()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+
+    // Albedo
+    glGenTextures(1, &mAlbedo);
+    glBindTexture(GL_TEXTURE_2D, mAlbedo);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mAlbedo, 0);
+
+    // Normale en octaèdre sur deux canaux 16 bits
+    glGenTextures(1, &mNormal);
+    glBindTexture(GL_TEXTURE_2D, mNormal);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16, mWidth, mHeight, 0, GL_RG, GL_UNSIGNED_SHORT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, mNormal, 0);
+
+    // Profondeur (même format que le framebuffer par défaut pour permettre la copie)
+    glGenTextures(1, &mDepth);
+    glBindTexture(GL_TEXTURE_2D, mDepth);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, mWidth, mHeight, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, mDepth, 0);
+
+    GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// Suppression des textures attachées
+void GBuffer::deleteTextures()
+{
+    glDeleteTextures(1, &mAlbedo);
+    glDeleteTextures(1, &mNormal);
+    glDeleteTextures(1, &mDepth);
+    mAlbedo = mNormal = mDepth = 0;
+}
+
+// Lier le G-buffer en écriture
+void GBuffer::bindGeometryPass()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glViewport(0, 0, mWidth, mHeight);
+}
+
+// Lier albedo, normale et profondeur en lecture
+void GBuffer::bindTextures(GLuint firstUnit)
+{
+    glActiveTexture(GL_TEXTURE0 + firstUnit);
+    glBindTexture(GL_TEXTURE_2D, mAlbedo);
+    glActiveTexture(GL_TEXTURE0 + firstUnit + 1);
+    glBindTexture(GL_TEXTURE_2D, mNormal);
+    glActiveTexture(GL_TEXTURE0 + firstUnit + 2);
+    glBindTexture(GL_TEXTURE_2D, mDepth);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+// Dessiner un triangle couvrant tout l'écran (les sommets sont générés dans le shader)
+void GBuffer::drawFullscreen()
+{
+    glBindVertexArray(mEmptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+}
+
+// Copier la profondeur vers le framebuffer par défaut pour les passes avant éventuelles
+void GBuffer::blitDepth()
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, mFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, mWidth, mHeight, 0, 0, mWidth, mHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
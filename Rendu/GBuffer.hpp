@@ -0,0 +1,39 @@
+#ifndef GBUFFER_HPP
+#define GBUFFER_HPP
+
+#include <GL/glew.h>
+
+#define GLEW_STATIC
+
+// G-buffer compact pour le rendu différé (12 octets par pixel) :
+//  - albedo : RGBA8 (couleur de la texture diffuse)
+//  - normale : RG16, normale encodée en octaèdre
+//  - profondeur : DEPTH24_STENCIL8, la position est reconstruite à partir de la profondeur
+class GBuffer
+{
+public:
+    GBuffer();
+    ~GBuffer();
+
+    bool init(int width, int height); // Création du framebuffer et des textures
+    void resize(int width, int height); // Recréer les textures si la fenêtre change de taille
+
+    void bindGeometryPass(); // Lier le G-buffer en écriture
+    void bindTextures(GLuint firstUnit); // Lier albedo, normale et profondeur en lecture
+    void drawFullscreen(); // Dessiner un triangle couvrant tout l'écran
+    void blitDepth(); // Copier la profondeur vers le framebuffer par défaut
+
+    int getWidth() const { return mWidth; }
+    int getHeight() const { return mHeight; }
+
+private:
+    void createTextures(); // Création des textures attachées
+    void deleteTextures(); // Suppression des textures attachées
+
+    GLuint mFBO; // Framebuffer
+    GLuint mAlbedo, mNormal, mDepth; // Textures attachées
+    GLuint mEmptyVAO; // VAO vide pour le triangle plein écran
+    int mWidth, mHeight; // Taille du G-buffer
+};
+
+#endif // GBUFFER_HPP
@@ -0,0 +1,196 @@
+#include "GpuScene.hpp"
+#include <string>
+#include <cstddef>
+
+
+GpuScene::GpuScene() : mCullShader(nullptr), mInstanceCount(0), mVAO(0), mVBO(0), mInstanceSSBO(0), mCommandBuffer(0), mVisibleBuffer(0), mTextures(0)
+{
+}
+
+GpuScene::~GpuScene()
+{
+    glDeleteVertexArrays(1, &mVAO);
+    glDeleteBuffers(1, &mVBO);
+    glDeleteBuffers(1, &mInstanceSSBO);
+    glDeleteBuffers(1, &mCommandBuffer);
+    glDeleteBuffers(1, &mVisibleBuffer);
+    glDeleteTextures(1, &mTextures);
+}
+
+// Contexte OpenGL 4.3 ou plus (le contexte demandé en 3.3 core est souvent créé dans la version la plus récente)
+bool GpuScene::isSupported()
+{
+    return GLEW_VERSION_4_3;
+}
+
+// Copier la texture de chaque modèle dans une couche du tableau (mise à l'échelle par glBlitFramebuffer)
+void GpuScene::buildTextureArray(const std::vector<GpuSceneModel>& models)
+{
+    glGenTextures(1, &mTextures);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mTextures);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, TEXTURE_SIZE, TEXTURE_SIZE, (GLsizei)models.size(), 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    GLuint framebuffers[2];
+    glGenFramebuffers(2, framebuffers);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+
+    for(size_t layer = 0; layer < models.size(); layer = layer + 1)
+    {
+        Texture2D* texture = models[layer].texture;
+        if(texture == nullptr)
+        {
+            continue; // Couche vide : modèle sans texture
+        }
+
+        GLint width = 0;
+        GLint height = 0;
+        glBindTexture(GL_TEXTURE_2D, texture->getId());
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->getId(), 0);
+        glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, mTextures, 0, (GLint)layer);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, TEXTURE_SIZE, TEXTURE_SIZE, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(2, framebuffers);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mTextures);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+// Créer les buffers : sommets de tous les modèles à la suite, instances dans le SSBO,
+// une commande par modèle dont les instances visibles commencent à baseInstance
+bool GpuScene::build(ShaderProgram& cullShader, const std::vector<GpuSceneModel>& models, const std::vector<GpuSceneInstance>& instances)
+{
+    if(!isSupported() || models.empty() || instances.empty())
+    {
+        return false;
+    }
+
+    mCullShader = &cullShader;
+    mInstanceCount = instances.size();
+
+    // Sommets fusionnés et commandes (instanceCount remis à 0 avant chaque élimination)
+    std::vector<Vertex> vertices;
+    std::vector<GLuint> instancesPerDraw(models.size(), 0);
+    for(const GpuSceneInstance& instance : instances)
+    {
+        instancesPerDraw[instance.draw] = instancesPerDraw[instance.draw] + 1;
+    }
+
+    mCommands.clear();
+    GLuint baseInstance = 0;
+    for(size_t m = 0; m < models.size(); m = m + 1)
+    {
+        const Mesh* mesh = models[m].mesh;
+        DrawCommand command = { 0, 0, (GLuint)vertices.size(), baseInstance };
+        if(mesh != nullptr)
+        {
+            command.count = (GLuint)mesh->getVertexCount();
+            vertices.insert(vertices.end(), mesh->getVertices().begin(), mesh->getVertices().begin() + command.count);
+        }
+        mCommands.push_back(command);
+        baseInstance = baseInstance + instancesPerDraw[m];
+    }
+
+    // Sommets (attributs 0 à 2) et index de l'instance visible (attribut 3, un pas par instance :
+    // baseInstance de chaque commande décale la lecture dans le buffer des visibles)
+    glGenVertexArrays(1, &mVAO);
+    glGenBuffers(1, &mVBO);
+    glGenBuffers(1, &mVisibleBuffer);
+    glBindVertexArray(mVAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, texCoords));
+    glEnableVertexAttribArray(2);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVisibleBuffer);
+    glBufferData(GL_ARRAY_BUFFER, mInstanceCount * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(GLuint), (GLvoid*)0);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(3);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Instances, lues par le compute shader et le vertex shader
+    glGenBuffers(1, &mInstanceSSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mInstanceSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, mInstanceCount * sizeof(GpuSceneInstance), instances.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Commandes indirectes, écrites par le compute shader
+    glGenBuffers(1, &mCommandBuffer);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mCommandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, mCommands.size() * sizeof(DrawCommand), mCommands.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    buildTextureArray(models);
+    return true;
+}
+
+// Élimination sur le GPU : un thread par instance, les visibles sont ajoutées à la commande de leur modèle
+void GpuScene::cull(const Frustum& frustum)
+{
+    if(!isReady())
+    {
+        return;
+    }
+
+    // Remettre les compteurs d'instances à 0
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mCommandBuffer);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, mCommands.size() * sizeof(DrawCommand), mCommands.data());
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    mCullShader->use();
+    mCullShader->setUniform("instanceCount", (GLint)mInstanceCount);
+    for(int p = 0; p < 6; p = p + 1)
+    {
+        mCullShader->setUniform(("frustumPlanes[" + std::to_string(p) + "]").c_str(), frustum.planes[p]);
+    }
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mInstanceSSBO);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mCommandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, mVisibleBuffer);
+    glDispatchCompute((GLuint)(mInstanceCount + 63) / 64, 1, 1);
+
+    // Commandes lues par le dessin indirect, index visibles lus comme attribut de sommet
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+}
+
+// Dessiner toutes les instances visibles : une commande par modèle, un seul appel
+void GpuScene::draw(ShaderProgram& shader, GLuint textureUnit)
+{
+    if(!isReady())
+    {
+        return;
+    }
+
+    glActiveTexture(GL_TEXTURE0 + textureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mTextures);
+    glActiveTexture(GL_TEXTURE0);
+
+    shader.use();
+    shader.setUniformSampler("diffuseMaps", textureUnit);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mInstanceSSBO);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mCommandBuffer);
+    glBindVertexArray(mVAO);
+    glMultiDrawArraysIndirect(GL_TRIANGLES, (GLvoid*)0, (GLsizei)mCommands.size(), 0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
@@ -0,0 +1,80 @@
+#ifndef GPU_SCENE_HPP
+#define GPU_SCENE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Texture2D.hpp"
+#include "Mesh.hpp"
+#include "Bounds.hpp"
+
+#define GLEW_STATIC
+
+// Modèle de la scène GPU : sommets et texture
+struct GpuSceneModel
+{
+    const Mesh* mesh;
+    Texture2D* texture;
+};
+
+// Instance de la scène GPU (SSBO, disposition std430, 160 octets)
+struct GpuSceneInstance
+{
+    glm::mat4 model; // Matrice de modèle
+    glm::vec4 normalMatrix[3]; // Matrice des normales précalculée, colonnes
+    glm::vec4 boundsMin; // Boîte englobante en monde
+    glm::vec4 boundsMax;
+    uint32_t draw; // Commande de dessin (modèle)
+    uint32_t layer; // Couche du tableau de textures
+    uint32_t padding[2];
+};
+
+// Scène dessinée par le GPU : toutes les instances sont dans un SSBO, un compute shader les teste
+// contre la pyramide de vue, range les visibles par modèle et écrit les commandes de dessin
+// indirectes. L'image est ensuite dessinée en un seul glMultiDrawArraysIndirect, sans que le CPU
+// ne parcoure les objets. Demande OpenGL 4.3 (compute shaders, SSBO, dessin indirect multiple).
+class GpuScene
+{
+public:
+    static const int TEXTURE_SIZE = 512; // Taille des couches du tableau de textures
+
+    GpuScene();
+    ~GpuScene();
+
+    static bool isSupported(); // Contexte OpenGL 4.3 ou plus
+
+    bool build(ShaderProgram& cullShader, const std::vector<GpuSceneModel>& models, const std::vector<GpuSceneInstance>& instances); // Créer les buffers (modèles fusionnés, instances, commandes)
+    bool isReady() const { return mInstanceCount > 0; } // Scène construite
+
+    void cull(const Frustum& frustum); // Élimination et compactage par le compute shader
+    void draw(ShaderProgram& shader, GLuint textureUnit); // Dessiner les instances visibles en un appel
+
+    size_t getInstanceCount() const { return mInstanceCount; } // Instances dans le SSBO
+    size_t getDrawCount() const { return mCommands.size(); } // Commandes indirectes (une par modèle)
+
+private:
+    // Commande de glMultiDrawArraysIndirect (instanceCount écrit par le compute shader)
+    struct DrawCommand
+    {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint first;
+        GLuint baseInstance; // Premier index visible de la commande dans le buffer des visibles
+    };
+
+    void buildTextureArray(const std::vector<GpuSceneModel>& models); // Copier les textures des modèles dans un tableau
+
+    ShaderProgram* mCullShader;
+    std::vector<DrawCommand> mCommands; // Commandes avec instanceCount à 0, renvoyées avant chaque élimination
+    size_t mInstanceCount;
+    GLuint mVAO, mVBO; // Sommets de tous les modèles, index de l'instance visible (attribut 3)
+    GLuint mInstanceSSBO; // Instances (binding 0)
+    GLuint mCommandBuffer; // Commandes indirectes (binding 1)
+    GLuint mVisibleBuffer; // Index des instances visibles, rangés par commande (binding 2)
+    GLuint mTextures; // Tableau de textures, une couche par modèle
+};
+
+#endif // GPU_SCENE_HPP
@@ -0,0 +1,68 @@
+#include "GpuTimer.hpp"
+
+
+GpuTimer::GpuTimer() : mCurrent(0), mRunning(false), mElapsedMs(0.0)
+{
+    for(int i = 0; i < QUERY_COUNT; i = i + 1)
+    {
+        mQueries[i] = 0;
+        mIssued[i] = false;
+    }
+}
+
+GpuTimer::~GpuTimer()
+{
+    if(mQueries[0] != 0)
+    {
+        glDeleteQueries(QUERY_COUNT, mQueries);
+    }
+}
+
+// Création des requêtes
+void GpuTimer::init()
+{
+    glGenQueries(QUERY_COUNT, mQueries);
+}
+
+// Début de la mesure
+void GpuTimer::begin()
+{
+    if(mQueries[0] == 0 || mRunning)
+    {
+        return;
+    }
+
+    // Lire le résultat de l'image qui a utilisé cette requête, s'il est prêt
+    if(mIssued[mCurrent])
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(mQueries[mCurrent], GL_QUERY_RESULT_AVAILABLE, &available);
+        if(!available)
+        {
+            return; // Le GPU est en retard : on saute cette mesure plutôt que d'attendre
+        }
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(mQueries[mCurrent], GL_QUERY_RESULT, &elapsedNs);
+        double elapsedMs = (double)elapsedNs / 1000000.0;
+        mElapsedMs = (mElapsedMs == 0.0) ? elapsedMs : mElapsedMs * 0.9 + elapsedMs * 0.1; // Lissage
+        mIssued[mCurrent] = false;
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED, mQueries[mCurrent]);
+    mRunning = true;
+}
+
+// Fin de la mesure
+void GpuTimer::end()
+{
+    if(!mRunning)
+    {
+        return;
+    }
+
+    glEndQuery(GL_TIME_ELAPSED);
+    mIssued[mCurrent] = true;
+    mCurrent = (mCurrent + 1) % QUERY_COUNT;
+    mRunning = false;
+}
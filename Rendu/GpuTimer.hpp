@@ -0,0 +1,33 @@
+#ifndef GPU_TIMER_HPP
+#define GPU_TIMER_HPP
+
+#include <GL/glew.h>
+
+#define GLEW_STATIC
+
+// Mesure du temps GPU d'une passe avec des requêtes GL_TIME_ELAPSED.
+// Les requêtes sont utilisées en anneau : le résultat lu est celui d'une image précédente,
+// le CPU n'attend donc jamais le GPU.
+class GpuTimer
+{
+public:
+    GpuTimer();
+    ~GpuTimer();
+
+    void init(); // Création des requêtes (contexte OpenGL requis)
+    void begin(); // Début de la mesure
+    void end(); // Fin de la mesure
+
+    double getElapsedMs() const { return mElapsedMs; } // Temps moyen en millisecondes
+
+private:
+    static const int QUERY_COUNT = 4; // Nombre d'images en vol
+
+    GLuint mQueries[QUERY_COUNT]; // Requêtes de temps
+    bool mIssued[QUERY_COUNT]; // Indique si la requête attend un résultat
+    int mCurrent; // Index de la requête courante
+    bool mRunning; // Mesure en cours
+    double mElapsedMs; // Moyenne glissante du temps écoulé
+};
+
+#endif // GPU_TIMER_HPP
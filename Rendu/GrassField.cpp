@@ -0,0 +1,374 @@
+#include "GrassField.hpp"
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+// Place libre
+static const int64_t NO_TILE = INT64_MIN;
+
+// Nombres tirés par touffe : position x et z, rotation, échelle
+static const uint32_t RANDOMS_PER_BLADE = 4;
+
+// Part de la densité sur laquelle une touffe s'efface avant de disparaître (uniform fadeBand de grass.vert)
+static const float FADE_BAND = 0.1f;
+
+
+// Mélange 64 bits (finaliseur de splitmix64)
+static uint64_t mix64(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Nombre aléatoire n° counter d'une tuile, dans [0, 1[ (générateur à compteur : aucun état)
+static float randomFloat(uint64_t key, uint32_t counter)
+{
+    return (float)(mix64(key + (uint64_t)(counter + 1) * 0x9e3779b97f4a7c15ull) >> 40) / 16777216.0f;
+}
+
+
+GrassField::GrassField() : mTexture(nullptr), mModelScale(1.0f), mBladeHeight(1.0f), mBladeRadius(0.0f), mTileCapacity(0), mDrawnCount(0), mDensityScale(1.0f), mVertexCount(0), mVAO(0), mMeshVBO(0), mInstanceVBO(0)
+{
+}
+
+GrassField::~GrassField()
+{
+    glDeleteVertexArrays(1, &mVAO);
+    glDeleteBuffers(1, &mMeshVBO);
+    glDeleteBuffers(1, &mInstanceVBO);
+}
+
+// Copie du maillage d'une touffe dans un VAO propre (attributs d'instance 3 et 4) et places du buffer :
+// assez pour toutes les tuiles à portée de la caméra, marge de déchargement comprise
+void GrassField::init(const Mesh* mesh, Texture2D* texture, glm::vec3 modelScale, const GrassSettings& settings)
+{
+    mSettings = settings;
+    mTexture = texture;
+    mModelScale = modelScale;
+    mTiles.clear();
+    mDraws.clear();
+    mDrawnCount = 0;
+    if(mesh == nullptr || mesh->getVertexCount() == 0 || texture == nullptr)
+    {
+        mVertexCount = 0;
+        return;
+    }
+
+    const AABB& bounds = mesh->getBounds();
+    glm::vec3 extent = glm::max(glm::abs(bounds.min), glm::abs(bounds.max)) * modelScale;
+    mBladeHeight = glm::max(bounds.max.y, 1e-3f);
+    mBladeRadius = glm::length(glm::vec2(extent.x, extent.z)) * mSettings.maxScale + mSettings.windStrength;
+    mTileCapacity = (size_t)std::ceil(mSettings.density * mSettings.tileSize * mSettings.tileSize);
+    mVertexCount = mesh->getVertexCount();
+
+    int radius = (int)std::ceil((mSettings.drawDistance + 0.5f * mSettings.tileSize) / mSettings.tileSize);
+    size_t slotCount = (size_t)(2 * radius + 2) * (2 * radius + 2);
+    mSlotTiles.assign(slotCount, NO_TILE);
+    mFreeSlots.clear();
+    mSlotBounds.clear();
+    for(size_t s = 0; s < slotCount; s = s + 1)
+    {
+        mFreeSlots.push_back((int)(slotCount - 1 - s));
+        mSlotBounds.push(AABB());
+    }
+
+    if(mVAO == 0)
+    {
+        glGenVertexArrays(1, &mVAO);
+        glGenBuffers(1, &mMeshVBO);
+        glGenBuffers(1, &mInstanceVBO);
+    }
+    glBindVertexArray(mVAO);
+
+    const std::vector<Vertex>& vertices = mesh->getVertices();
+    glBindBuffer(GL_ARRAY_BUFFER, mMeshVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, texCoords));
+    glEnableVertexAttribArray(2);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, slotCount * mTileCapacity * sizeof(GrassInstance), NULL, GL_DYNAMIC_DRAW);
+    bindInstances(0);
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Attributs d'instance sur la touffe first du buffer (GL 3.3 n'a pas de baseInstance, VAO et buffer liés)
+void GrassField::bindInstances(GLuint first)
+{
+    const size_t base = (size_t)first * sizeof(GrassInstance);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(GrassInstance), (GLvoid*)(base + offsetof(GrassInstance, position)));
+    glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(GrassInstance), (GLvoid*)(base + offsetof(GrassInstance, params)));
+}
+
+// Distance horizontale entre la caméra et le point le plus proche de la tuile
+float GrassField::getDistance(int64_t key, glm::vec2 position) const
+{
+    glm::vec2 tileMin = glm::vec2((float)keyX(key), (float)keyZ(key)) * mSettings.tileSize;
+    glm::vec2 d = glm::max(glm::max(tileMin - position, position - tileMin - mSettings.tileSize), glm::vec2(0.0f));
+    return glm::length(d);
+}
+
+// Densité pleine jusqu'à fadeStart, puis linéaire jusqu'à 0 à drawDistance (même formule que grass.vert)
+float GrassField::getDensity(float distance) const
+{
+    return glm::clamp((mSettings.drawDistance - distance) / (mSettings.drawDistance - mSettings.fadeStart), 0.0f, 1.0f);
+}
+
+// Touffes d'une tuile : mTileCapacity tirages uniformes dans la tuile (tout préfixe du tirage est donc
+// uniforme lui aussi), rang = n° du tirage / mTileCapacity. Les touffes sur un obstacle sont retirées sans
+// changer le rang des autres ; hauteurs interpolées dans un bloc d'échantillons du relief (comme Heightfield::getHeight)
+AABB GrassField::buildTile(int64_t key, std::vector<float>& ranks)
+{
+    int tileX = keyX(key);
+    int tileZ = keyZ(key);
+    glm::vec2 tileMin = glm::vec2((float)tileX, (float)tileZ) * mSettings.tileSize;
+    glm::vec2 tileMax = tileMin + mSettings.tileSize;
+    uint64_t tileKey = mix64(((uint64_t)mSettings.seed << 32) ^ mix64(((uint64_t)(uint32_t)tileX << 32) | (uint32_t)tileZ));
+
+    // Échantillons du relief qui couvrent la tuile
+    float spacing = 1.0f;
+    int sampleX = 0;
+    int sampleZ = 0;
+    int samples = 0;
+    if(mSettings.ground != nullptr)
+    {
+        spacing = mSettings.ground->getSettings().spacing;
+        sampleX = (int)std::floor(tileMin.x / spacing);
+        sampleZ = (int)std::floor(tileMin.y / spacing);
+        samples = (int)std::ceil(mSettings.tileSize / spacing) + 2;
+        mHeights.resize((size_t)samples * samples);
+        mSettings.ground->getSamples(sampleX, sampleZ, samples, samples, mHeights.data());
+    }
+
+    // Obstacles qui touchent la tuile
+    std::vector<const AABB*> obstacles;
+    for(const AABB& box : mSettings.obstacles)
+    {
+        if(box.max.x >= tileMin.x && box.min.x <= tileMax.x && box.max.z >= tileMin.y && box.min.z <= tileMax.y)
+        {
+            obstacles.push_back(&box);
+        }
+    }
+
+    mBuild.clear();
+    ranks.clear();
+    AABB bounds;
+    float top = mBladeHeight * mModelScale.y * mSettings.maxScale;
+    for(size_t i = 0; i < mTileCapacity; i = i + 1)
+    {
+        uint32_t counter = (uint32_t)i * RANDOMS_PER_BLADE;
+        glm::vec2 position = tileMin + glm::vec2(randomFloat(tileKey, counter), randomFloat(tileKey, counter + 1)) * mSettings.tileSize;
+
+        bool blocked = false;
+        for(const AABB* box : obstacles)
+        {
+            if(position.x >= box->min.x && position.x <= box->max.x && position.y >= box->min.z && position.y <= box->max.z)
+            {
+                blocked = true;
+                break;
+            }
+        }
+        if(blocked)
+        {
+            continue;
+        }
+
+        float height = 0.0f;
+        if(samples > 0)
+        {
+            float sx = position.x / spacing - (float)sampleX;
+            float sz = position.y / spacing - (float)sampleZ;
+            int ix = glm::clamp((int)sx, 0, samples - 2);
+            int iz = glm::clamp((int)sz, 0, samples - 2);
+            float tx = sx - (float)ix;
+            float tz = sz - (float)iz;
+            const float* row = &mHeights[(size_t)iz * samples + ix];
+            float front = row[0] + (row[1] - row[0]) * tx;
+            float back = row[samples] + (row[samples + 1] - row[samples]) * tx;
+            height = front + (back - front) * tz;
+        }
+
+        float yaw = randomFloat(tileKey, counter + 2) * 6.2831853f;
+        float scale = glm::mix(mSettings.minScale, mSettings.maxScale, randomFloat(tileKey, counter + 3));
+        float rank = (float)i / (float)mTileCapacity;
+        mBuild.push_back({ glm::vec4(position.x, height, position.y, yaw), glm::vec2(scale, rank) });
+        ranks.push_back(rank);
+        bounds.expand(glm::vec3(position.x, height, position.y));
+        bounds.expand(glm::vec3(position.x, height + top, position.y));
+    }
+
+    // Touffes qui dépassent de la tuile (taille du maillage, vent)
+    if(!bounds.isEmpty())
+    {
+        bounds.min = bounds.min - glm::vec3(mBladeRadius, 0.0f, mBladeRadius);
+        bounds.max = bounds.max + glm::vec3(mBladeRadius, 0.0f, mBladeRadius);
+    }
+    return bounds;
+}
+
+// Tuiles sorties de la zone rendues, tuiles entrées générées (les plus proches d'abord, quelques-unes par image),
+// puis lots visibles : préfixe de chaque tuile selon la densité à son point le plus proche, budget réparti sur toutes
+void GrassField::update(const glm::vec3& viewPos, const Frustum& frustum)
+{
+    mDraws.clear();
+    mDrawnCount = 0;
+    if(mVertexCount == 0)
+    {
+        return;
+    }
+
+    glm::vec2 position(viewPos.x, viewPos.z);
+    float unloadDistance = mSettings.drawDistance + 0.5f * mSettings.tileSize;
+
+    std::vector<int64_t> farTiles;
+    for(const auto& entry : mTiles)
+    {
+        if(getDistance(entry.first, position) > unloadDistance)
+        {
+            farTiles.push_back(entry.first);
+        }
+    }
+    for(int64_t key : farTiles)
+    {
+        int slot = mTiles[key].slot;
+        mSlotTiles[slot] = NO_TILE;
+        mSlotBounds.set(slot, AABB());
+        mFreeSlots.push_back(slot);
+        mTiles.erase(key);
+    }
+
+    std::vector<std::pair<float, int64_t>> wanted;
+    int radius = (int)std::ceil(mSettings.drawDistance / mSettings.tileSize);
+    int centerX = (int)std::floor(position.x / mSettings.tileSize);
+    int centerZ = (int)std::floor(position.y / mSettings.tileSize);
+    for(int z = centerZ - radius; z <= centerZ + radius; z = z + 1)
+    {
+        for(int x = centerX - radius; x <= centerX + radius; x = x + 1)
+        {
+            int64_t key = makeKey(x, z);
+            float distance = getDistance(key, position);
+            if(distance <= mSettings.drawDistance && mTiles.count(key) == 0)
+            {
+                wanted.push_back({ distance, key });
+            }
+        }
+    }
+    std::sort(wanted.begin(), wanted.end());
+
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceVBO);
+    for(size_t w = 0; w < wanted.size() && (int)w < mSettings.tilesPerFrame && !mFreeSlots.empty(); w = w + 1)
+    {
+        int64_t key = wanted[w].second;
+        Tile tile;
+        tile.slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+
+        AABB bounds = buildTile(key, tile.ranks);
+        if(!mBuild.empty())
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)(tile.slot * mTileCapacity * sizeof(GrassInstance)), mBuild.size() * sizeof(GrassInstance), mBuild.data());
+        }
+        mSlotBounds.set(tile.slot, bounds);
+        mSlotTiles[tile.slot] = key;
+        mTiles[key] = std::move(tile);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Lots visibles, du plus proche au plus lointain, et touffes voulues par chacun à pleine densité
+    mSlotVisible.assign(mSlotBounds.paddedSize(), 0);
+    frustumCullAABB(mSlotBounds, frustum, mSlotVisible.data());
+
+    std::vector<std::pair<float, int>> visible;
+    size_t demand = 0;
+    for(size_t s = 0; s < mSlotTiles.size(); s = s + 1)
+    {
+        if(!mSlotVisible[s] || mSlotTiles[s] == NO_TILE)
+        {
+            continue;
+        }
+        AABB box = mSlotBounds.get(s);
+        glm::vec3 d = glm::max(glm::max(box.min - viewPos, viewPos - box.max), glm::vec3(0.0f));
+        float density = getDensity(glm::length(d));
+        const std::vector<float>& ranks = mTiles[mSlotTiles[s]].ranks;
+        size_t count = std::upper_bound(ranks.begin(), ranks.end(), density) - ranks.begin();
+        if(count > 0)
+        {
+            visible.push_back({ density, (int)s });
+            demand = demand + count;
+        }
+    }
+    std::sort(visible.begin(), visible.end(), [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
+
+    // Budget dépassé : densité réduite partout dans la même proportion (le shader applique la même réduction),
+    // puis les lots les plus lointains sont tronqués si le compte arrondi dépasse encore
+    mDensityScale = 1.0f;
+    if(demand > mSettings.instanceBudget)
+    {
+        mDensityScale = (float)mSettings.instanceBudget / (float)demand;
+    }
+
+    for(const auto& entry : visible)
+    {
+        int slot = entry.second;
+        const std::vector<float>& ranks = mTiles[mSlotTiles[slot]].ranks;
+        size_t count = std::upper_bound(ranks.begin(), ranks.end(), entry.first * mDensityScale) - ranks.begin();
+        count = std::min(count, mSettings.instanceBudget - mDrawnCount);
+        if(count > 0)
+        {
+            mDraws.push_back({ (GLuint)(slot * mTileCapacity), (GLsizei)count });
+            mDrawnCount = mDrawnCount + count;
+        }
+    }
+}
+
+// Un dessin instancié par lot visible, les touffes de rang supérieur à leur densité s'effacent dans le shader
+void GrassField::draw(ShaderProgram& shader, float time)
+{
+    if(mDraws.empty())
+    {
+        return;
+    }
+
+    shader.use();
+    mTexture->bind(0);
+    shader.setUniform("modelScale", mModelScale);
+    shader.setUniform("bladeHeight", mBladeHeight);
+    shader.setUniform("fadeRange", glm::vec2(mSettings.fadeStart, mSettings.drawDistance));
+    shader.setUniform("densityScale", mDensityScale);
+    shader.setUniform("fadeBand", FADE_BAND);
+    shader.setUniform("time", time);
+    shader.setUniform("windDirection", glm::normalize(mSettings.windDirection));
+    shader.setUniform("windStrength", mSettings.windStrength);
+
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceVBO);
+    for(const Draw& batch : mDraws)
+    {
+        bindInstances(batch.first);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, mVertexCount, batch.count);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+// Touffes des tuiles générées
+size_t GrassField::getResidentCount() const
+{
+    size_t count = 0;
+    for(const auto& entry : mTiles)
+    {
+        count = count + entry.second.ranks.size();
+    }
+    return count;
+}
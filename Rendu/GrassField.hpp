@@ -0,0 +1,110 @@
+#ifndef GRASS_FIELD_HPP
+#define GRASS_FIELD_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Texture2D.hpp"
+#include "Mesh.hpp"
+#include "Bounds.hpp"
+#include "Heightfield.hpp"
+
+#define GLEW_STATIC
+
+// Paramètres du champ d'herbe
+struct GrassSettings
+{
+    uint32_t seed = 1; // Même graine, même herbe
+    float tileSize = 16.0f; // Côté d'une tuile (un lot : une boîte, un dessin)
+    float density = 6.0f; // Touffes par unité carrée à pleine densité
+    float fadeStart = 15.0f; // Pleine densité jusqu'à cette distance
+    float drawDistance = 60.0f; // Densité nulle à cette distance
+    float minScale = 0.6f; // Échelle des touffes (multipliée par celle du modèle)
+    float maxScale = 1.0f;
+    size_t instanceBudget = 24000; // Touffes dessinées par image au plus (densité réduite partout au-delà)
+    int tilesPerFrame = 8; // Tuiles générées et envoyées par image au plus (pas d'à-coups)
+    glm::vec2 windDirection = glm::vec2(1.0f, 0.3f); // Direction du vent (XZ)
+    float windStrength = 0.15f; // Déplacement du haut des touffes
+    const Heightfield* ground = nullptr; // Relief du terrain (nullptr : sol plat en 0)
+    std::vector<AABB> obstacles; // Emprises au sol sans herbe (bâtiments, véhicules...)
+};
+
+// Touffe d'herbe, lue par grass.vert (attributs 3 et 4, un pas par instance)
+struct GrassInstance
+{
+    glm::vec4 position; // Pied de la touffe (xyz), rotation Y en radians
+    glm::vec2 params; // Échelle, rang dans [0, 1[ (les touffes de rang supérieur à la densité disparaissent)
+};
+
+// Herbe dense autour de la caméra : chaque tuile du sol reçoit des touffes tirées au hasard (graine et
+// coordonnées de la tuile : même tuile, mêmes touffes), rangées dans l'ordre du tirage. Ce rang sert de seuil
+// de densité : dessiner les n premières touffes d'une tuile donne une herbe uniformément plus clairsemée.
+// Les tuiles sont éliminées par lots (une boîte par tuile, tests SIMD) et chacune est dessinée en un appel
+// instancié limité au préfixe utile selon sa distance ; le vertex shader fait disparaître une à une les
+// touffes au-delà de leur densité (tramage) et les fait plier au vent. Les tuiles occupent les places
+// d'un buffer unique, générées à l'entrée dans la zone et rendues à la sortie.
+class GrassField
+{
+public:
+    GrassField();
+    ~GrassField();
+
+    void init(const Mesh* mesh, Texture2D* texture, glm::vec3 modelScale, const GrassSettings& settings); // Maillage d'une touffe, buffer des places
+    void update(const glm::vec3& viewPos, const Frustum& frustum); // Générer et rendre les tuiles, lots visibles et nombre de touffes de chacun
+    void draw(ShaderProgram& shader, float time); // Dessiner les lots visibles (view, projection, viewPos et éclairage fixés par l'appelant)
+
+    size_t getTileCount() const { return mTiles.size(); } // Tuiles générées
+    size_t getResidentCount() const; // Touffes des tuiles générées
+    size_t getDrawnTiles() const { return mDraws.size(); } // Lots dessinés dans l'image
+    size_t getDrawnCount() const { return mDrawnCount; } // Touffes dessinées dans l'image (au plus le budget)
+
+private:
+    // Tuile générée
+    struct Tile
+    {
+        int slot; // Place dans le buffer
+        std::vector<float> ranks; // Rang de chaque touffe gardée, croissant
+    };
+
+    // Dessin d'un lot : premières touffes d'une place
+    struct Draw
+    {
+        GLuint first;
+        GLsizei count;
+    };
+
+    static int64_t makeKey(int x, int z) { return ((int64_t)x << 32) | (uint32_t)z; }
+    static int keyX(int64_t key) { return (int)(key >> 32); }
+    static int keyZ(int64_t key) { return (int)(uint32_t)key; }
+
+    float getDistance(int64_t key, glm::vec2 position) const; // Distance horizontale de la caméra à la tuile
+    float getDensity(float distance) const; // Densité relative à une distance, dans [0, 1]
+    AABB buildTile(int64_t key, std::vector<float>& ranks); // Tirer les touffes d'une tuile dans mBuild, boîte englobante
+    void bindInstances(GLuint first); // Pointer les attributs d'instance du VAO sur la touffe first
+
+    GrassSettings mSettings;
+    Texture2D* mTexture;
+    glm::vec3 mModelScale;
+    float mBladeHeight; // Hauteur du maillage (flexion au vent)
+    float mBladeRadius; // Rayon horizontal d'une touffe, vent compris (boîtes des tuiles)
+    size_t mTileCapacity; // Touffes tirées par tuile (taille d'une place)
+
+    std::unordered_map<int64_t, Tile> mTiles; // Tuiles générées
+    std::vector<int64_t> mSlotTiles; // Tuile de chaque place (INT64_MIN : libre)
+    std::vector<int> mFreeSlots;
+    AABBArray mSlotBounds; // Boîte de chaque place (vide si libre), tests SIMD contre la pyramide de vue
+    std::vector<uint8_t> mSlotVisible;
+    std::vector<GrassInstance> mBuild; // Touffes de la tuile en cours de génération
+    std::vector<float> mHeights; // Échantillons du relief sous la tuile
+    std::vector<Draw> mDraws; // Lots de l'image
+    size_t mDrawnCount;
+    float mDensityScale; // Réduction de la densité imposée par le budget (1 : aucune)
+    GLsizei mVertexCount;
+    GLuint mVAO, mMeshVBO, mInstanceVBO;
+};
+
+#endif // GRASS_FIELD_HPP
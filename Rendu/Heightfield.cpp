@@ -0,0 +1,139 @@
+#include "Heightfield.hpp"
+#include <cmath>
+#include <climits>
+
+
+// Valeur aléatoire d'un point de la grille d'une octave, dans [0, 1[ (mélange 32 bits, aucun état)
+static float latticeValue(uint32_t seed, int x, int z, int octave)
+{
+    uint32_t h = seed ^ ((uint32_t)x * 0x8da6b343u) ^ ((uint32_t)z * 0xd8163841u) ^ ((uint32_t)octave * 0xcb1ab31fu);
+    h = (h ^ (h >> 16)) * 0x7feb352du;
+    h = (h ^ (h >> 15)) * 0x846ca68bu;
+    h = h ^ (h >> 16);
+    return (float)(h >> 8) / 16777216.0f;
+}
+
+// Partie entière par défaut (plus rapide que std::floor, appelée pour chaque octave de chaque échantillon)
+static int floorInt(float x)
+{
+    int i = (int)x;
+    return x < (float)i ? i - 1 : i;
+}
+
+
+Heightfield::Heightfield(const HeightfieldSettings& settings) : mSettings(settings)
+{
+    mSettings.octaves = glm::clamp(mSettings.octaves, 1, MAX_OCTAVES);
+
+    float total = 0.0f;
+    float weight = 1.0f;
+    for(int o = 0; o < mSettings.octaves; o = o + 1)
+    {
+        total = total + weight;
+        weight = weight * 0.5f;
+    }
+    mNormalization = 1.0f / total;
+}
+
+// Échantillon : bruit de valeur de chaque octave (points de la grille voisins interpolés avec une courbe douce),
+// somme multipliée par le masque de la zone plate
+float Heightfield::computeSample(int x, int z, LatticeCell* cells) const
+{
+    glm::vec2 position((float)x * mSettings.spacing, (float)z * mSettings.spacing);
+    float mask = glm::smoothstep(mSettings.flatRadius, mSettings.flatRadius + mSettings.blendDistance, glm::length(position - mSettings.center));
+    if(mask <= 0.0f)
+    {
+        return 0.0f; // Zone plate : pas de bruit à calculer
+    }
+
+    float frequency = 1.0f / mSettings.wavelength;
+    float weight = 1.0f;
+    float sum = 0.0f;
+    for(int o = 0; o < mSettings.octaves; o = o + 1)
+    {
+        float px = position.x * frequency;
+        float pz = position.y * frequency;
+        int ix = floorInt(px);
+        int iz = floorInt(pz);
+
+        LatticeCell& cell = cells[o];
+        if(cell.x != ix || cell.z != iz)
+        {
+            cell.x = ix;
+            cell.z = iz;
+            cell.v00 = latticeValue(mSettings.seed, ix, iz, o);
+            cell.v10 = latticeValue(mSettings.seed, ix + 1, iz, o);
+            cell.v01 = latticeValue(mSettings.seed, ix, iz + 1, o);
+            cell.v11 = latticeValue(mSettings.seed, ix + 1, iz + 1, o);
+        }
+
+        float tx = px - (float)ix;
+        float tz = pz - (float)iz;
+        tx = tx * tx * (3.0f - 2.0f * tx);
+        tz = tz * tz * (3.0f - 2.0f * tz);
+        float top = cell.v00 + (cell.v10 - cell.v00) * tx;
+        float bottom = cell.v01 + (cell.v11 - cell.v01) * tx;
+        sum = sum + weight * (top + (bottom - top) * tz);
+
+        frequency = frequency * 2.0f;
+        weight = weight * 0.5f;
+    }
+    return mSettings.amplitude * mask * sum * mNormalization;
+}
+
+// Échantillon seul
+float Heightfield::getSample(int x, int z) const
+{
+    LatticeCell cells[MAX_OCTAVES];
+    for(LatticeCell& cell : cells)
+    {
+        cell.x = INT_MIN;
+    }
+    return computeSample(x, z, cells);
+}
+
+// Bloc d'échantillons (fenêtre de la carte de hauteur du terrain) : les cellules des octaves servent à tout le bloc
+void Heightfield::getSamples(int x, int z, int width, int height, float* out) const
+{
+    LatticeCell cells[MAX_OCTAVES];
+    for(LatticeCell& cell : cells)
+    {
+        cell.x = INT_MIN;
+    }
+
+    for(int j = 0; j < height; j = j + 1)
+    {
+        for(int i = 0; i < width; i = i + 1)
+        {
+            out[(size_t)j * width + i] = computeSample(x + i, z + j, cells);
+        }
+    }
+}
+
+// Hauteur entre les échantillons : interpolation bilinéaire (comme le filtrage de la texture du terrain)
+float Heightfield::getHeight(float x, float z) const
+{
+    float sx = x / mSettings.spacing;
+    float sz = z / mSettings.spacing;
+    int ix = floorInt(sx);
+    int iz = floorInt(sz);
+    float tx = sx - (float)ix;
+    float tz = sz - (float)iz;
+
+    float h[4];
+    getSamples(ix, iz, 2, 2, h);
+    float top = h[0] + (h[1] - h[0]) * tx;
+    float bottom = h[2] + (h[3] - h[2]) * tx;
+    return top + (bottom - top) * tz;
+}
+
+// Normale par différences centrées, un échantillon de part et d'autre
+glm::vec3 Heightfield::getNormal(float x, float z) const
+{
+    float d = mSettings.spacing;
+    float left = getHeight(x - d, z);
+    float right = getHeight(x + d, z);
+    float down = getHeight(x, z - d);
+    float up = getHeight(x, z + d);
+    return glm::normalize(glm::vec3(left - right, 2.0f * d, down - up));
+}
@@ -0,0 +1,56 @@
+#ifndef HEIGHTFIELD_HPP
+#define HEIGHTFIELD_HPP
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Paramètres du relief
+struct HeightfieldSettings
+{
+    uint32_t seed = 1; // Même graine, même relief
+    float spacing = 1.0f; // Distance entre deux échantillons de la carte de hauteur
+    float amplitude = 24.0f; // Hauteur des plus hautes collines
+    float wavelength = 160.0f; // Taille des plus grandes collines
+    int octaves = 5; // Couches de bruit, chacune deux fois plus fine et deux fois moins haute (au plus MAX_OCTAVES)
+    glm::vec2 center = glm::vec2(0.0f); // Centre de la zone plate
+    float flatRadius = 60.0f; // Zone plate autour du centre (village) : hauteur 0
+    float blendDistance = 100.0f; // Distance sur laquelle le relief apparaît au-delà de la zone plate
+};
+
+// Carte de hauteur procédurale sans limite : un échantillon par point d'une grille régulière (bruit de valeur
+// fractal, aplani autour du village), hauteur entre les échantillons par interpolation bilinéaire.
+// Aucun état partagé : les requêtes sont sûres depuis tous les threads. Le terrain affiche exactement
+// ces échantillons, donc la hauteur d'une requête est celle du sol dessiné au niveau de détail le plus fin.
+class Heightfield
+{
+public:
+    static const int MAX_OCTAVES = 8;
+
+    Heightfield(const HeightfieldSettings& settings = HeightfieldSettings());
+
+    float getSample(int x, int z) const; // Échantillon (x, z) de la grille, en (x * spacing, z * spacing)
+    void getSamples(int x, int z, int width, int height, float* out) const; // Bloc d'échantillons, ligne par ligne (z puis x)
+    float getHeight(float x, float z) const; // Hauteur du sol en (x, z)
+    glm::vec3 getNormal(float x, float z) const; // Normale du sol en (x, z)
+
+    float getMinHeight() const { return 0.0f; } // Bornes des hauteurs (boîtes englobantes)
+    float getMaxHeight() const { return mSettings.amplitude; }
+    const HeightfieldSettings& getSettings() const { return mSettings; }
+
+private:
+    // Valeurs des 4 points de la grille d'une octave autour du dernier échantillon calculé : les cellules
+    // des octaves couvrent plusieurs échantillons, les échantillons voisins les réutilisent sans rien recalculer
+    struct LatticeCell
+    {
+        int x;
+        int z;
+        float v00, v10, v01, v11;
+    };
+
+    float computeSample(int x, int z, LatticeCell* cells) const; // Échantillon, cellules des octaves en cache
+
+    HeightfieldSettings mSettings;
+    float mNormalization; // Inverse de la somme des amplitudes des octaves
+};
+
+#endif // HEIGHTFIELD_HPP
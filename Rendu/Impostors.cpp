@@ -0,0 +1,190 @@
+#include "Impostors.hpp"
+#include <iostream>
+#include <cstddef>
+#include <glm/gtc/matrix_transform.hpp>
+
+
+Impostors::Impostors() : mFBO(0), mDepth(0), mAlbedo(0), mNormal(0), mVAO(0), mVBO(0), mLayerCount(0), mCapacity(0)
+{
+}
+
+Impostors::~Impostors()
+{
+    glDeleteFramebuffers(1, &mFBO);
+    glDeleteRenderbuffers(1, &mDepth);
+    glDeleteTextures(1, &mAlbedo);
+    glDeleteTextures(1, &mNormal);
+    glDeleteVertexArrays(1, &mVAO);
+    glDeleteBuffers(1, &mVBO);
+}
+
+// Caméra orthographique d'une image de l'atlas : direction de l'hémi-octaèdre au centre de la case,
+// cadrée sur la sphère englobante (même construction du haut de l'image que les quads)
+glm::mat4 Impostors::frameViewProjection(int x, int y, const glm::vec4& sphere) const
+{
+    glm::vec2 uv = (glm::vec2((float)x, (float)y) + 0.5f) / (float)FRAMES * 2.0f - 1.0f;
+    glm::vec2 p = glm::vec2(uv.x + uv.y, uv.x - uv.y) * 0.5f;
+    glm::vec3 direction = glm::normalize(glm::vec3(p.x, 1.0f - glm::abs(p.x) - glm::abs(p.y), p.y));
+
+    glm::vec3 center = glm::vec3(sphere);
+    float radius = sphere.w;
+    glm::mat4 view = glm::lookAt(center + direction * radius * 2.0f, center, glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, radius, radius * 3.0f);
+    return projection * view;
+}
+
+// Précalculer les atlas : une couche par modèle, FRAMES x FRAMES images
+bool Impostors::bake(ShaderProgram& shader, const std::vector<ImpostorModel>& models, int width, int height)
+{
+    const int size = FRAMES * FRAME_SIZE;
+    int layerCount = (int)models.size();
+    if(layerCount == 0)
+    {
+        return false;
+    }
+
+    // Tableaux de textures (mipmaps limités pour ne pas mélanger les images voisines)
+    GLuint* textures[2] = { &mAlbedo, &mNormal };
+    for(GLuint* texture : textures)
+    {
+        glGenTextures(1, texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, *texture);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size, size, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 3);
+    }
+
+    glGenRenderbuffers(1, &mDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, mDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &mFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, mDepth);
+    GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+
+    shader.use();
+    mSpheres.clear();
+    bool complete = true;
+    for(int layer = 0; layer < layerCount && complete; layer = layer + 1)
+    {
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, mAlbedo, 0, layer);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, mNormal, 0, layer);
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if(status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            std::cerr << "Erreur : framebuffer des imposteurs incomplet (" << status << ")" << std::endl;
+            complete = false;
+            break;
+        }
+
+        glViewport(0, 0, size, size);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        const ImpostorModel& model = models[layer];
+        glm::vec4 sphere = model.mesh->getBoundingSphere();
+        mSpheres.push_back(sphere);
+        if(model.mesh->getVertexCount() == 0 || sphere.w <= 0.0f)
+        {
+            continue; // Modèle absent : couche transparente
+        }
+
+        model.texture->bind(0);
+        model.mesh->bindVertexArray(false);
+        for(int y = 0; y < FRAMES; y = y + 1)
+        {
+            for(int x = 0; x < FRAMES; x = x + 1)
+            {
+                glViewport(x * FRAME_SIZE, y * FRAME_SIZE, FRAME_SIZE, FRAME_SIZE);
+                shader.setUniform("viewProjection", frameViewProjection(x, y, sphere));
+                glDrawArrays(GL_TRIANGLES, 0, model.mesh->getVertexCount());
+            }
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+
+    if(!complete)
+    {
+        return false;
+    }
+
+    for(GLuint* texture : textures)
+    {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, *texture);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Quads instanciés : les coins sont générés dans le shader, seuls les attributs d'instance viennent du VBO
+    glGenVertexArrays(1, &mVAO);
+    glGenBuffers(1, &mVBO);
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(ImpostorInstance), (GLvoid*)offsetof(ImpostorInstance, sphere));
+    glVertexAttribDivisor(0, 1);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ImpostorInstance), (GLvoid*)offsetof(ImpostorInstance, params));
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    mLayerCount = layerCount;
+    return true;
+}
+
+// Envoyer les instances de l'image (réallocation si le VBO est trop petit)
+void Impostors::upload()
+{
+    if(mVBO == 0 || mInstances.empty())
+    {
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    if(mInstances.size() > mCapacity)
+    {
+        mCapacity = mInstances.size() + mInstances.size() / 2;
+        glBufferData(GL_ARRAY_BUFFER, mCapacity * sizeof(ImpostorInstance), NULL, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, mInstances.size() * sizeof(ImpostorInstance), mInstances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Lier les atlas et utiliser le shader (imposteurs et proxys qui lisent les mêmes atlas)
+void Impostors::bindAtlas(ShaderProgram& shader, GLuint firstUnit)
+{
+    glActiveTexture(GL_TEXTURE0 + firstUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mAlbedo);
+    glActiveTexture(GL_TEXTURE0 + firstUnit + 1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mNormal);
+    glActiveTexture(GL_TEXTURE0);
+
+    shader.use();
+    shader.setUniformSampler("impostorAlbedo", firstUnit);
+    shader.setUniformSampler("impostorNormal", firstUnit + 1);
+    shader.setUniform("frames", (GLint)FRAMES);
+}
+
+// Dessiner les instances : un quad de 4 sommets par instance
+void Impostors::draw(ShaderProgram& shader, GLuint firstUnit)
+{
+    if(!isReady() || mInstances.empty())
+    {
+        return;
+    }
+
+    bindAtlas(shader, firstUnit);
+    glBindVertexArray(mVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)mInstances.size());
+    glBindVertexArray(0);
+}
@@ -0,0 +1,65 @@
+#ifndef IMPOSTORS_HPP
+#define IMPOSTORS_HPP
+
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Texture2D.hpp"
+#include "Mesh.hpp"
+
+#define GLEW_STATIC
+
+// Modèle à précalculer en imposteur
+struct ImpostorModel
+{
+    const Mesh* mesh;
+    Texture2D* texture;
+};
+
+// Instance d'imposteur, lue par le vertex shader (attributs 0 et 1, un pas par instance)
+struct ImpostorInstance
+{
+    glm::vec4 sphere; // Centre de la sphère englobante en monde, rayon
+    glm::vec4 params; // Cosinus et sinus de la rotation Y, couche de l'atlas, fondu (0 : maillage, 1 : imposteur)
+};
+
+// Imposteurs octaédriques des objets lointains : chaque modèle est dessiné une fois depuis une grille
+// de directions de l'hémisphère supérieur (hémi-octaèdre) dans un atlas albedo + normale (une couche
+// de tableau de textures par modèle). Les instances lointaines sont ensuite dessinées en quads
+// face à la caméra qui lisent l'image de la direction la plus proche.
+class Impostors
+{
+public:
+    static const int FRAMES = 8; // Directions par côté de l'atlas
+    static const int FRAME_SIZE = 128; // Taille d'une image en pixels
+
+    Impostors();
+    ~Impostors();
+
+    bool bake(ShaderProgram& shader, const std::vector<ImpostorModel>& models, int width, int height); // Précalculer les atlas (une couche par modèle), puis revenir au framebuffer par défaut
+    bool isReady() const { return mLayerCount > 0; } // Atlas précalculés
+    const glm::vec4& getSphere(int layer) const { return mSpheres[layer]; } // Sphère englobante locale d'une couche
+
+    void clear() { mInstances.clear(); } // Commencer une nouvelle liste
+    void push(const ImpostorInstance& instance) { mInstances.push_back(instance); } // Ajouter une instance
+    void upload(); // Envoyer les instances de l'image
+    void bindAtlas(ShaderProgram& shader, GLuint firstUnit); // Lier les atlas à partir de firstUnit et utiliser le shader
+    void draw(ShaderProgram& shader, GLuint firstUnit); // Dessiner les instances (atlas liés à partir de firstUnit)
+
+    size_t getCount() const { return mInstances.size(); } // Instances de l'image
+
+private:
+    glm::mat4 frameViewProjection(int x, int y, const glm::vec4& sphere) const; // Caméra orthographique d'une image de l'atlas
+
+    GLuint mFBO, mDepth; // Framebuffer et profondeur du précalcul
+    GLuint mAlbedo, mNormal; // Tableaux de textures : albedo (alpha : couverture), normale locale
+    GLuint mVAO, mVBO; // Quads instanciés
+    int mLayerCount; // Nombre de modèles précalculés
+    size_t mCapacity; // Instances allouées dans le VBO
+    std::vector<glm::vec4> mSpheres; // Sphère englobante locale de chaque couche
+    std::vector<ImpostorInstance> mInstances; // Instances de l'image
+};
+
+#endif // IMPOSTORS_HPP
@@ -0,0 +1,184 @@
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+#include "InstanceBuffer.hpp"
+
+
+// Constructeur
+InstanceBuffer::InstanceBuffer()
+    : mVBO(0), mCapacity(0), mUploadedCount(0)
+{
+}
+
+// Destructeur
+InstanceBuffer::~InstanceBuffer()
+{
+    glDeleteBuffers(1, &mVBO);
+}
+
+// Créer le buffer
+void InstanceBuffer::init()
+{
+    glGenBuffers(1, &mVBO);
+}
+
+// Nombre d'emplacements (les nouveaux sont envoyés au prochain envoi)
+void InstanceBuffer::resize(size_t count)
+{
+    size_t previous = mInstances.size();
+    if(count < previous)
+    {
+        mDirtyList.erase(std::remove_if(mDirtyList.begin(), mDirtyList.end(), [count](GLuint slot) { return slot >= count; }), mDirtyList.end());
+    }
+    mInstances.resize(count, makeInstance(glm::mat4(1.0f)));
+    mDirty.resize(count, 0);
+    for(size_t slot = previous; slot < count; slot = slot + 1)
+    {
+        markDirty((GLuint)slot);
+    }
+}
+
+// Écrire un emplacement : marqué pour l'envoi seulement si son contenu change
+void InstanceBuffer::set(GLuint slot, const InstanceData& instance)
+{
+    if(std::memcmp(&mInstances[slot], &instance, sizeof(InstanceData)) != 0)
+    {
+        mInstances[slot] = instance;
+        markDirty(slot);
+    }
+}
+
+// Ajouter un emplacement à la liste des envois
+void InstanceBuffer::markDirty(GLuint slot)
+{
+    if(mDirty[slot] == 0)
+    {
+        mDirty[slot] = 1;
+        mDirtyList.push_back(slot);
+    }
+}
+
+// Envoyer les emplacements modifiés depuis le dernier envoi, une commande par plage
+// (les plages séparées par quelques emplacements inchangés sont réunies)
+void InstanceBuffer::upload()
+{
+    const size_t MERGE_GAP = 8;
+
+    mUploadedCount = 0;
+    if(mDirtyList.empty())
+    {
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+
+    // Buffer trop petit : réallocation et envoi complet
+    if(mInstances.size() > mCapacity)
+    {
+        mCapacity = mInstances.size() + mInstances.size() / 2;
+        glBufferData(GL_ARRAY_BUFFER, mCapacity * sizeof(InstanceData), NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, mInstances.size() * sizeof(InstanceData), mInstances.data());
+        mUploadedCount = mInstances.size();
+    }
+    else
+    {
+        std::sort(mDirtyList.begin(), mDirtyList.end());
+        size_t k = 0;
+        while(k < mDirtyList.size())
+        {
+            GLuint first = mDirtyList[k];
+            GLuint last = first;
+            k = k + 1;
+            while(k < mDirtyList.size() && mDirtyList[k] - last <= MERGE_GAP)
+            {
+                last = mDirtyList[k];
+                k = k + 1;
+            }
+
+            glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(InstanceData), (last - first + 1) * sizeof(InstanceData), &mInstances[first]);
+            mUploadedCount = mUploadedCount + (last - first + 1);
+        }
+    }
+
+    for(GLuint slot : mDirtyList)
+    {
+        mDirty[slot] = 0;
+    }
+    mDirtyList.clear();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Pointer les attributs d'instance du VAO lié sur l'instance first
+void InstanceBuffer::bindAttributes(GLuint first) const
+{
+    bindAttributes(mVBO, first);
+}
+
+// Pointer les attributs d'instance du VAO lié sur l'instance first d'un buffer de InstanceData
+// (GL 3.3 n'a pas de baseInstance : le décalage est porté par les pointeurs d'attributs)
+void InstanceBuffer::bindAttributes(GLuint vbo, GLuint first)
+{
+    const GLsizei stride = sizeof(InstanceData);
+    const size_t base = (size_t)first * sizeof(InstanceData);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    // Matrice de modèle : 4 colonnes
+    for(GLuint c = 0; c < 4; c = c + 1)
+    {
+        glVertexAttribPointer(3 + c, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(base + offsetof(InstanceData, model) + c * sizeof(glm::vec4)));
+        glVertexAttribDivisor(3 + c, 1);
+        glEnableVertexAttribArray(3 + c);
+    }
+
+    // Matrice des normales : 3 colonnes
+    for(GLuint c = 0; c < 3; c = c + 1)
+    {
+        glVertexAttribPointer(7 + c, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(base + offsetof(InstanceData, normalMatrix) + c * sizeof(glm::vec4)));
+        glVertexAttribDivisor(7 + c, 1);
+        glEnableVertexAttribArray(7 + c);
+    }
+
+    // Masque des lumières et éclairage précalculé : entiers
+    glVertexAttribIPointer(10, 1, GL_UNSIGNED_INT, stride, (GLvoid*)(base + offsetof(InstanceData, lightMask)));
+    glVertexAttribDivisor(10, 1);
+    glEnableVertexAttribArray(10);
+
+    glVertexAttribIPointer(11, 1, GL_INT, stride, (GLvoid*)(base + offsetof(InstanceData, bakeOffset)));
+    glVertexAttribDivisor(11, 1);
+    glEnableVertexAttribArray(11);
+
+    // Fondu vers l'imposteur
+    glVertexAttribPointer(12, 1, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(base + offsetof(InstanceData, lodFade)));
+    glVertexAttribDivisor(12, 1);
+    glEnableVertexAttribArray(12);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Instance avec sa matrice des normales (calculée une fois au lieu d'une fois par sommet)
+InstanceData InstanceBuffer::makeInstance(const glm::mat4& model)
+{
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+    glm::vec4 columns[3];
+    for(int c = 0; c < 3; c = c + 1)
+    {
+        columns[c] = glm::vec4(normalMatrix[c], 0.0f);
+    }
+    return makeInstance(model, columns);
+}
+
+// Instance avec une matrice des normales déjà calculée (colonnes vec4)
+InstanceData InstanceBuffer::makeInstance(const glm::mat4& model, const glm::vec4 normalMatrix[3])
+{
+    InstanceData instance{};
+
+    instance.model = model;
+    for(int c = 0; c < 3; c = c + 1)
+    {
+        instance.normalMatrix[c] = normalMatrix[c];
+    }
+    instance.bakeOffset = -1;
+    return instance;
+}
@@ -0,0 +1,56 @@
+#ifndef INSTANCE_BUFFER_HPP
+#define INSTANCE_BUFFER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#define GLEW_STATIC
+
+// Données d'une instance, lues par le vertex shader (attributs 3 à 12, un pas par instance)
+struct InstanceData
+{
+    glm::mat4 model; // Matrice de modèle (attributs 3 à 6)
+    glm::vec4 normalMatrix[3]; // Matrice des normales précalculée, colonnes (attributs 7 à 9)
+    uint32_t lightMask; // Lumières ponctuelles qui touchent l'instance (attribut 10)
+    int32_t bakeOffset; // Premier texel d'éclairage précalculé, -1 sinon (attribut 11)
+    float lodFade; // Fondu vers l'imposteur, 0 : maillage seul (attribut 12)
+    uint32_t padding; // Alignement sur 16 octets
+};
+
+// Buffer d'instances de la scène. Chaque objet y a un emplacement fixe : un emplacement n'est
+// renvoyé au GPU que si son contenu a changé (liste des emplacements modifiés depuis le dernier envoi).
+// Les dessins lisent des plages d'emplacements consécutifs.
+class InstanceBuffer
+{
+public:
+    InstanceBuffer();
+    ~InstanceBuffer();
+
+    void init(); // Créer le buffer
+    void resize(size_t count); // Nombre d'emplacements (les nouveaux sont envoyés au prochain envoi)
+    void set(GLuint slot, const InstanceData& instance); // Écrire un emplacement (marqué seulement s'il change)
+    const InstanceData& get(GLuint slot) const { return mInstances[slot]; } // Contenu d'un emplacement
+    size_t size() const { return mInstances.size(); } // Nombre d'emplacements
+    void upload(); // Envoyer les emplacements modifiés depuis le dernier envoi
+    void bindAttributes(GLuint first) const; // Pointer les attributs d'instance du VAO lié sur l'instance first
+    static void bindAttributes(GLuint vbo, GLuint first); // Même chose pour un autre buffer d'instances (disposition InstanceData)
+
+    size_t getUploadedCount() const { return mUploadedCount; } // Instances envoyées lors du dernier envoi
+
+    static InstanceData makeInstance(const glm::mat4& model); // Instance avec sa matrice des normales
+    static InstanceData makeInstance(const glm::mat4& model, const glm::vec4 normalMatrix[3]); // Instance avec une matrice des normales déjà calculée
+
+private:
+    void markDirty(GLuint slot); // Ajouter un emplacement à la liste des envois
+
+    std::vector<InstanceData> mInstances; // Contenu de chaque emplacement
+    std::vector<uint8_t> mDirty; // Emplacement à renvoyer
+    std::vector<GLuint> mDirtyList; // Emplacements marqués depuis le dernier envoi
+    GLuint mVBO; // Buffer d'instances
+    size_t mCapacity; // Nombre d'instances allouées
+    size_t mUploadedCount; // Instances envoyées lors du dernier envoi
+};
+
+#endif // INSTANCE_BUFFER_HPP
@@ -0,0 +1,88 @@
+#include "JobSystem.hpp"
+
+
+// Arrêter les threads
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQuit = true;
+    }
+    mStart.notify_all();
+
+    for(std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+void JobSystem::init(int threadCount)
+{
+    for(int t = 1; t < threadCount; t = t + 1)
+    {
+        mThreads.emplace_back(&JobSystem::workerLoop, this);
+    }
+}
+
+// Une seule tâche ou aucun thread : tout sur le thread appelant, sans synchronisation
+void JobSystem::run(size_t count, const std::function<void(size_t)>& job)
+{
+    if(mThreads.empty() || count <= 1)
+    {
+        for(size_t i = 0; i < count; i = i + 1)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = &job;
+        mCount = count;
+        mNext = 0;
+        mPending = (int)mThreads.size();
+        mGeneration = mGeneration + 1;
+    }
+    mStart.notify_all();
+
+    work();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this]() { return mPending == 0; });
+    mJob = nullptr;
+}
+
+void JobSystem::work()
+{
+    for(size_t i = mNext++; i < mCount; i = mNext++)
+    {
+        (*mJob)(i);
+    }
+}
+
+// Boucle d'un thread : attendre une nouvelle génération, prendre des indices
+void JobSystem::workerLoop()
+{
+    int generation = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStart.wait(lock, [&]() { return mQuit || mGeneration != generation; });
+            if(mQuit)
+            {
+                return;
+            }
+            generation = mGeneration;
+        }
+
+        work();
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPending = mPending - 1;
+        }
+        mDone.notify_one();
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Threads permanents pour les calculs de chaque image : run(count, job) appelle job(0) ... job(count - 1)
+// sur tous les threads (un compteur partagé distribue les indices, le thread appelant travaille aussi)
+// et rend la main quand tous les appels sont terminés. Pas de création de thread par image.
+class JobSystem
+{
+public:
+    JobSystem() = default;
+    ~JobSystem();
+
+    void init(int threadCount); // Nombre de threads, thread appelant compris (threadCount - 1 threads créés)
+    void run(size_t count, const std::function<void(size_t)>& job); // Exécuter job pour chaque indice et attendre la fin
+
+    int getThreadCount() const { return (int)mThreads.size() + 1; }
+
+private:
+    void work(); // Prendre des indices jusqu'à épuisement
+    void workerLoop(); // Boucle d'un thread
+
+    // Chaque thread attend une nouvelle génération, prend des indices et signale la fin
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mStart, mDone;
+    const std::function<void(size_t)>* mJob = nullptr;
+    size_t mCount = 0;
+    std::atomic<size_t> mNext{ 0 };
+    int mGeneration = 0;
+    int mPending = 0;
+    bool mQuit = false;
+};
+
+#endif // JOB_SYSTEM_HPP
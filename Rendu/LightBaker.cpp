@@ -0,0 +1,373 @@
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "LightBaker.hpp"
+
+
+// Constructeur
+LightBaker::LightBaker()
+    : mBuffer(0), mTexture(0)
+{
+}
+
+// Destructeur
+LightBaker::~LightBaker()
+{
+    glDeleteTextures(1, &mTexture);
+    glDeleteBuffers(1, &mBuffer);
+}
+
+// Charger le précalcul depuis le fichier s'il correspond à la scène, sinon le calculer et l'enregistrer
+bool LightBaker::bakeOrLoad(const std::vector<BakeObject>& objects, const std::vector<BakeLight>& lights, glm::vec3 sunDirection, const std::string& filename)
+{
+    uint64_t hash = computeHash(objects, lights, sunDirection);
+
+    if(!load(filename, hash))
+    {
+        auto start = std::chrono::steady_clock::now();
+        bake(objects, lights, sunDirection);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Eclairage precalcule : " << mTexels.size() << " sommets, " << mBvh.getTriangleCount() << " triangles en "
+                  << seconds << " s" << std::endl;
+
+        if(!save(filename, hash))
+        {
+            std::cerr << "Impossible d'enregistrer l'eclairage precalcule dans '" << filename << "'" << std::endl;
+        }
+    }
+
+    if(mTexels.empty())
+    {
+        return false;
+    }
+
+    upload();
+    return isReady();
+}
+
+// Lier la texture buffer
+void LightBaker::bind(GLuint unit)
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, mTexture);
+}
+
+// Calcul complet : BVH de la scène puis sommets de chaque objet sur tous les coeurs
+void LightBaker::bake(const std::vector<BakeObject>& objects, const std::vector<BakeLight>& lights, glm::vec3 sunDirection)
+{
+    // Triangles de la scène en espace monde et premier texel de chaque objet
+    std::vector<glm::vec3> triangles;
+    mOffsets.resize(objects.size());
+    size_t texelCount = 0;
+
+    for(size_t i = 0; i < objects.size(); i = i + 1)
+    {
+        mOffsets[i] = (int)texelCount;
+        if(objects[i].mesh == nullptr)
+        {
+            mOffsets[i] = -1;
+            continue;
+        }
+
+        const std::vector<Vertex>& vertices = objects[i].mesh->getVertices();
+        for(size_t v = 0; v < vertices.size() && objects[i].castShadow; v = v + 1)
+        {
+            triangles.push_back(glm::vec3(objects[i].model * glm::vec4(vertices[v].position, 1.0f)));
+        }
+        texelCount = texelCount + vertices.size();
+    }
+
+    mBvh.build(triangles);
+    mTexels.assign(texelCount, 0xFFFFFFFFu);
+
+    // Répartition des objets entre les threads (un compteur partagé équilibre la charge)
+    std::atomic<size_t> nextObject(0);
+    unsigned int threadCount = glm::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+
+    for(unsigned int t = 0; t < threadCount; t = t + 1)
+    {
+        threads.emplace_back([&]()
+        {
+            for(size_t i = nextObject++; i < objects.size(); i = nextObject++)
+            {
+                if(mOffsets[i] >= 0)
+                {
+                    bakeObject(objects[i], lights, sunDirection, (size_t)mOffsets[i]);
+                }
+            }
+        });
+    }
+
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+// Hachage entier (graine déterministe par sommet : le résultat ne dépend pas du nombre de threads)
+static uint32_t hashInteger(uint32_t x)
+{
+    x = (x ^ 61u) ^ (x >> 16);
+    x = x * 9u;
+    x = x ^ (x >> 4);
+    x = x * 0x27d4eb2du;
+    x = x ^ (x >> 15);
+    return x;
+}
+
+// Nombre aléatoire dans [0, 1[ à partir d'une graine
+static float randomFloat(uint32_t& seed)
+{
+    seed = hashInteger(seed);
+    return (float)(seed >> 8) / 16777216.0f;
+}
+
+// Écrire un rayon dans une voie d'un paquet
+static void setRay(RayPacket& packet, int lane, const glm::vec3& origin, const glm::vec3& direction, float tMax)
+{
+    packet.ox[lane] = origin.x; packet.oy[lane] = origin.y; packet.oz[lane] = origin.z;
+    packet.dx[lane] = direction.x; packet.dy[lane] = direction.y; packet.dz[lane] = direction.z;
+    packet.tMax[lane] = tMax;
+}
+
+// Calcul des sommets d'un objet
+void LightBaker::bakeObject(const BakeObject& object, const std::vector<BakeLight>& lights, glm::vec3 sunDirection, size_t firstTexel)
+{
+    const std::vector<Vertex>& vertices = object.mesh->getVertices();
+    glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(object.model)));
+    glm::vec3 toSun = glm::normalize(-sunDirection);
+
+    // Repère autour de la direction du soleil pour les rayons du cône
+    glm::vec3 sunTangent = glm::normalize(glm::cross(glm::abs(toSun.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f), toSun));
+    glm::vec3 sunBitangent = glm::cross(toSun, sunTangent);
+
+    for(size_t v = 0; v < vertices.size(); v = v + 1)
+    {
+        glm::vec3 position = glm::vec3(object.model * glm::vec4(vertices[v].position, 1.0f));
+        glm::vec3 normal = normalMatrix * vertices[v].normal;
+        if(glm::dot(normal, normal) < 1e-12f)
+        {
+            continue; // Normale dégénérée : texel neutre
+        }
+        normal = glm::normalize(normal);
+
+        glm::vec3 origin = position + normal * RAY_OFFSET;
+        uint32_t seed = hashInteger((uint32_t)(firstTexel + v));
+        RayPacket packet;
+
+        // Occlusion ambiante : rayons répartis en cosinus sur l'hémisphère, grille 4x4 décalée
+        glm::vec3 tangent = glm::normalize(glm::cross(glm::abs(normal.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f), normal));
+        glm::vec3 bitangent = glm::cross(normal, tangent);
+        int occludedRays = 0;
+
+        for(int k = 0; k < AO_RAYS; k = k + 4)
+        {
+            for(int lane = 0; lane < 4; lane = lane + 1)
+            {
+                int sample = k + lane;
+                float u = ((sample % 4) + randomFloat(seed)) / 4.0f;
+                float w = ((sample / 4 % 4) + randomFloat(seed)) / 4.0f;
+                float r = std::sqrt(u);
+                float phi = 6.2831853f * w;
+                glm::vec3 direction = tangent * (r * std::cos(phi)) + bitangent * (r * std::sin(phi)) + normal * std::sqrt(glm::max(0.0f, 1.0f - u));
+                setRay(packet, lane, origin, direction, AO_DISTANCE);
+            }
+
+            int hits = mBvh.occluded(packet, 0xF);
+            occludedRays = occludedRays + ((hits & 1) + ((hits >> 1) & 1) + ((hits >> 2) & 1) + ((hits >> 3) & 1));
+        }
+        float ambientOcclusion = 1.0f - (float)occludedRays / (float)AO_RAYS;
+
+        // Visibilité du soleil : 4 rayons dans le cône du soleil (faces à contre-jour : 0)
+        float sunVisibility = 0.0f;
+        if(glm::dot(normal, toSun) > 0.0f)
+        {
+            for(int lane = 0; lane < 4; lane = lane + 1)
+            {
+                float r = SUN_CONE * std::sqrt(randomFloat(seed));
+                float phi = 6.2831853f * randomFloat(seed);
+                glm::vec3 direction = glm::normalize(toSun + sunTangent * (r * std::cos(phi)) + sunBitangent * (r * std::sin(phi)));
+                setRay(packet, lane, origin, direction, 1e4f);
+            }
+
+            int hits = mBvh.occluded(packet, 0xF);
+            sunVisibility = 1.0f - (float)((hits & 1) + ((hits >> 1) & 1) + ((hits >> 2) & 1) + ((hits >> 3) & 1)) / 4.0f;
+        }
+
+        // Lampes statiques : un rayon d'ombre par lampe, 4 lampes par paquet
+        float lampIrradiance = 0.0f;
+        for(size_t first = 0; first < lights.size(); first = first + 4)
+        {
+            float contribution[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            int activeMask = 0;
+
+            for(int lane = 0; lane < 4 && first + lane < lights.size(); lane = lane + 1)
+            {
+                const BakeLight& light = lights[first + lane];
+                glm::vec3 toLight = light.position - origin;
+                float d = glm::length(toLight);
+                if(d <= 1e-4f || d > light.radius)
+                {
+                    continue;
+                }
+
+                glm::vec3 direction = toLight / d;
+                float NdotL = glm::dot(normal, direction);
+                if(NdotL <= 0.0f)
+                {
+                    continue;
+                }
+
+                contribution[lane] = light.diffuse * NdotL / (light.constant + light.linear * d + light.exponent * (d * d));
+                setRay(packet, lane, origin, direction, d);
+                activeMask |= 1 << lane;
+            }
+
+            if(activeMask == 0)
+            {
+                continue;
+            }
+
+            int visible = activeMask & ~mBvh.occluded(packet, activeMask);
+            for(int lane = 0; lane < 4; lane = lane + 1)
+            {
+                if(visible & (1 << lane))
+                {
+                    lampIrradiance = lampIrradiance + contribution[lane];
+                }
+            }
+        }
+
+        // Texel RGBA8 : R soleil, G lampes / 2, A occlusion ambiante
+        uint32_t red = (uint32_t)(glm::clamp(sunVisibility, 0.0f, 1.0f) * 255.0f + 0.5f);
+        uint32_t green = (uint32_t)(glm::clamp(lampIrradiance * 0.5f, 0.0f, 1.0f) * 255.0f + 0.5f);
+        uint32_t alpha = (uint32_t)(glm::clamp(ambientOcclusion, 0.0f, 1.0f) * 255.0f + 0.5f);
+        mTexels[firstTexel + v] = red | (green << 8) | (alpha << 24);
+    }
+}
+
+// Signature de la scène (FNV-1a) : sommets, placement des objets, lumières et soleil
+uint64_t LightBaker::computeHash(const std::vector<BakeObject>& objects, const std::vector<BakeLight>& lights, glm::vec3 sunDirection) const
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size)
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for(size_t i = 0; i < size; i = i + 1)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    uint32_t version = BAKE_VERSION;
+    mix(&version, sizeof(version));
+
+    for(const BakeObject& object : objects)
+    {
+        uint64_t vertexCount = (object.mesh != nullptr) ? object.mesh->getVertices().size() : 0;
+        mix(&vertexCount, sizeof(vertexCount));
+        mix(&object.castShadow, sizeof(bool));
+        mix(&object.model[0][0], sizeof(float) * 16);
+    }
+
+    for(const BakeLight& light : lights)
+    {
+        mix(&light, sizeof(BakeLight));
+    }
+
+    mix(&sunDirection[0], sizeof(float) * 3);
+    return hash;
+}
+
+// Enregistrer le résultat : en-tête, premiers texels des objets puis texels
+bool LightBaker::save(const std::string& filename, uint64_t hash) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if(!file)
+    {
+        return false;
+    }
+
+    uint32_t version = BAKE_VERSION;
+    uint64_t objectCount = mOffsets.size();
+    uint64_t texelCount = mTexels.size();
+
+    file.write("BAKE", 4);
+    file.write((const char*)&version, sizeof(version));
+    file.write((const char*)&hash, sizeof(hash));
+    file.write((const char*)&objectCount, sizeof(objectCount));
+    file.write((const char*)&texelCount, sizeof(texelCount));
+    file.write((const char*)mOffsets.data(), mOffsets.size() * sizeof(int));
+    file.write((const char*)mTexels.data(), mTexels.size() * sizeof(uint32_t));
+
+    return (bool)file;
+}
+
+// Lire le résultat (refusé si la scène a changé depuis le précalcul)
+bool LightBaker::load(const std::string& filename, uint64_t hash)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if(!file)
+    {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t fileHash = 0, objectCount = 0, texelCount = 0;
+
+    file.read(magic, 4);
+    file.read((char*)&version, sizeof(version));
+    file.read((char*)&fileHash, sizeof(fileHash));
+    file.read((char*)&objectCount, sizeof(objectCount));
+    file.read((char*)&texelCount, sizeof(texelCount));
+
+    if(!file || std::string(magic, 4) != "BAKE" || version != BAKE_VERSION || fileHash != hash)
+    {
+        return false;
+    }
+
+    mOffsets.resize((size_t)objectCount);
+    mTexels.resize((size_t)texelCount);
+    file.read((char*)mOffsets.data(), mOffsets.size() * sizeof(int));
+    file.read((char*)mTexels.data(), mTexels.size() * sizeof(uint32_t));
+
+    if(!file)
+    {
+        mOffsets.clear();
+        mTexels.clear();
+        return false;
+    }
+
+    return true;
+}
+
+// Envoyer les texels au GPU dans une texture buffer (lue par gl_VertexID dans le shader)
+void LightBaker::upload()
+{
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    if((size_t)maxTexels < mTexels.size())
+    {
+        std::cerr << "Eclairage precalcule trop grand pour une texture buffer (" << mTexels.size() << " > " << maxTexels << ")" << std::endl;
+        return;
+    }
+
+    glGenBuffers(1, &mBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, mBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, mTexels.size() * sizeof(uint32_t), mTexels.data(), GL_STATIC_DRAW);
+
+    glGenTextures(1, &mTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, mTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8, mBuffer);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
@@ -0,0 +1,70 @@
+#ifndef LIGHT_BAKER_HPP
+#define LIGHT_BAKER_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "Mesh.hpp"
+#include "Bvh.hpp"
+
+#define GLEW_STATIC
+
+// Objet statique à précalculer
+struct BakeObject
+{
+    const Mesh* mesh; // Géométrie
+    glm::mat4 model; // Matrice de modèle
+    bool castShadow; // L'objet occulte les autres (présent dans la BVH)
+};
+
+// Lumière ponctuelle statique à précalculer
+struct BakeLight
+{
+    glm::vec3 position; // Position
+    float diffuse; // Intensité diffuse (lumière blanche)
+    float constant, linear, exponent; // Atténuation
+    float radius; // Rayon d'influence
+};
+
+// Précalcul de l'éclairage statique par sommet : occlusion ambiante, visibilité du soleil
+// et éclairement des lampes. Les rayons sont lancés par paquets de 4 (SIMD) dans une BVH
+// de toute la scène statique, sur tous les coeurs. Le résultat est mis en cache dans un fichier
+// et lu par le shader depuis une texture buffer (un texel RGBA8 par sommet) :
+//  R : visibilité du soleil, G : éclairement des lampes / 2, A : occlusion ambiante
+class LightBaker
+{
+public:
+    LightBaker();
+    ~LightBaker();
+
+    // Charger le précalcul depuis le fichier s'il correspond à la scène, sinon le calculer et l'enregistrer
+    bool bakeOrLoad(const std::vector<BakeObject>& objects, const std::vector<BakeLight>& lights, glm::vec3 sunDirection, const std::string& filename);
+
+    void bind(GLuint unit); // Lier la texture buffer
+    int getOffset(size_t objectIndex) const { return mOffsets[objectIndex]; } // Premier texel d'un objet
+    bool isReady() const { return mTexture != 0; } // Précalcul disponible
+
+private:
+    void bake(const std::vector<BakeObject>& objects, const std::vector<BakeLight>& lights, glm::vec3 sunDirection); // Calcul complet
+    void bakeObject(const BakeObject& object, const std::vector<BakeLight>& lights, glm::vec3 sunDirection, size_t firstTexel); // Calcul des sommets d'un objet
+    uint64_t computeHash(const std::vector<BakeObject>& objects, const std::vector<BakeLight>& lights, glm::vec3 sunDirection) const; // Signature de la scène
+    bool save(const std::string& filename, uint64_t hash) const; // Enregistrer le résultat
+    bool load(const std::string& filename, uint64_t hash); // Lire le résultat
+    void upload(); // Envoyer les texels au GPU
+
+    Bvh mBvh; // Scène statique en espace monde
+    std::vector<uint32_t> mTexels; // Un texel RGBA8 par sommet
+    std::vector<int> mOffsets; // Premier texel de chaque objet
+    GLuint mBuffer, mTexture; // Buffer et texture buffer
+
+    static const uint32_t BAKE_VERSION = 1; // Version du format de fichier
+    const int AO_RAYS = 16; // Rayons d'occlusion ambiante par sommet (multiple de 4)
+    const float AO_DISTANCE = 3.0f; // Portée de l'occlusion ambiante
+    const float SUN_CONE = 0.02f; // Demi-angle du soleil (ombres douces)
+    const float RAY_OFFSET = 0.02f; // Décalage de l'origine le long de la normale
+};
+
+#endif // LIGHT_BAKER_HPP
@@ -6,7 +6,7 @@ Lights::Lights(Camera& camera, Display& display) : fpsCamera(camera), display(di
 // Fonction pour la lampe torche
 void Lights::spotlightShaders(ShaderProgram& lightingShader, glm::vec3 spotlightPos)
 {
-    lightingShader.setUniform("spotLight.ambient", glm::vec3(0.2f, 0.2f, 0.2f));
+    setAmbientLight(lightingShader);
     lightingShader.setUniform("spotLight.diffuse", glm::vec3(0.5f, 0.5f, 0.5f));
     lightingShader.setUniform("spotLight.specular", glm::vec3(2.0f, 2.0f, 2.0f));
     lightingShader.setUniform("spotLight.position", spotlightPos);
@@ -19,6 +19,12 @@ void Lights::spotlightShaders(ShaderProgram& lightingShader, glm::vec3 spotlight
     lightingShader.setUniform("spotLight.on", display.gFlashlightOn);
 }
 
+// Lumière ambiante seule (portée par la lampe torche dans les shaders)
+void Lights::setAmbientLight(ShaderProgram& shader)
+{
+    shader.setUniform("spotLight.ambient", glm::vec3(0.2f, 0.2f, 0.2f));
+}
+
 // Fonction pour les points de lumière
 void Lights::setPointLight(ShaderProgram& shader, int index, glm::vec3 ambient, glm::vec3 diffuse, glm::vec3 specular, glm::vec3 position, float constant, float linear, float exponent) 
 {
@@ -31,6 +37,17 @@ void Lights::setPointLight(ShaderProgram& shader, int index, glm::vec3 ambient,
     shader.setUniform((base + "constant").c_str(), constant);
     shader.setUniform((base + "linear").c_str(), linear);
     shader.setUniform((base + "exponent").c_str(), exponent);
+
+    // Rayon d'influence, utilisé pour le tri des lumières par objet
+    float radius = computeLightRadius(diffuse, constant, linear, exponent);
+    shader.setUniform((base + "radius").c_str(), radius);
+
+    if ((int)mPointLights.size() <= index)
+    {
+        mPointLights.resize(index + 1);
+    }
+    mPointLights[index].position = position;
+    mPointLights[index].radius = radius;
 }
 
 // Fonction pour la lumière du soleil
@@ -50,3 +67,65 @@ void Lights::setDirectionalLight(ShaderProgram& shader, int index, glm::vec3 dir
     shader.setUniform((base + "specular").c_str(), specular);
 }
 
+
+
+// Rayon d'influence d'une lumière ponctuelle : distance à laquelle l'atténuation
+// ramène la composante diffuse la plus forte sous le seuil LIGHT_CUTOFF.
+// On résout exponent * d² + linear * d + constant = maxDiffuse / LIGHT_CUTOFF
+float Lights::computeLightRadius(glm::vec3 diffuse, float constant, float linear, float exponent)
+{
+    float maxDiffuse = glm::max(glm::max(diffuse.r, diffuse.g), diffuse.b);
+    float c = constant - maxDiffuse / LIGHT_CUTOFF;
+
+    if (c >= 0.0f)
+    {
+        return 0.0f; // Lumière trop faible, elle n'éclaire rien
+    }
+
+    if (exponent > 0.0f)
+    {
+        return (-linear + sqrtf(linear * linear - 4.0f * exponent * c)) / (2.0f * exponent);
+    }
+
+    if (linear > 0.0f)
+    {
+        return -c / linear;
+    }
+
+    return FLT_MAX; // Pas d'atténuation
+}
+
+// Masque des lumières ponctuelles qui touchent chaque boîte (bit i : lumière i)
+void Lights::cullLights(const AABBArray& bounds, std::vector<uint32_t>& masks) const
+{
+    masks.assign(bounds.paddedSize(), 0);
+
+    for (size_t i = 0; i < mPointLights.size() && i < 32; i++)
+    {
+        if (mPointLights[i].radius > 0.0f)
+        {
+            sphereAABBMask(bounds, mPointLights[i].position, mPointLights[i].radius, 1u << i, masks.data());
+        }
+    }
+}
+
+// Masque des lumières ponctuelles qui touchent chaque objet : seuls les objets trouvés par l'index sont testés
+void Lights::cullLights(const SpatialIndex& index, size_t objectCount, std::vector<uint32_t>& masks) const
+{
+    masks.assign(objectCount, 0);
+
+    std::vector<uint32_t> touched;
+    for (size_t i = 0; i < mPointLights.size() && i < 32; i++)
+    {
+        if (mPointLights[i].radius > 0.0f)
+        {
+            touched.clear();
+            index.querySphere(mPointLights[i].position, mPointLights[i].radius, touched);
+            for (uint32_t id : touched)
+            {
+                masks[id] = masks[id] | (1u << i);
+            }
+        }
+    }
+}
+
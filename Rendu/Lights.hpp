@@ -4,10 +4,21 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 #include "ShaderProgram.hpp"
 #include "Camera.hpp"
 #include "Display.hpp"
+#include "Bounds.hpp"
+#include "SpatialIndex.hpp"
+
+// Lumière ponctuelle côté CPU, pour le tri des lumières par objet
+struct PointLightInfo
+{
+    glm::vec3 position; // Position
+    float radius; // Rayon d'influence déduit de l'atténuation
+};
 
 class Lights 
 {
@@ -15,13 +26,22 @@ public:
     Lights(Camera& camera, Display& display);
 
     void spotlightShaders(ShaderProgram& lightingShader, glm::vec3 spotlightPos);
+    void setAmbientLight(ShaderProgram& shader); // Lumière ambiante seule (portée par la lampe torche dans les shaders)
     void setPointLight(ShaderProgram& shader, int index, glm::vec3 ambient, glm::vec3 diffuse, glm::vec3 specular, glm::vec3 position, float constant, float linear, float exponent);
     void setSunLight(ShaderProgram& shader, glm::vec3 direction, glm::vec3 diffuse, glm::vec3 specular);
     void setDirectionalLight(ShaderProgram& shader, int index, glm::vec3 direction, glm::vec3 diffuse, glm::vec3 specular); 
 
+    static float computeLightRadius(glm::vec3 diffuse, float constant, float linear, float exponent); // Rayon d'influence d'une lumière ponctuelle
+    void cullLights(const AABBArray& bounds, std::vector<uint32_t>& masks) const; // Masque des lumières ponctuelles qui touchent chaque boîte
+    void cullLights(const SpatialIndex& index, size_t objectCount, std::vector<uint32_t>& masks) const; // Même masque, objets trouvés par l'index spatial
+
 private:
     Camera& fpsCamera;
     Display& display;
+
+    std::vector<PointLightInfo> mPointLights; // Lumières ponctuelles, par index
+
+    static constexpr float LIGHT_CUTOFF = 5.0f / 256.0f; // Intensité en dessous de laquelle une lumière est ignorée
 };
 
 #endif // LIGHTS_HPP
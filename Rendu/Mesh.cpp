@@ -25,6 +25,8 @@ std::vector<std::string> split(std::string s, std::string t)
 Mesh::Mesh()
 {
     mLoaded = false;
+    mVBO = mVAO = 0;
+    mPositionVBO = mDepthVAO = 0;
 }
 
 // Destructeur de la classe Mesh, libérant les ressources allouées par OpenGL
@@ -32,6 +34,8 @@ Mesh::~Mesh()
 {
     glDeleteVertexArrays(1, &mVAO); // Supprime le VAO
     glDeleteBuffers(1, &mVBO);      // Supprime le VBO
+    glDeleteVertexArrays(1, &mDepthVAO); // Supprime le VAO de profondeur
+    glDeleteBuffers(1, &mPositionVBO);   // Supprime le VBO des positions
 }
 
 // Charge un fichier OBJ et extrait les informations de sommets et de textures
@@ -73,6 +77,7 @@ bool Mesh::loadOBJ(const std::string& filename)
                     dim = dim + 1;
                 }
                 tempVertices.push_back(vertex); // Ajoute le sommet à la liste
+                mBounds.expand(vertex); // Agrandit la boîte englobante
             }
             // Si la ligne commence par 'vt', elle contient des coordonnées de texture
             else if(cmd == "vt")
@@ -166,6 +171,9 @@ bool Mesh::loadOBJ(const std::string& filename)
             mVertices.push_back(meshVertex); // Ajoute le sommet au vecteur de sommets
 		}
 
+		// Sphère englobante centrée sur la boîte
+		computeSphere();
+
 		// Crée les buffers et les initialise
 		initBuffers();
 
@@ -176,6 +184,56 @@ bool Mesh::loadOBJ(const std::string& filename)
 	return false;
 }
 
+// Charge des sommets déjà prêts (lots statiques) : les buffers existants sont réutilisés
+bool Mesh::loadVertices(const std::vector<Vertex>& vertices)
+{
+    mVertices = vertices;
+    mBounds = AABB();
+    for(const Vertex& meshVertex : mVertices)
+    {
+        mBounds.expand(meshVertex.position);
+    }
+    computeSphere();
+
+    if(mVertices.empty())
+    {
+        return (mLoaded = false);
+    }
+
+    if(mVBO == 0)
+    {
+        initBuffers();
+        return (mLoaded = true);
+    }
+
+    std::vector<glm::vec3> positions(mVertices.size());
+    for(unsigned int i = 0; i < mVertices.size(); i = i + 1)
+    {
+        positions[i] = mVertices[i].position;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glBufferData(GL_ARRAY_BUFFER, mVertices.size() * sizeof(Vertex), &mVertices[0], GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, mPositionVBO);
+    glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(glm::vec3), &positions[0], GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return (mLoaded = true);
+}
+
+// Sphère englobante centrée sur la boîte : plus grande distance du centre à un sommet
+void Mesh::computeSphere()
+{
+    glm::vec3 center = mBounds.isEmpty() ? glm::vec3(0.0f) : mBounds.getCenter();
+    float radius2 = 0.0f;
+    for(const Vertex& meshVertex : mVertices)
+    {
+        glm::vec3 d = meshVertex.position - center;
+        radius2 = glm::max(radius2, glm::dot(d, d));
+    }
+    mSphere = glm::vec4(center, std::sqrt(radius2));
+}
+
 void Mesh::draw()
 {
 	if(!mLoaded)
@@ -188,6 +246,24 @@ void Mesh::draw()
     glBindVertexArray(0); // Debind du VAO
 }
 
+void Mesh::drawDepth()
+{
+	if(!mLoaded)
+    {
+        return;
+    }
+
+    glBindVertexArray(mDepthVAO); // Lier le VAO de profondeur
+    glDrawArrays(GL_TRIANGLES, 0, mVertices.size()); // Dessin du mesh
+    glBindVertexArray(0); // Debind du VAO
+}
+
+// Lier le VAO (positions seules pour les passes de profondeur), pour les dessins de la file de rendu
+void Mesh::bindVertexArray(bool depthOnly) const
+{
+    glBindVertexArray(depthOnly ? mDepthVAO : mVAO);
+}
+
 void Mesh::initBuffers()
 {
 	glGenBuffers(1, &mVBO); // Creation du VBO
@@ -210,4 +286,22 @@ void Mesh::initBuffers()
     glEnableVertexAttribArray(2); // Activation de l'attribut de texture
 
     glBindVertexArray(0); // Debind du VAO
+
+    // Positions seules (12 octets par sommet au lieu de 32) pour les passes de profondeur
+    std::vector<glm::vec3> positions(mVertices.size());
+    for(unsigned int i = 0; i < mVertices.size(); i = i + 1)
+    {
+        positions[i] = mVertices[i].position;
+    }
+
+    glGenBuffers(1, &mPositionVBO); // Creation du VBO des positions
+    glBindBuffer(GL_ARRAY_BUFFER, mPositionVBO);
+    glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(glm::vec3), &positions[0], GL_STATIC_DRAW);
+
+    glGenVertexArrays(1, &mDepthVAO); // Creation du VAO de profondeur
+    glBindVertexArray(mDepthVAO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), NULL); // Position des sommets
+    glEnableVertexAttribArray(0);
+
+    glBindVertexArray(0); // Debind du VAO
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
+#include "Bounds.hpp"
+
 #define GLEW_STATIC
 
 struct Vertex
@@ -23,15 +25,28 @@ public:
 	~Mesh();
 
 	bool loadOBJ(const std::string& filename); // Charge un modèle OBJ
+	bool loadVertices(const std::vector<Vertex>& vertices); // Charge des sommets déjà prêts (remplace le contenu des buffers)
 	void draw(); // Dessine le mesh
+	void drawDepth(); // Dessine seulement les positions (passes de profondeur)
+	void bindVertexArray(bool depthOnly) const; // Lier le VAO (positions seules pour les passes de profondeur)
+
+	const AABB& getBounds() const { return mBounds; } // Boîte englobante locale
+	const glm::vec4& getBoundingSphere() const { return mSphere; } // Sphère englobante locale (centre, rayon)
+	const std::vector<Vertex>& getVertices() const { return mVertices; } // Sommets (précalcul de l'éclairage)
+	GLsizei getVertexCount() const { return mLoaded ? (GLsizei)mVertices.size() : 0; } // Nombre de sommets à dessiner
+	GLuint getVertexArray(bool depthOnly) const { return depthOnly ? mDepthVAO : mVAO; } // Identifiant du VAO
 
 private:
 
 	void initBuffers(); // Initialise les buffers
+	void computeSphere(); // Sphère englobante centrée sur la boîte
 
 	bool mLoaded; // Indique si le mesh est chargé
 	std::vector<Vertex> mVertices; // Vecteur de vertices
+	AABB mBounds; // Boîte englobante locale, calculée au chargement
+	glm::vec4 mSphere; // Sphère englobante locale : centre de la boîte et plus grande distance à un sommet
 	GLuint mVBO, mVAO; // Identifiants des buffers, Vertex Buffer Object et Vertex Array Object
+	GLuint mPositionVBO, mDepthVAO; // Positions seules, compactes, pour les passes de profondeur
 };
 
 #endif //MESH_H
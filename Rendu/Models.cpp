@@ -7,7 +7,7 @@ void Models::initializeModels(ShaderProgram &shader)
     // Structure pour regrouper les donnees de chaque modele
     struct ModelInfo 
     {
-        std::string name;         // Nom du modele pour la map
+        std::string name;         // Nom du modele (recherche de l'identifiant au chargement)
         std::string objFile;      // Chemin du fichier .obj
         std::string textureFile;  // Chemin du fichier de texture
         glm::vec3 scale;          // echelle du modele
@@ -58,36 +58,55 @@ void Models::initializeModels(ShaderProgram &shader)
         mesh->loadOBJ(info.objFile);              // Charger l'objet
         texture->loadTexture(info.textureFile);   // Charger la texture
 
-        modelMap.emplace(info.name, ModelData(std::move(mesh), std::move(texture), shader, info.scale));
+        mHandles.emplace(info.name, (ModelHandle)mModels.size());
+        mModels.push_back(ModelData(std::move(mesh), std::move(texture), info.scale));
+        mNames.push_back(info.name);
         std::cout << "Modele charge : " << info.name << std::endl;
     }
+
+    mShader = &shader;
 }
 
-// Afficher un modele
-void Models::renderModel(std::string name, glm::vec3 position, glm::vec3 rotation, glm::mat4 model) 
+// Changer le shader utilisé pour le rendu des modèles
+void Models::useShader(ShaderProgram& shader)
+{
+    mShader = &shader;
+    mShader->use();
+}
+
+// Uniforms de matériau communs à tous les modèles (envoyés une fois par image, pas par objet)
+void Models::setMaterial(ShaderProgram& shader)
 {
-    // Verifier si le modele existe dans la map
-    if (modelMap.find(name) == modelMap.end()) 
+    shader.setUniform("material.ambient", glm::vec3(0.5f, 0.5f, 0.5f));
+    shader.setUniform("material.specular", glm::vec3(0.8f, 0.8f, 0.8f));
+    shader.setUniform("material.shininess", 32.0f);
+}
+
+// Identifiant d'un modèle à partir de son nom (INVALID_MODEL s'il n'existe pas)
+ModelHandle Models::findModel(const std::string& name) const
+{
+    auto it = mHandles.find(name);
+    if (it == mHandles.end()) 
     {
         std::cerr << "Le modele '" << name << "' n'exite pas !" << std::endl;
-        return;
+        return INVALID_MODEL;
     }
 
-    ModelData& modelData = modelMap[name];
+    return it->second;
+}
 
+// Afficher un modele
+void Models::renderModel(ModelHandle handle, glm::vec3 position, glm::vec3 rotation) 
+{
+    if (!isValid(handle)) 
+    {
+        return;
+    }
 
-    // Configurer la transformation
-    model = glm::mat4(1.0f);
-    model = glm::translate(model, position);
-    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::scale(model, modelData.scale);
+    const ModelData& modelData = mModels[handle];
 
     // Uniforms
-    modelData.shader.setUniform("model", model);
-    modelData.shader.setUniform("material.ambient", glm::vec3(0.5f, 0.5f, 0.5f));
-    modelData.shader.setUniformSampler("material.diffuseMap", 0);
-    modelData.shader.setUniform("material.specular", glm::vec3(0.8f, 0.8f, 0.8f));
-    modelData.shader.setUniform("material.shininess", 32.0f);
+    mShader->setUniform("model", computeModelMatrix(modelData, position, rotation));
 
     // Lier la texture
     modelData.texture->bind(0);
@@ -98,3 +117,47 @@ void Models::renderModel(std::string name, glm::vec3 position, glm::vec3 rotatio
     // Delier la texture
     modelData.texture->unbind(0);
 }
+
+// Matrice de modèle : translation, rotation autour de Y puis échelle du modèle
+glm::mat4 Models::computeModelMatrix(const ModelData& modelData, glm::vec3 position, glm::vec3 rotation) const
+{
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, position);
+    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::scale(model, modelData.scale);
+    return model;
+}
+
+// Boîte englobante d'un modèle placé dans la scène
+AABB Models::computeWorldBounds(ModelHandle handle, glm::vec3 position, glm::vec3 rotation) const
+{
+    if (!isValid(handle)) 
+    {
+        return AABB();
+    }
+
+    return transformAABB(mModels[handle].mesh->getBounds(), computeModelMatrix(mModels[handle], position, rotation));
+}
+
+// Matrice de modèle d'un modèle placé dans la scène
+glm::mat4 Models::getModelMatrix(ModelHandle handle, glm::vec3 position, glm::vec3 rotation) const
+{
+    if (!isValid(handle)) 
+    {
+        return glm::mat4(1.0f);
+    }
+
+    return computeModelMatrix(mModels[handle], position, rotation);
+}
+
+// Mesh d'un modèle (nullptr si l'identifiant est invalide)
+const Mesh* Models::getMesh(ModelHandle handle) const
+{
+    return isValid(handle) ? mModels[handle].mesh.get() : nullptr;
+}
+
+// Texture d'un modèle (nullptr si l'identifiant est invalide)
+Texture2D* Models::getTexture(ModelHandle handle) const
+{
+    return isValid(handle) ? mModels[handle].texture.get() : nullptr;
+}
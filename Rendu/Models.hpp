@@ -6,36 +6,59 @@
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "Mesh.hpp"
 #include "Texture2D.hpp"
 #include "ShaderProgram.hpp"
+#include "Bounds.hpp"
+
+// Identifiant d'un modèle : index dans le tableau des modèles (le nom ne sert qu'au chargement)
+typedef uint32_t ModelHandle;
+const ModelHandle INVALID_MODEL = 0xFFFFFFFF;
 
 struct ModelData 
 {
     std::unique_ptr<Mesh> mesh; // Mesh du modèle 
     std::unique_ptr<Texture2D> texture; // Texture du modèle
-    ShaderProgram shader; // Programme de shader
     glm::vec3 scale; // Echelle
 
     // Constructeur par défaut
     ModelData() = default;
 
     // Constructeur avec paramètres
-    ModelData(std::unique_ptr<Mesh> m, std::unique_ptr<Texture2D> t, ShaderProgram& s, glm::vec3 sc)
-        : mesh(std::move(m)), texture(std::move(t)), shader(s), scale(sc) {}
+    ModelData(std::unique_ptr<Mesh> m, std::unique_ptr<Texture2D> t, glm::vec3 sc)
+        : mesh(std::move(m)), texture(std::move(t)), scale(sc) {}
 };
 
 class Models 
 {
 public:
     void initializeModels(ShaderProgram& shader); // Initialiser les modèles
-    void renderModel(std::string name, glm::vec3 position, glm::vec3 rotation, glm::mat4 model); // Afficher un modèle
+    ModelHandle findModel(const std::string& name) const; // Identifiant d'un modèle à partir de son nom (chargement seulement)
+    const std::string& getName(ModelHandle handle) const { return mNames[handle]; } // Nom d'un modèle (messages de débogage)
+    size_t getModelCount() const { return mModels.size(); } // Nombre de modèles chargés
+    bool isValid(ModelHandle handle) const { return handle < mModels.size(); } // L'identifiant désigne un modèle chargé
+
+    void renderModel(ModelHandle handle, glm::vec3 position, glm::vec3 rotation); // Afficher un modèle
+    void useShader(ShaderProgram& shader); // Changer le shader utilisé pour le rendu des modèles
+    void setMaterial(ShaderProgram& shader); // Uniforms de matériau communs à tous les modèles
+    AABB computeWorldBounds(ModelHandle handle, glm::vec3 position, glm::vec3 rotation) const; // Boîte englobante d'un modèle placé dans la scène
+    glm::mat4 getModelMatrix(ModelHandle handle, glm::vec3 position, glm::vec3 rotation) const; // Matrice de modèle d'un modèle placé dans la scène
+    const Mesh* getMesh(ModelHandle handle) const; // Mesh d'un modèle (nullptr si l'identifiant est invalide)
+    Texture2D* getTexture(ModelHandle handle) const; // Texture d'un modèle (nullptr si l'identifiant est invalide)
+    glm::vec3 getScale(ModelHandle handle) const { return isValid(handle) ? mModels[handle].scale : glm::vec3(1.0f); } // Échelle d'un modèle
 
 private:
-    std::unordered_map<std::string, ModelData> modelMap; // Map pour stocker les modèles avec un nom en clé
+    glm::mat4 computeModelMatrix(const ModelData& modelData, glm::vec3 position, glm::vec3 rotation) const; // Matrice de modèle
+
+    ShaderProgram* mShader = nullptr; // Shader courant
+    std::vector<ModelData> mModels; // Modèles, indexés par leur identifiant
+    std::vector<std::string> mNames; // Nom de chaque modèle
+    std::unordered_map<std::string, ModelHandle> mHandles; // Identifiant de chaque nom (chargement seulement)
 };
 
 
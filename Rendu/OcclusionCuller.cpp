@@ -0,0 +1,347 @@
+#include <cfloat>
+#include <algorithm>
+#include <cmath>
+
+#include "OcclusionCuller.hpp"
+#include "Simd.hpp"
+
+
+// Arrêter les threads
+OcclusionCuller::~OcclusionCuller()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQuit = true;
+    }
+    mStart.notify_all();
+
+    for(std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+// Taille du tampon (arrondie à un multiple de 8) et nombre de threads : une bande de lignes par thread,
+// la première est traitée par le thread appelant
+void OcclusionCuller::init(int width, int height, int threadCount)
+{
+    mTilesX = glm::max(1, width / 8);
+    mTilesY = glm::max(1, height / 8);
+    mWidth = mTilesX * 8;
+    mHeight = mTilesY * 8;
+    mBandCount = glm::clamp(threadCount, 1, mTilesY);
+
+    mDepth.assign((size_t)mWidth * mHeight, 0.0f);
+    mHiZ.assign((size_t)mTilesX * mTilesY, 0.0f);
+
+    for(int band = 1; band < mBandCount; band = band + 1)
+    {
+        mThreads.emplace_back(&OcclusionCuller::workerLoop, this, band);
+    }
+}
+
+// Nouvelle image : vider la liste des occultants
+void OcclusionCuller::beginFrame(const glm::mat4& viewProjection)
+{
+    mViewProjection = viewProjection;
+    mTriangles.clear();
+}
+
+// Ajouter une boîte occultante : 12 triangles (les faces arrière sont gardées, la boîte est fermée)
+void OcclusionCuller::addBox(const glm::vec3 corners[8])
+{
+    static const int faces[6][4] =
+    {
+        { 0, 2, 6, 4 }, { 1, 5, 7, 3 }, // x min, x max
+        { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, // y min, y max
+        { 0, 1, 3, 2 }, { 4, 6, 7, 5 }  // z min, z max
+    };
+
+    glm::vec4 clip[8];
+    for(int k = 0; k < 8; k = k + 1)
+    {
+        clip[k] = mViewProjection * glm::vec4(corners[k], 1.0f);
+    }
+
+    for(int f = 0; f < 6; f = f + 1)
+    {
+        addTriangle(clip[faces[f][0]], clip[faces[f][1]], clip[faces[f][2]]);
+        addTriangle(clip[faces[f][0]], clip[faces[f][2]], clip[faces[f][3]]);
+    }
+}
+
+// Découper un triangle contre le plan proche (z + w >= 0) : 0, 1 ou 2 triangles
+void OcclusionCuller::addTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+{
+    const glm::vec4* input[3] = { &a, &b, &c };
+    glm::vec4 polygon[4];
+    int count = 0;
+
+    for(int i = 0; i < 3; i = i + 1)
+    {
+        const glm::vec4& p = *input[i];
+        const glm::vec4& q = *input[(i + 1) % 3];
+        float dp = p.z + p.w;
+        float dq = q.z + q.w;
+
+        if(dp >= 0.0f)
+        {
+            polygon[count] = p;
+            count = count + 1;
+        }
+        if((dp >= 0.0f) != (dq >= 0.0f))
+        {
+            polygon[count] = p + (q - p) * (dp / (dp - dq));
+            count = count + 1;
+        }
+    }
+
+    for(int i = 2; i < count; i = i + 1)
+    {
+        addScreenTriangle(polygon[0], polygon[i - 1], polygon[i]);
+    }
+}
+
+// Projeter un triangle devant le plan proche : pixels et 1/w, lignes couvertes
+void OcclusionCuller::addScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+{
+    Triangle triangle;
+    const glm::vec4* clip[3] = { &a, &b, &c };
+    float minY = FLT_MAX, maxY = -FLT_MAX;
+    float minX = FLT_MAX, maxX = -FLT_MAX;
+
+    for(int i = 0; i < 3; i = i + 1)
+    {
+        float invW = 1.0f / clip[i]->w;
+        triangle.v[i] = glm::vec3((clip[i]->x * invW * 0.5f + 0.5f) * mWidth, (clip[i]->y * invW * 0.5f + 0.5f) * mHeight, invW);
+        minX = glm::min(minX, triangle.v[i].x); maxX = glm::max(maxX, triangle.v[i].x);
+        minY = glm::min(minY, triangle.v[i].y); maxY = glm::max(maxY, triangle.v[i].y);
+    }
+
+    // Lignes dont le centre des pixels peut être couvert
+    triangle.minY = glm::max(0, (int)std::ceil(minY - 0.5f));
+    triangle.maxY = glm::min(mHeight - 1, (int)std::floor(maxY - 0.5f));
+    if(triangle.minY > triangle.maxY || maxX < 0.0f || minX > (float)mWidth)
+    {
+        return;
+    }
+
+    mTriangles.push_back(triangle);
+}
+
+// Rastériser les occultants : chaque bande est traitée par un thread, la première par le thread appelant
+void OcclusionCuller::rasterize()
+{
+    if(mWidth == 0)
+    {
+        return;
+    }
+
+    if(mThreads.empty())
+    {
+        rasterizeBand(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending = (int)mThreads.size();
+        mGeneration = mGeneration + 1;
+    }
+    mStart.notify_all();
+
+    rasterizeBand(0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this]() { return mPending == 0; });
+}
+
+// Boucle d'un thread : attendre une nouvelle image, traiter sa bande
+void OcclusionCuller::workerLoop(int band)
+{
+    int generation = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStart.wait(lock, [&]() { return mQuit || mGeneration != generation; });
+            if(mQuit)
+            {
+                return;
+            }
+            generation = mGeneration;
+        }
+
+        rasterizeBand(band);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPending = mPending - 1;
+        }
+        mDone.notify_one();
+    }
+}
+
+// Vider, rastériser et réduire en tuiles les lignes d'une bande.
+// Fonctions d'arête E(p) = A.x + B.y + C, positives à l'intérieur d'un triangle orienté dans le sens direct ;
+// 1/w varie linéairement à l'écran, il est interpolé par son plan z = zA.x + zB.y + zC.
+void OcclusionCuller::rasterizeBand(int band)
+{
+    int tileStart = band * mTilesY / mBandCount;
+    int tileEnd = (band + 1) * mTilesY / mBandCount;
+    int rowStart = tileStart * 8;
+    int rowEnd = tileEnd * 8;
+
+    std::fill(mDepth.begin() + (size_t)rowStart * mWidth, mDepth.begin() + (size_t)rowEnd * mWidth, 0.0f);
+
+    float4 zero = float4::zero();
+    float4 offsets(0.5f, 1.5f, 2.5f, 3.5f); // Centres de 4 pixels consécutifs
+
+    for(const Triangle& triangle : mTriangles)
+    {
+        if(triangle.maxY < rowStart || triangle.minY >= rowEnd)
+        {
+            continue;
+        }
+
+        glm::vec3 v0 = triangle.v[0];
+        glm::vec3 v1 = triangle.v[1];
+        glm::vec3 v2 = triangle.v[2];
+        float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+        if(glm::abs(area) < 1e-6f)
+        {
+            continue;
+        }
+        if(area < 0.0f)
+        {
+            std::swap(v1, v2);
+            area = -area;
+        }
+
+        // Arêtes v0->v1, v1->v2, v2->v0
+        glm::vec3 vertices[3] = { v0, v1, v2 };
+        float edgeA[3], edgeB[3], edgeC[3];
+        for(int e = 0; e < 3; e = e + 1)
+        {
+            const glm::vec3& p = vertices[e];
+            const glm::vec3& q = vertices[(e + 1) % 3];
+            edgeA[e] = p.y - q.y;
+            edgeB[e] = q.x - p.x;
+            edgeC[e] = (q.y - p.y) * p.x - (q.x - p.x) * p.y;
+        }
+
+        float zA = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+        float zB = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+        float zC = v0.z - zA * v0.x - zB * v0.y;
+
+        int minX = glm::max(0, (int)std::floor(glm::min(v0.x, glm::min(v1.x, v2.x)))) & ~3;
+        int maxX = glm::min(mWidth - 1, (int)std::floor(glm::max(v0.x, glm::max(v1.x, v2.x))));
+        int minY = glm::max(triangle.minY, rowStart);
+        int maxY = glm::min(triangle.maxY, rowEnd - 1);
+
+        float4 a0(edgeA[0]), a1(edgeA[1]), a2(edgeA[2]), za(zA);
+        for(int y = minY; y <= maxY; y = y + 1)
+        {
+            float py = (float)y + 0.5f;
+            float4 row0(edgeB[0] * py + edgeC[0]);
+            float4 row1(edgeB[1] * py + edgeC[1]);
+            float4 row2(edgeB[2] * py + edgeC[2]);
+            float4 rowZ(zB * py + zC);
+            float* depthRow = &mDepth[(size_t)y * mWidth];
+
+            for(int x = minX; x <= maxX; x = x + 4)
+            {
+                float4 px = float4((float)x) + offsets;
+                float4 inside = cmpge(a0 * px + row0, zero) & cmpge(a1 * px + row1, zero) & cmpge(a2 * px + row2, zero);
+                if(movemask(inside) == 0)
+                {
+                    continue;
+                }
+
+                float4 depth = float4::load(depthRow + x);
+                select(inside, max4(depth, za * px + rowZ), depth).store(depthRow + x);
+            }
+        }
+    }
+
+    // Profondeur hiérarchique : l'occultant le plus lointain de chaque tuile
+    for(int ty = tileStart; ty < tileEnd; ty = ty + 1)
+    {
+        for(int tx = 0; tx < mTilesX; tx = tx + 1)
+        {
+            float4 farthest(FLT_MAX);
+            for(int y = ty * 8; y < ty * 8 + 8; y = y + 1)
+            {
+                const float* depthRow = &mDepth[(size_t)y * mWidth + tx * 8];
+                farthest = min4(farthest, min4(float4::load(depthRow), float4::load(depthRow + 4)));
+            }
+
+            float lanes[4];
+            farthest.store(lanes);
+            mHiZ[(size_t)ty * mTilesX + tx] = glm::min(glm::min(lanes[0], lanes[1]), glm::min(lanes[2], lanes[3]));
+        }
+    }
+}
+
+// La boîte est entièrement derrière les occultants : son point le plus proche (1/w le plus grand)
+// est plus loin que l'occultant de chaque pixel qu'elle couvre. Les tuiles règlent la plupart des cas,
+// les pixels ne sont lus que pour les tuiles non concluantes.
+bool OcclusionCuller::isOccluded(const AABB& box) const
+{
+    if(mWidth == 0 || box.isEmpty())
+    {
+        return false;
+    }
+
+    float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX;
+    float nearest = 0.0f;
+    for(int k = 0; k < 8; k = k + 1)
+    {
+        glm::vec3 corner((k & 1) ? box.max.x : box.min.x, (k & 2) ? box.max.y : box.min.y, (k & 4) ? box.max.z : box.min.z);
+        glm::vec4 clip = mViewProjection * glm::vec4(corner, 1.0f);
+        if(clip.z + clip.w < 0.0f)
+        {
+            return false; // Coin devant le plan proche : la boîte touche la caméra
+        }
+
+        float invW = 1.0f / clip.w;
+        float x = (clip.x * invW * 0.5f + 0.5f) * mWidth;
+        float y = (clip.y * invW * 0.5f + 0.5f) * mHeight;
+        minX = glm::min(minX, x); maxX = glm::max(maxX, x);
+        minY = glm::min(minY, y); maxY = glm::max(maxY, y);
+        nearest = glm::max(nearest, invW);
+    }
+
+    int x0 = glm::max(0, (int)std::floor(minX));
+    int x1 = glm::min(mWidth - 1, (int)std::floor(maxX));
+    int y0 = glm::max(0, (int)std::floor(minY));
+    int y1 = glm::min(mHeight - 1, (int)std::floor(maxY));
+    if(x0 > x1 || y0 > y1)
+    {
+        return false;
+    }
+
+    for(int ty = y0 / 8; ty <= y1 / 8; ty = ty + 1)
+    {
+        for(int tx = x0 / 8; tx <= x1 / 8; tx = tx + 1)
+        {
+            if(nearest < mHiZ[(size_t)ty * mTilesX + tx])
+            {
+                continue; // Toute la tuile est devant la boîte
+            }
+
+            for(int y = glm::max(y0, ty * 8); y <= glm::min(y1, ty * 8 + 7); y = y + 1)
+            {
+                for(int x = glm::max(x0, tx * 8); x <= glm::min(x1, tx * 8 + 7); x = x + 1)
+                {
+                    if(nearest >= mDepth[(size_t)y * mWidth + x])
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
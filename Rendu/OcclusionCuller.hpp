@@ -0,0 +1,60 @@
+#ifndef OCCLUSION_CULLER_HPP
+#define OCCLUSION_CULLER_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <glm/glm.hpp>
+
+#include "Bounds.hpp"
+
+// Élimination des objets cachés sur le CPU : les boîtes intérieures des gros objets (occultants)
+// sont rastérisées 4 pixels à la fois dans un petit tampon de profondeur, par bandes de lignes
+// réparties entre des threads permanents. Une profondeur hiérarchique (tuiles de 8x8 pixels,
+// profondeur la plus lointaine de la tuile) accélère ensuite le test des boîtes des objets.
+// La profondeur stockée est 1/w : 0 pour un pixel vide, plus grande pour un occultant plus proche.
+class OcclusionCuller
+{
+public:
+    OcclusionCuller() = default;
+    ~OcclusionCuller();
+
+    void init(int width, int height, int threadCount); // Taille du tampon (multiple de 8) et nombre de threads
+    void beginFrame(const glm::mat4& viewProjection); // Nouvelle image : vider la liste des occultants
+    void addBox(const glm::vec3 corners[8]); // Ajouter une boîte occultante (coins en monde, bit 0 : x, bit 1 : y, bit 2 : z)
+    void rasterize(); // Rastériser les occultants (threads) et construire la profondeur hiérarchique
+    bool isOccluded(const AABB& box) const; // La boîte est entièrement derrière les occultants
+
+    int getTriangleCount() const { return (int)mTriangles.size(); } // Triangles rastérisés dans l'image
+
+private:
+    struct Triangle
+    {
+        glm::vec3 v[3]; // Sommets à l'écran : x, y en pixels, z = 1/w
+        int minY, maxY; // Lignes couvertes
+    };
+
+    void addTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c); // Découper contre le plan proche puis projeter
+    void addScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c); // Triangle entièrement devant le plan proche
+    void rasterizeBand(int band); // Vider, rastériser et réduire les lignes d'une bande
+    void workerLoop(int band); // Boucle d'un thread
+
+    int mWidth = 0, mHeight = 0; // Taille du tampon
+    int mTilesX = 0, mTilesY = 0; // Nombre de tuiles de 8x8
+    int mBandCount = 1; // Nombre de bandes (une par thread)
+    glm::mat4 mViewProjection = glm::mat4(1.0f);
+    std::vector<float> mDepth; // 1/w le plus grand par pixel
+    std::vector<float> mHiZ; // 1/w le plus petit par tuile
+    std::vector<Triangle> mTriangles; // Triangles des occultants de l'image
+
+    // Threads permanents : chacun attend une nouvelle génération, traite sa bande et le signale
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mStart, mDone;
+    int mGeneration = 0;
+    int mPending = 0;
+    bool mQuit = false;
+};
+
+#endif // OCCLUSION_CULLER_HPP
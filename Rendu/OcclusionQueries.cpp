@@ -0,0 +1,131 @@
+#include "OcclusionQueries.hpp"
+
+
+OcclusionQueries::OcclusionQueries() : mEmptyVAO(0), mFrame(0), mIssuedCount(0), mHiddenCount(0)
+{
+}
+
+OcclusionQueries::~OcclusionQueries()
+{
+    clear();
+    if(mEmptyVAO != 0)
+    {
+        glDeleteVertexArrays(1, &mEmptyVAO);
+    }
+}
+
+// Création du VAO vide (le profil core exige un VAO lié pour dessiner)
+void OcclusionQueries::init()
+{
+    glGenVertexArrays(1, &mEmptyVAO);
+}
+
+// Supprimer les éléments et leurs requêtes
+void OcclusionQueries::clear()
+{
+    for(Item& item : mItems)
+    {
+        glDeleteQueries(1, &item.query);
+    }
+    mItems.clear();
+    mHiddenCount = 0;
+}
+
+// Ajouter un élément : les premières requêtes sont étalées sur plusieurs images
+uint32_t OcclusionQueries::addItem(const AABB& box)
+{
+    Item item;
+    item.box = box;
+    item.nextFrame = mFrame + (uint32_t)mItems.size() % MAX_INTERVAL;
+    glGenQueries(1, &item.query);
+
+    mItems.push_back(item);
+    return (uint32_t)mItems.size() - 1;
+}
+
+// Images avant la prochaine requête : à chaque image pour un élément caché (il doit réapparaître vite),
+// de plus en plus espacées pour un élément qui reste visible
+uint32_t OcclusionQueries::getInterval(const Item& item) const
+{
+    if(!item.visible)
+    {
+        return 1;
+    }
+    return glm::min(1 + item.visibleFrames / FRAMES_PER_STEP, MAX_INTERVAL);
+}
+
+// Nouvelle image : lire les résultats prêts sans jamais attendre
+void OcclusionQueries::beginFrame()
+{
+    mFrame = mFrame + 1;
+    mIssuedCount = 0;
+    mHiddenCount = 0;
+
+    for(Item& item : mItems)
+    {
+        if(item.pending)
+        {
+            GLint available = 0;
+            glGetQueryObjectiv(item.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if(available)
+            {
+                GLuint anySamples = 0;
+                glGetQueryObjectuiv(item.query, GL_QUERY_RESULT, &anySamples);
+                item.visible = (anySamples != 0);
+                item.visibleFrames = item.visible ? item.visibleFrames + 1 : 0;
+                item.nextFrame = mFrame + getInterval(item) - 1;
+                item.pending = false;
+            }
+        }
+
+        if(!item.visible)
+        {
+            mHiddenCount = mHiddenCount + 1;
+        }
+    }
+}
+
+// Interroger les éléments dans la vue dont la requête est due : boîte dessinée contre la profondeur
+// des objets déjà dessinés, sans écrire de couleur ni de profondeur
+void OcclusionQueries::issueQueries(ShaderProgram& shader, const glm::mat4& viewProjection, const glm::vec3& viewPos, const std::vector<uint8_t>& inView)
+{
+    const float NEAR_MARGIN = 0.5f; // Caméra dans la boîte ou presque : la boîte serait coupée par le plan proche
+
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+
+    shader.use();
+    shader.setUniform("viewProjection", viewProjection);
+    glBindVertexArray(mEmptyVAO);
+
+    for(size_t i = 0; i < mItems.size(); i = i + 1)
+    {
+        Item& item = mItems[i];
+        if(!inView[i] || item.pending || mFrame < item.nextFrame)
+        {
+            continue;
+        }
+
+        glm::vec3 outside = glm::max(glm::max(item.box.min - viewPos, viewPos - item.box.max), glm::vec3(0.0f));
+        if(glm::max(outside.x, glm::max(outside.y, outside.z)) <= NEAR_MARGIN)
+        {
+            item.visible = true;
+            item.visibleFrames = item.visibleFrames + 1;
+            item.nextFrame = mFrame + getInterval(item);
+            continue;
+        }
+
+        shader.setUniform("boxMin", item.box.min);
+        shader.setUniform("boxMax", item.box.max);
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, item.query);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 14);
+        glEndQuery(GL_ANY_SAMPLES_PASSED);
+
+        item.pending = true;
+        mIssuedCount = mIssuedCount + 1;
+    }
+
+    glBindVertexArray(0);
+    glDepthMask(GL_TRUE);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
@@ -0,0 +1,62 @@
+#ifndef OCCLUSION_QUERIES_HPP
+#define OCCLUSION_QUERIES_HPP
+
+#include <vector>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Bounds.hpp"
+
+#define GLEW_STATIC
+
+// Élimination des objets cachés sur le GPU : la boîte d'un élément (modèle lourd ou groupe d'arbres)
+// est dessinée sans écrire de couleur ni de profondeur dans une requête GL_ANY_SAMPLES_PASSED.
+// Les résultats ne sont lus que lorsqu'ils sont prêts (le CPU n'attend jamais le GPU) et servent
+// à l'image suivante ; un élément caché est dessiné en rendu conditionnel sur sa requête de l'image.
+// Un élément visible depuis longtemps est interrogé moins souvent (historique de visibilité).
+class OcclusionQueries
+{
+public:
+    OcclusionQueries();
+    ~OcclusionQueries();
+
+    void init(); // Création du VAO vide (contexte OpenGL requis)
+    void clear(); // Supprimer les éléments et leurs requêtes
+    uint32_t addItem(const AABB& box); // Ajouter un élément (boîte en monde), renvoie son identifiant
+
+    void beginFrame(); // Nouvelle image : lire les résultats prêts
+    void issueQueries(ShaderProgram& shader, const glm::mat4& viewProjection, const glm::vec3& viewPos, const std::vector<uint8_t>& inView); // Interroger les éléments dans la vue qui en ont besoin (après les objets visibles)
+
+    bool isVisible(uint32_t item) const { return mItems[item].visible; } // Dernier résultat connu (visible tant qu'aucun résultat)
+    GLuint getQuery(uint32_t item) const { return mItems[item].query; } // Requête du rendu conditionnel
+    size_t size() const { return mItems.size(); } // Nombre d'éléments
+
+    int getIssuedCount() const { return mIssuedCount; } // Requêtes émises dans l'image
+    int getHiddenCount() const { return mHiddenCount; } // Éléments cachés selon les derniers résultats
+
+private:
+    static const uint32_t MAX_INTERVAL = 8; // Images au plus entre deux requêtes d'un élément visible
+    static const uint32_t FRAMES_PER_STEP = 4; // Images visibles pour allonger l'intervalle d'une image
+
+    struct Item
+    {
+        AABB box; // Boîte en monde
+        GLuint query = 0; // Requête d'occlusion
+        bool pending = false; // Résultat pas encore lu
+        bool visible = true; // Dernier résultat lu
+        uint32_t visibleFrames = 0; // Résultats visibles consécutifs
+        uint32_t nextFrame = 0; // Image de la prochaine requête
+    };
+
+    uint32_t getInterval(const Item& item) const; // Images avant la prochaine requête
+
+    std::vector<Item> mItems;
+    GLuint mEmptyVAO; // VAO vide : la boîte est générée dans le shader
+    uint32_t mFrame; // Numéro de l'image
+    int mIssuedCount; // Requêtes émises dans l'image
+    int mHiddenCount; // Éléments cachés
+};
+
+#endif // OCCLUSION_QUERIES_HPP
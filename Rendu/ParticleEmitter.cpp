@@ -0,0 +1,254 @@
+#include "ParticleEmitter.hpp"
+#include "Simd.hpp"
+#include <cmath>
+
+
+// Taille des colonnes : multiple de 4 (les dernières voies d'un groupe de 4 restent dans le tableau)
+static size_t roundUp4(size_t count)
+{
+    return (count + 3) & ~(size_t)3;
+}
+
+
+ParticleEmitter::ParticleEmitter(glm::vec3 position, uint32_t seed) : mPosition(position), mRandom(seed != 0 ? seed : 1), mLight(0.0f)
+{
+}
+
+// Nouvelle couche, colonnes allouées une fois pour toutes à sa capacité
+void ParticleEmitter::addLayer(const ParticleLayerSettings& settings)
+{
+    Layer layer;
+    layer.settings = settings;
+    size_t size = roundUp4(settings.capacity);
+    std::vector<float>* columns[8] = { &layer.positionX, &layer.positionY, &layer.positionZ, &layer.velocityX, &layer.velocityY, &layer.velocityZ, &layer.age, &layer.invLife };
+    for(std::vector<float>* column : columns)
+    {
+        column->assign(size, 0.0f);
+    }
+    layer.count = 0;
+    layer.pending = 0.0f;
+    mLayers.push_back(layer);
+}
+
+// Xorshift 32 bits
+float ParticleEmitter::random()
+{
+    mRandom = mRandom ^ (mRandom << 13);
+    mRandom = mRandom ^ (mRandom >> 17);
+    mRandom = mRandom ^ (mRandom << 5);
+    return (float)(mRandom >> 8) / 16777216.0f;
+}
+
+// Débit moyen de la couche, multiplié à chaque image par un facteur entre 0.5 et 1.5 (le feu crépite) ;
+// les particules naissent dans le disque d'émission, sans dépasser la capacité
+void ParticleEmitter::emit(Layer& layer, float deltaTime)
+{
+    const ParticleLayerSettings& settings = layer.settings;
+    layer.pending = layer.pending + settings.rate * deltaTime * (0.5f + random());
+    int count = (int)layer.pending;
+    layer.pending = layer.pending - (float)count;
+
+    for(int n = 0; n < count && layer.count < settings.capacity; n = n + 1)
+    {
+        size_t i = layer.count;
+        float angle = random() * 6.2831853f;
+        float distance = settings.radius * std::sqrt(random());
+        layer.positionX[i] = mPosition.x + distance * std::cos(angle);
+        layer.positionY[i] = mPosition.y;
+        layer.positionZ[i] = mPosition.z + distance * std::sin(angle);
+
+        glm::vec3 spread = glm::vec3(random(), random(), random()) * 2.0f - 1.0f;
+        glm::vec3 velocity = settings.velocity + spread * settings.velocitySpread;
+        layer.velocityX[i] = velocity.x;
+        layer.velocityY[i] = velocity.y;
+        layer.velocityZ[i] = velocity.z;
+
+        layer.age[i] = 0.0f;
+        layer.invLife[i] = 1.0f / glm::mix(settings.minLife, settings.maxLife, random());
+        layer.count = layer.count + 1;
+    }
+}
+
+// Accélération, freinage, position et âge, 4 particules à la fois. Les voies au-delà de count avancent aussi
+// (colonnes complétées) mais ne comptent pas dans la somme : 1 - t de chaque particule encore vivante
+float ParticleEmitter::integrate(Layer& layer, float deltaTime)
+{
+    const ParticleLayerSettings& settings = layer.settings;
+    float4 dt(deltaTime);
+    float4 accelerationX(settings.acceleration.x * deltaTime);
+    float4 accelerationY(settings.acceleration.y * deltaTime);
+    float4 accelerationZ(settings.acceleration.z * deltaTime);
+    float4 damping(glm::max(1.0f - settings.drag * deltaTime, 0.0f));
+    float4 one(1.0f);
+    float4 count((float)layer.count);
+    float4 lanes(0.0f, 1.0f, 2.0f, 3.0f);
+    float4 sum = float4::zero();
+
+    for(size_t i = 0; i < layer.count; i = i + 4)
+    {
+        float4 velocityX = (float4::load(&layer.velocityX[i]) + accelerationX) * damping;
+        float4 velocityY = (float4::load(&layer.velocityY[i]) + accelerationY) * damping;
+        float4 velocityZ = (float4::load(&layer.velocityZ[i]) + accelerationZ) * damping;
+        velocityX.store(&layer.velocityX[i]);
+        velocityY.store(&layer.velocityY[i]);
+        velocityZ.store(&layer.velocityZ[i]);
+
+        (float4::load(&layer.positionX[i]) + velocityX * dt).store(&layer.positionX[i]);
+        (float4::load(&layer.positionY[i]) + velocityY * dt).store(&layer.positionY[i]);
+        (float4::load(&layer.positionZ[i]) + velocityZ * dt).store(&layer.positionZ[i]);
+
+        float4 age = float4::load(&layer.age[i]) + dt;
+        age.store(&layer.age[i]);
+
+        float4 remaining = max4(one - age * float4::load(&layer.invLife[i]), float4::zero());
+        float4 valid = cmplt(lanes + float4((float)i), count);
+        sum = sum + (remaining & valid);
+    }
+
+    float lanesSum[4];
+    sum.store(lanesSum);
+    return lanesSum[0] + lanesSum[1] + lanesSum[2] + lanesSum[3];
+}
+
+// Particules mortes remplacées par la dernière ; les groupes de 4 sans particule morte sont sautés d'un coup
+void ParticleEmitter::removeDead(Layer& layer)
+{
+    float4 one(1.0f);
+    size_t i = 0;
+    while(i < layer.count)
+    {
+        if((i & 3) == 0 && i + 4 <= layer.count)
+        {
+            float4 t = float4::load(&layer.age[i]) * float4::load(&layer.invLife[i]);
+            if(movemask(cmpge(t, one)) == 0)
+            {
+                i = i + 4;
+                continue;
+            }
+        }
+
+        if(layer.age[i] * layer.invLife[i] >= 1.0f)
+        {
+            size_t last = layer.count - 1;
+            layer.positionX[i] = layer.positionX[last];
+            layer.positionY[i] = layer.positionY[last];
+            layer.positionZ[i] = layer.positionZ[last];
+            layer.velocityX[i] = layer.velocityX[last];
+            layer.velocityY[i] = layer.velocityY[last];
+            layer.velocityZ[i] = layer.velocityZ[last];
+            layer.age[i] = layer.age[last];
+            layer.invLife[i] = layer.invLife[last];
+            layer.count = last; // La particule déplacée en i est testée au tour suivant
+        }
+        else
+        {
+            i = i + 1;
+        }
+    }
+}
+
+// Chaque couche : émission, mouvement, retrait des mortes. La lumière de l'émetteur suit la vie restante
+// des particules des couches qui éclairent, rapportée à sa valeur moyenne (débit x durée de vie moyenne / 2) :
+// elle baisse et remonte avec le débit, comme les flammes dessinées
+void ParticleEmitter::update(float deltaTime)
+{
+    float light = 0.0f;
+    float weight = 0.0f;
+    for(Layer& layer : mLayers)
+    {
+        emit(layer, deltaTime);
+        float remaining = integrate(layer, deltaTime);
+        removeDead(layer);
+
+        const ParticleLayerSettings& settings = layer.settings;
+        float expected = 0.5f * settings.rate * 0.5f * (settings.minLife + settings.maxLife);
+        if(settings.lightWeight > 0.0f && expected > 0.0f)
+        {
+            light = light + settings.lightWeight * remaining / expected;
+            weight = weight + settings.lightWeight;
+        }
+    }
+    mLight = weight > 0.0f ? light / weight : 0.0f;
+}
+
+// Taille et couleur interpolées selon t = âge / durée de vie ; 4 particules par groupe, colonnes transposées
+// en 4 instances (position + taille, couleur), le reste de la couche une par une
+size_t ParticleEmitter::writeInstances(ParticleInstance* out) const
+{
+    size_t written = 0;
+    for(const Layer& layer : mLayers)
+    {
+        const ParticleLayerSettings& settings = layer.settings;
+        float4 one(1.0f);
+        float4 startSize(settings.startSize);
+        float4 deltaSize(settings.endSize - settings.startSize);
+        float4 startColor[4];
+        float4 deltaColor[4];
+        for(int c = 0; c < 4; c = c + 1)
+        {
+            startColor[c] = float4(settings.startColor[c]);
+            deltaColor[c] = float4(settings.endColor[c] - settings.startColor[c]);
+        }
+
+        ParticleInstance* instances = out + written;
+        size_t full = layer.count & ~(size_t)3;
+        for(size_t i = 0; i < full; i = i + 4)
+        {
+            float4 t = min4(float4::load(&layer.age[i]) * float4::load(&layer.invLife[i]), one);
+
+            float4 x = float4::load(&layer.positionX[i]);
+            float4 y = float4::load(&layer.positionY[i]);
+            float4 z = float4::load(&layer.positionZ[i]);
+            float4 size = startSize + deltaSize * t;
+            transpose4(x, y, z, size);
+
+            float4 r = startColor[0] + deltaColor[0] * t;
+            float4 g = startColor[1] + deltaColor[1] * t;
+            float4 b = startColor[2] + deltaColor[2] * t;
+            float4 a = startColor[3] + deltaColor[3] * t;
+            transpose4(r, g, b, a);
+
+            x.store(&instances[i].position[0]);
+            r.store(&instances[i].color[0]);
+            y.store(&instances[i + 1].position[0]);
+            g.store(&instances[i + 1].color[0]);
+            z.store(&instances[i + 2].position[0]);
+            b.store(&instances[i + 2].color[0]);
+            size.store(&instances[i + 3].position[0]);
+            a.store(&instances[i + 3].color[0]);
+        }
+
+        for(size_t i = full; i < layer.count; i = i + 1)
+        {
+            float t = glm::min(layer.age[i] * layer.invLife[i], 1.0f);
+            float size = settings.startSize + (settings.endSize - settings.startSize) * t;
+            instances[i].position = glm::vec4(layer.positionX[i], layer.positionY[i], layer.positionZ[i], size);
+            instances[i].color = glm::mix(settings.startColor, settings.endColor, t);
+        }
+        written = written + layer.count;
+    }
+    return written;
+}
+
+// Particules vivantes au plus, toutes couches
+size_t ParticleEmitter::getCapacity() const
+{
+    size_t capacity = 0;
+    for(const Layer& layer : mLayers)
+    {
+        capacity = capacity + layer.settings.capacity;
+    }
+    return capacity;
+}
+
+// Particules vivantes, toutes couches
+size_t ParticleEmitter::getParticleCount() const
+{
+    size_t count = 0;
+    for(const Layer& layer : mLayers)
+    {
+        count = count + layer.count;
+    }
+    return count;
+}
+
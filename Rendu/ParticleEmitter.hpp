@@ -0,0 +1,77 @@
+#ifndef PARTICLE_EMITTER_HPP
+#define PARTICLE_EMITTER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Paramètres d'une couche de particules d'un émetteur (flammes, fumée, braises...)
+struct ParticleLayerSettings
+{
+    size_t capacity = 64; // Particules vivantes au plus
+    float rate = 30.0f; // Particules émises par seconde (en moyenne : le débit varie d'une image à l'autre)
+    float minLife = 1.0f; // Durée de vie, tirée entre les deux bornes
+    float maxLife = 1.0f;
+    float radius = 0.2f; // Rayon du disque d'émission, autour de la position de l'émetteur
+    glm::vec3 velocity = glm::vec3(0.0f, 1.0f, 0.0f); // Vitesse initiale moyenne
+    glm::vec3 velocitySpread = glm::vec3(0.0f); // Écart aléatoire de la vitesse initiale sur chaque axe
+    glm::vec3 acceleration = glm::vec3(0.0f); // Montée de l'air chaud, gravité, vent
+    float drag = 0.0f; // Part de la vitesse perdue par seconde
+    float startSize = 0.5f; // Taille du quad à la naissance et à la mort
+    float endSize = 0.5f;
+    glm::vec4 startColor = glm::vec4(1.0f); // Couleur prémultipliée (alpha 0 : particule additive)
+    glm::vec4 endColor = glm::vec4(0.0f);
+    float lightWeight = 0.0f; // Part de la couche dans la lumière de l'émetteur (0 : n'éclaire pas)
+};
+
+// Particule prête à dessiner, lue par particle.vert (attributs 0 et 1, un pas par instance)
+struct ParticleInstance
+{
+    glm::vec4 position; // Centre (xyz), taille
+    glm::vec4 color; // Couleur prémultipliée
+};
+
+// Émetteur de particules : chaque couche garde ses particules en SoA (une colonne par composante,
+// complétée à un multiple de 4). La mise à jour avance 4 particules à la fois (SIMD) puis retire les
+// mortes en les remplaçant par la dernière ; l'écriture des instances interpole taille et couleur selon
+// l'âge, 4 particules à la fois, et transpose les colonnes en instances. Aucun état partagé entre
+// émetteurs : plusieurs émetteurs peuvent être mis à jour en même temps sur des threads différents (JobSystem).
+class ParticleEmitter
+{
+public:
+    ParticleEmitter(glm::vec3 position = glm::vec3(0.0f), uint32_t seed = 1);
+
+    void addLayer(const ParticleLayerSettings& settings); // Ajouter une couche (dessinée après les précédentes)
+    void setPosition(glm::vec3 position) { mPosition = position; }
+    void update(float deltaTime); // Émettre, avancer et retirer les particules mortes
+    size_t writeInstances(ParticleInstance* out) const; // Écrire les particules vivantes, couche par couche (renvoie leur nombre)
+
+    glm::vec3 getPosition() const { return mPosition; }
+    size_t getCapacity() const; // Particules vivantes au plus, toutes couches (taille du tableau de writeInstances)
+    size_t getParticleCount() const; // Particules vivantes
+    float getLight() const { return mLight; } // Intensité de la lumière émise, 1 en moyenne (couches avec lightWeight > 0)
+
+private:
+    // Couche : paramètres et particules en SoA
+    struct Layer
+    {
+        ParticleLayerSettings settings;
+        std::vector<float> positionX, positionY, positionZ;
+        std::vector<float> velocityX, velocityY, velocityZ;
+        std::vector<float> age, invLife; // Âge et inverse de la durée de vie (t = age * invLife dans [0, 1])
+        size_t count;
+        float pending; // Particules à émettre (partie fractionnaire du débit des images précédentes)
+    };
+
+    float random(); // Nombre aléatoire dans [0, 1[ (xorshift, propre à l'émetteur)
+    void emit(Layer& layer, float deltaTime); // Nouvelles particules de l'image
+    float integrate(Layer& layer, float deltaTime); // Avancer les particules (SIMD), somme des 1 - t des vivantes
+    void removeDead(Layer& layer); // Retirer les particules arrivées en fin de vie
+
+    glm::vec3 mPosition;
+    uint32_t mRandom;
+    std::vector<Layer> mLayers;
+    float mLight;
+};
+
+#endif // PARTICLE_EMITTER_HPP
@@ -0,0 +1,174 @@
+#include "ParticleSystem.hpp"
+#include <cstddef>
+
+// Attente maximale de la fin de lecture d'une région par le GPU (nanosecondes)
+static const GLuint64 FENCE_TIMEOUT = 1000000000;
+
+
+ParticleSystem::ParticleSystem() : mCapacity(0), mParticleCount(0), mJobs(nullptr), mMapped(nullptr), mRegion(0), mVAO(0), mVBO(0)
+{
+    for(int r = 0; r < REGIONS; r = r + 1)
+    {
+        mFences[r] = 0;
+    }
+}
+
+ParticleSystem::~ParticleSystem()
+{
+    for(int r = 0; r < REGIONS; r = r + 1)
+    {
+        if(mFences[r] != 0)
+        {
+            glDeleteSync(mFences[r]);
+        }
+    }
+    if(mMapped != nullptr)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    glDeleteVertexArrays(1, &mVAO);
+    glDeleteBuffers(1, &mVBO);
+}
+
+size_t ParticleSystem::addEmitter(const ParticleEmitter& emitter)
+{
+    mEmitters.push_back(emitter);
+    return mEmitters.size() - 1;
+}
+
+// Chaque émetteur reçoit une plage de sa capacité : les écritures des threads ne se chevauchent jamais
+void ParticleSystem::init(JobSystem& jobs)
+{
+    mJobs = &jobs;
+    mFirst.resize(mEmitters.size());
+    mCounts.assign(mEmitters.size(), 0);
+    mCapacity = 0;
+    for(size_t e = 0; e < mEmitters.size(); e = e + 1)
+    {
+        mFirst[e] = mCapacity;
+        mCapacity = mCapacity + mEmitters[e].getCapacity();
+    }
+    if(mCapacity == 0)
+    {
+        return;
+    }
+
+    // Quads instanciés : les coins sont générés dans le shader, seuls les attributs d'instance viennent du VBO
+    glGenVertexArrays(1, &mVAO);
+    glGenBuffers(1, &mVBO);
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    if(GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr size = REGIONS * mCapacity * sizeof(ParticleInstance);
+        glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+        mMapped = (ParticleInstance*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+    }
+    if(mMapped == nullptr)
+    {
+        mStaging.resize(mCapacity);
+        glBufferData(GL_ARRAY_BUFFER, mCapacity * sizeof(ParticleInstance), NULL, GL_STREAM_DRAW);
+    }
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Pas de baseInstance en OpenGL 3.3 : le décalage de l'émetteur passe par les pointeurs d'attributs
+void ParticleSystem::bindInstances(size_t first)
+{
+    size_t base = first * sizeof(ParticleInstance);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (GLvoid*)(base + offsetof(ParticleInstance, position)));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (GLvoid*)(base + offsetof(ParticleInstance, color)));
+}
+
+// Région suivante du buffer persistant (après la fin de sa lecture par le GPU, REGIONS images plus tôt) ou copie
+// envoyée ensuite par glBufferSubData ; chaque thread met à jour ses émetteurs et écrit leurs particules
+void ParticleSystem::update(float deltaTime)
+{
+    ParticleInstance* out = mStaging.data();
+    if(mMapped != nullptr)
+    {
+        mRegion = (mRegion + 1) % REGIONS;
+        if(mFences[mRegion] != 0)
+        {
+            glClientWaitSync(mFences[mRegion], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+            glDeleteSync(mFences[mRegion]);
+            mFences[mRegion] = 0;
+        }
+        out = mMapped + mRegion * mCapacity;
+    }
+
+    mJobs->run(mEmitters.size(), [&](size_t e)
+    {
+        mEmitters[e].update(deltaTime);
+        mCounts[e] = out != nullptr ? (GLsizei)mEmitters[e].writeInstances(out + mFirst[e]) : 0;
+    });
+
+    mParticleCount = 0;
+    for(GLsizei count : mCounts)
+    {
+        mParticleCount = mParticleCount + count;
+    }
+    if(mVBO == 0)
+    {
+        return;
+    }
+
+    if(mMapped == nullptr)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+        glBufferData(GL_ARRAY_BUFFER, mCapacity * sizeof(ParticleInstance), NULL, GL_STREAM_DRAW); // Orphelin : pas d'attente du GPU
+        for(size_t e = 0; e < mEmitters.size(); e = e + 1)
+        {
+            if(mCounts[e] > 0)
+            {
+                glBufferSubData(GL_ARRAY_BUFFER, mFirst[e] * sizeof(ParticleInstance), mCounts[e] * sizeof(ParticleInstance), &mStaging[mFirst[e]]);
+            }
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
+
+// Un quad de 4 sommets par particule, un appel par émetteur ; mélange prémultiplié (alpha 0 : additif)
+// sans écriture de profondeur, les particules étant dessinées après la scène opaque
+void ParticleSystem::draw(ShaderProgram& shader)
+{
+    if(mParticleCount == 0)
+    {
+        return;
+    }
+
+    shader.use();
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+
+    size_t base = mMapped != nullptr ? mRegion * mCapacity : 0;
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    for(size_t e = 0; e < mEmitters.size(); e = e + 1)
+    {
+        if(mCounts[e] > 0)
+        {
+            bindInstances(base + mFirst[e]);
+            glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, mCounts[e]);
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+
+    if(mMapped != nullptr)
+    {
+        mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef PARTICLE_SYSTEM_HPP
+#define PARTICLE_SYSTEM_HPP
+
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "ParticleEmitter.hpp"
+#include "JobSystem.hpp"
+
+#define GLEW_STATIC
+
+// Particules de la scène : chaque émetteur est mis à jour sur l'un des threads permanents puis y écrit ses
+// particules dans le buffer d'instances, dans une plage fixe (sa capacité), et chacun est dessiné en un seul
+// appel instancié de quads face à la caméra. Avec OpenGL 4.4 (ou ARB_buffer_storage), le buffer est mappé
+// une fois pour toutes (persistant, cohérent) et découpé en REGIONS régions utilisées tour à tour : une
+// barrière posée après les dessins d'une région garantit que le GPU a fini de la lire avant qu'elle soit
+// réécrite. Sinon, les instances passent par une copie en mémoire et glBufferSubData (buffer orphelin).
+class ParticleSystem
+{
+public:
+    static const int REGIONS = 3; // Images en vol au plus avec le buffer persistant
+
+    ParticleSystem();
+    ~ParticleSystem();
+
+    size_t addEmitter(const ParticleEmitter& emitter); // Ajouter un émetteur avant init (renvoie son indice)
+    ParticleEmitter& getEmitter(size_t index) { return mEmitters[index]; }
+    size_t getEmitterCount() const { return mEmitters.size(); }
+
+    void init(JobSystem& jobs); // Threads de mise à jour, plages des émetteurs et buffer d'instances
+    void update(float deltaTime); // Mettre à jour les émetteurs et écrire leurs instances
+    void draw(ShaderProgram& shader); // Dessiner les particules (view et projection fixées par l'appelant, profondeur déjà écrite)
+
+    size_t getParticleCount() const { return mParticleCount; } // Particules vivantes
+    bool isPersistent() const { return mMapped != nullptr; } // Buffer mappé de façon persistante
+
+private:
+    void bindInstances(size_t first); // Pointer les attributs d'instance du VAO sur l'instance first
+
+    std::vector<ParticleEmitter> mEmitters;
+    std::vector<size_t> mFirst; // Première instance de chaque émetteur dans une région
+    std::vector<GLsizei> mCounts; // Instances écrites par chaque émetteur dans l'image
+    size_t mCapacity; // Instances par région (somme des capacités des émetteurs)
+    size_t mParticleCount;
+    JobSystem* mJobs; // Mise à jour et écriture des émetteurs
+
+    ParticleInstance* mMapped; // Buffer persistant (REGIONS régions), nullptr sinon
+    int mRegion; // Région de l'image
+    GLsync mFences[REGIONS]; // Fin de lecture de chaque région par le GPU (0 : libre)
+    std::vector<ParticleInstance> mStaging; // Instances de l'image sans buffer persistant
+    GLuint mVAO, mVBO;
+};
+
+#endif // PARTICLE_SYSTEM_HPP
@@ -0,0 +1,170 @@
+#include <algorithm>
+
+#include "RenderQueue.hpp"
+
+
+// Construire une clé de tri (profondeur entre 0 et 1)
+uint64_t RenderQueue::makeKey(uint32_t pass, uint32_t shader, uint32_t texture, uint32_t mesh, float depth)
+{
+    uint64_t depthBits = (uint64_t)(glm::clamp(depth, 0.0f, 1.0f) * 4294967040.0f); // Plus grand flottant sous 2^32
+
+    return ((uint64_t)(pass & 0xF) << 60)
+         | ((uint64_t)(shader & 0xF) << 56)
+         | ((uint64_t)(texture & 0xFFF) << 44)
+         | ((uint64_t)(mesh & 0xFFF) << 32)
+         | depthBits;
+}
+
+// Vider la file et les compteurs
+void RenderQueue::clear()
+{
+    mCommands.clear();
+    mItems.clear();
+    mStateChanges = 0;
+    mStateChangesAvoided = 0;
+}
+
+// Ajouter une commande
+void RenderQueue::submit(uint64_t key, const RenderCommand& command)
+{
+    SortItem item;
+    item.key = key;
+    item.command = (uint32_t)mCommands.size();
+
+    mCommands.push_back(command);
+    mItems.push_back(item);
+}
+
+// Tri par base sur les 8 octets de la clé, de l'octet de poids faible au plus fort (stable).
+// Les histogrammes des 8 octets sont calculés en une seule lecture ; un octet identique
+// pour toutes les clés ne demande aucun passage.
+void RenderQueue::sort()
+{
+    size_t count = mItems.size();
+    if(count < 2)
+    {
+        return;
+    }
+
+    size_t histograms[8][256] = {};
+    for(size_t i = 0; i < count; i = i + 1)
+    {
+        uint64_t key = mItems[i].key;
+        for(int b = 0; b < 8; b = b + 1)
+        {
+            histograms[b][(key >> (b * 8)) & 0xFF] = histograms[b][(key >> (b * 8)) & 0xFF] + 1;
+        }
+    }
+
+    mScratch.resize(count);
+    for(int b = 0; b < 8; b = b + 1)
+    {
+        size_t* histogram = histograms[b];
+        if(histogram[(mItems[0].key >> (b * 8)) & 0xFF] == count)
+        {
+            continue; // Octet identique pour toutes les clés
+        }
+
+        // Positions de départ de chaque valeur
+        size_t offset = 0;
+        for(int v = 0; v < 256; v = v + 1)
+        {
+            size_t n = histogram[v];
+            histogram[v] = offset;
+            offset = offset + n;
+        }
+
+        for(size_t i = 0; i < count; i = i + 1)
+        {
+            size_t& position = histogram[(mItems[i].key >> (b * 8)) & 0xFF];
+            mScratch[position] = mItems[i];
+            position = position + 1;
+        }
+        mItems.swap(mScratch);
+    }
+}
+
+// Exécuter les commandes d'une passe (contiguës après le tri)
+void RenderQueue::execute(uint32_t pass, const InstanceBuffer& instances)
+{
+    auto byKey = [](const SortItem& item, uint64_t key) { return item.key < key; };
+    auto first = std::lower_bound(mItems.begin(), mItems.end(), (uint64_t)pass << 60, byKey);
+    auto last = std::lower_bound(first, mItems.end(), (uint64_t)(pass + 1) << 60, byKey);
+
+    // L'état GL a pu changer entre deux passes : le premier dessin lie tout
+    ShaderProgram* currentShader = nullptr;
+    Texture2D* currentTexture = nullptr;
+    GLuint currentVAO = 0;
+
+    for(auto it = first; it != last; ++it)
+    {
+        const RenderCommand& command = mCommands[it->command];
+        GLsizei vertexCount = command.mesh->getVertexCount();
+        if(vertexCount == 0)
+        {
+            continue;
+        }
+
+        // Shader
+        if(command.shader != currentShader)
+        {
+            glUseProgram(command.shader->getProgram());
+            currentShader = command.shader;
+            mStateChanges = mStateChanges + 1;
+        }
+        else
+        {
+            mStateChangesAvoided = mStateChangesAvoided + 1;
+        }
+
+        // Texture
+        if(command.texture != nullptr && command.texture != currentTexture)
+        {
+            command.texture->bind(0);
+            currentTexture = command.texture;
+            mStateChanges = mStateChanges + 1;
+        }
+        else if(command.texture != nullptr)
+        {
+            mStateChangesAvoided = mStateChangesAvoided + 1;
+        }
+
+        // Géométrie
+        GLuint vao = command.mesh->getVertexArray(command.depthOnly);
+        if(vao != currentVAO)
+        {
+            command.mesh->bindVertexArray(command.depthOnly);
+            currentVAO = vao;
+            mStateChanges = mStateChanges + 1;
+        }
+        else
+        {
+            mStateChangesAvoided = mStateChangesAvoided + 1;
+        }
+
+        // Rendu conditionnel : le GPU saute le dessin si la requête n'a vu aucun pixel (sans attendre un résultat absent)
+        if(command.condition != 0)
+        {
+            glBeginConditionalRender(command.condition, GL_QUERY_NO_WAIT);
+        }
+
+        // Dessin instancié (les attributs d'instance sont repointés à chaque dessin) ou simple
+        if(command.instanceCount > 0)
+        {
+            instances.bindAttributes(command.firstInstance);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, vertexCount, command.instanceCount);
+        }
+        else
+        {
+            command.shader->setUniform("model", command.model);
+            glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+        }
+
+        if(command.condition != 0)
+        {
+            glEndConditionalRender();
+        }
+    }
+
+    glBindVertexArray(0);
+}
@@ -0,0 +1,71 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Texture2D.hpp"
+#include "Mesh.hpp"
+#include "InstanceBuffer.hpp"
+
+#define GLEW_STATIC
+
+// Commande de dessin de la file de rendu
+struct RenderCommand
+{
+    ShaderProgram* shader; // Programme de shader
+    Texture2D* texture; // Texture diffuse (nullptr : pas de texture, passes de profondeur)
+    const Mesh* mesh; // Géométrie
+    bool depthOnly; // Dessiner avec le VAO des positions seules
+    GLuint firstInstance; // Première instance dans le buffer d'instances
+    GLsizei instanceCount; // Nombre d'instances (0 : dessin simple avec la matrice model)
+    glm::mat4 model; // Matrice de modèle des dessins simples
+    GLuint condition; // Requête d'occlusion du rendu conditionnel (0 : toujours dessiné)
+};
+
+// File de rendu : les commandes sont soumises avec une clé de tri 64 bits, triées par base (radix)
+// une fois par image puis exécutées passe par passe sans répéter les changements d'état inutiles.
+// Clé, des bits de poids fort aux bits de poids faible :
+//  passe (4) | shader (4) | texture (12) | mesh (12) | profondeur (32, de l'avant vers l'arrière)
+// Texture et mesh sont des index denses (modèle, lot) et non des noms OpenGL, qui ne sont pas bornés à 12 bits.
+class RenderQueue
+{
+public:
+    // Passes, dans l'ordre de tri
+    enum Pass
+    {
+        PASS_SHADOW = 0, // Cascades d'ombre : PASS_SHADOW + index de la cascade
+        PASS_GEOMETRY = 4, // Passe géométrique du rendu différé
+        PASS_GEOMETRY_CONDITIONAL = 5, // Objets cachés à l'image précédente (après les requêtes d'occlusion)
+        PASS_FORWARD = 6, // Rendu direct
+        PASS_FORWARD_CONDITIONAL = 7 // Objets cachés à l'image précédente (après les requêtes d'occlusion)
+    };
+
+    static uint64_t makeKey(uint32_t pass, uint32_t shader, uint32_t texture, uint32_t mesh, float depth); // Construire une clé de tri (profondeur entre 0 et 1)
+
+    void clear(); // Vider la file et les compteurs
+    void submit(uint64_t key, const RenderCommand& command); // Ajouter une commande
+    void sort(); // Trier les commandes par clé
+    void execute(uint32_t pass, const InstanceBuffer& instances); // Exécuter les commandes d'une passe
+
+    size_t getCommandCount() const { return mCommands.size(); } // Commandes de l'image
+    int getStateChanges() const { return mStateChanges; } // Changements de shader, texture ou VAO effectués
+    int getStateChangesAvoided() const { return mStateChangesAvoided; } // Changements évités grâce au tri
+
+private:
+    struct SortItem
+    {
+        uint64_t key; // Clé de tri
+        uint32_t command; // Index de la commande
+    };
+
+    std::vector<RenderCommand> mCommands; // Commandes dans l'ordre de soumission
+    std::vector<SortItem> mItems, mScratch; // Clés à trier et tampon du tri
+    int mStateChanges = 0;
+    int mStateChangesAvoided = 0;
+};
+
+#endif // RENDER_QUEUE_HPP
@@ -1,6 +1,12 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <thread>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
@@ -13,177 +19,1275 @@
 #include "Display.hpp"
 #include "Models.hpp"
 #include "Lights.hpp"
+#include "GBuffer.hpp"
+#include "GpuTimer.hpp"
+#include "Bounds.hpp"
+#include "ShadowMaps.hpp"
+#include "LightBaker.hpp"
+#include "ShadingLod.hpp"
+#include "InstanceBuffer.hpp"
+#include "RenderQueue.hpp"
+#include "TransformStore.hpp"
+#include "SpatialIndex.hpp"
+#include "OcclusionCuller.hpp"
+#include "OcclusionQueries.hpp"
+#include "Impostors.hpp"
+#include "ForestHlod.hpp"
+#include "GpuScene.hpp"
+#include "EntityStore.hpp"
+#include "SceneFile.hpp"
+#include "ForestGenerator.hpp"
+#include "WorldStreamer.hpp"
+#include "StaticBatcher.hpp"
+#include "Heightfield.hpp"
+#include "Terrain.hpp"
+#include "GrassField.hpp"
+#include "ParticleSystem.hpp"
+#include "BirdFlock.hpp"
 
 #define GLEW_STATIC
 
 FPSCamera fpsCamera(glm::vec3(0.0f, 1.5f, 10.0f));
 ShaderProgram lightingShader;
+ShaderProgram lightingGouraudShader; // Niveau d'ombrage GOURAUD : éclairage par sommet
+ShaderProgram lightingSunShader; // Niveau d'ombrage SUN_ONLY : soleil et ambiant seulement
+ShaderProgram gbufferShader; // Passe géométrique du rendu différé
+ShaderProgram deferredShader; // Passe d'éclairage du rendu différé
+ShaderProgram shadowShader; // Passe de profondeur des ombres
+ShaderProgram occlusionBoxShader; // Boîtes des requêtes d'occlusion
+ShaderProgram impostorBakeShader; // Précalcul des atlas d'imposteurs
+ShaderProgram impostorShader; // Imposteurs en rendu direct
+ShaderProgram impostorGBufferShader; // Imposteurs dans la passe géométrique du rendu différé
+ShaderProgram hlodShader; // Proxys des cellules lointaines en rendu direct
+ShaderProgram hlodGBufferShader; // Proxys des cellules lointaines dans la passe géométrique du rendu différé
+ShaderProgram gpuCullShader; // Élimination des instances sur le GPU (compute shader)
+ShaderProgram gpuSceneShader; // Scène dessinée par le GPU
+ShaderProgram terrainShader; // Terrain en rendu direct
+ShaderProgram terrainGBufferShader; // Terrain dans la passe géométrique du rendu différé
+ShaderProgram grassShader; // Herbe en rendu direct
+ShaderProgram grassGBufferShader; // Herbe dans la passe géométrique du rendu différé
+ShaderProgram birdShader; // Oiseaux en rendu direct
+ShaderProgram birdGBufferShader; // Oiseaux dans la passe géométrique du rendu différé
+ShaderProgram particleShader; // Particules des feux (après la scène opaque, dans les deux modes de rendu)
 Display display(fpsCamera);
 Models models;
 Lights lights(fpsCamera, display);
+GBuffer gbuffer;
+GpuTimer forwardTimer; // Temps GPU du rendu direct
+GpuTimer deferredTimer; // Temps GPU du rendu différé
+ShadowMaps shadowMaps; // Ombres du soleil par cascades
+GpuTimer shadowTimers[ShadowMaps::CASCADE_COUNT]; // Temps GPU de chaque cascade
+LightBaker lightBaker; // Éclairage statique précalculé (occlusion ambiante, soleil et lampes)
+ShadingLod shadingLod; // Niveau d'ombrage de chaque objet selon sa distance
+OcclusionCuller occlusionCuller; // Élimination des objets cachés par les bâtiments et les arbres proches
+OcclusionQueries occlusionQueries; // Requêtes d'occlusion GPU des modèles lourds et des groupes d'objets
+Impostors impostors; // Imposteurs octaédriques des arbres lointains
+ForestHlod forestHlod; // Proxys fusionnés des cellules lointaines de la forêt
+GpuScene gpuScene; // Instances éliminées et dessinées par le GPU (OpenGL 4.3)
+WorldStreamer worldStreamer; // Monde au-delà de la forêt du village, chargé par morceaux autour de la caméra
+StaticBatcher staticBatcher; // Objets statiques du village fusionnés en lots pré-transformés
+std::vector<std::unique_ptr<Mesh>> batchMeshes; // Sommets de chaque lot sur le GPU
+ShadingLod batchLod; // Niveau d'ombrage de chaque lot statique
+Heightfield heightfield; // Relief du sol : hauteurs du terrain, de la végétation et de la caméra
+Terrain terrain; // Terrain CDLOD autour de la caméra
+GrassField grass; // Herbe instanciée autour de la caméra
+JobSystem jobSystem; // Threads permanents des calculs de chaque image (particules, oiseaux)
+ParticleSystem particles; // Flammes, fumée et braises des feux de camp
+BirdFlock birds; // Nuée d'oiseaux au-dessus du village
 
-// Structure pour stocker la vegetation
-struct SceneObject {
+// Shader du rendu direct pour chaque niveau d'ombrage
+ShaderProgram* shadingShaders[ShadingLod::LEVEL_COUNT] = { &lightingShader, &lightingGouraudShader, &lightingSunShader };
+
+// Distances de changement de niveau d'ombrage et marge d'hystérésis
+const float GOURAUD_DISTANCE = 40.0f;
+const float SUN_ONLY_DISTANCE = 90.0f;
+const float SHADING_HYSTERESIS = 5.0f;
+
+// Distance des imposteurs : les arbres passent du maillage à l'imposteur par un fondu tramé sur IMPOSTOR_FADE_BAND
+const float IMPOSTOR_DISTANCE = 60.0f;
+const float IMPOSTOR_FADE_BAND = 6.0f;
+
+// Niveaux de détail hiérarchiques : au-delà de HLOD_DISTANCE, les arbres d'une cellule sont remplacés par son proxy
+const float HLOD_DISTANCE = 100.0f;
+const float HLOD_HYSTERESIS = 10.0f;
+const float HLOD_CELL_SIZE = 40.0f;
+
+// Monde par morceaux : chargés un peu avant d'entrer dans le plan lointain (200), déchargés au-delà de la marge
+const float STREAM_CHUNK_SIZE = 100.0f;
+const float STREAM_LOAD_DISTANCE = 250.0f;
+const float STREAM_HYSTERESIS = 50.0f;
+const size_t STREAM_MEMORY_BUDGET = 4 << 20; // Octets d'instances résidentes
+const float RESIDENT_HALF_SIZE = 152.0f; // Demi-côté de la forêt du village (scène fixe)
+
+// Relief : plat sous le village, collines au-delà (mêmes hauteurs pour le rendu et les requêtes)
+const float TERRAIN_FLAT_RADIUS = 60.0f;
+const float TERRAIN_BLEND_DISTANCE = 100.0f;
+const float TERRAIN_AMPLITUDE = 24.0f;
+
+// Herbe : pleine densité près de la caméra, de plus en plus clairsemée jusqu'à GRASS_DISTANCE, touffes dessinées par image au plus
+const float GRASS_FADE_START = 15.0f;
+const float GRASS_DISTANCE = 60.0f;
+const size_t GRASS_INSTANCE_BUDGET = 24000;
+
+// Feux de camp : hauteur des émetteurs au-dessus du sol et lumière du feu selon les flammes (intensité de 1 en moyenne)
+const float FIRE_EMITTER_HEIGHT = 0.15f;
+const float FIRE_INTENSITY_SCALE = 0.75f;
+
+// Oiseaux : nuée au-dessus du village et de la forêt proche, au-dessus des arbres des collines
+const size_t BIRD_COUNT = 2000;
+const float BIRD_FLIGHT_RADIUS = 120.0f;
+const float BIRD_MIN_HEIGHT = 35.0f;
+const float BIRD_MAX_HEIGHT = 60.0f;
+
+// Lots statiques : une cellule par lot et par texture (assez petite pour éliminer les lots hors champ)
+const float BATCH_CELL_SIZE = 20.0f;
+
+// Graine de la forêt procédurale autour du village
+const uint32_t FOREST_SEED = 2024;
+
+// Lumières ponctuelles de la scène (lues dans le fichier de scène, POINT_LIGHTS dans les shaders)
+const size_t MAX_POINT_LIGHTS = 3;
+std::vector<SceneLight> sceneLights;
+uint32_t staticLampMask = 0; // Lampes fixes : précalculées, retirées des masques des objets précalculés
+
+// Objets de la scène (village, animaux, accessoires et végétation) en SoA, triés selon la courbe de Morton.
+// L'index d'un objet dans ce stockage est aussi son index dans toutes les listes par objet ci-dessous.
+EntityStore sceneEntities;
+std::vector<EntityId> villageEntities; // Objets lus dans le fichier de scène (candidats aux lots statiques)
+
+// Transformations des objets (même index que sceneEntities, matrices en cache)
+TransformStore sceneTransforms;
+
+// Lumières ponctuelles qui touchent chaque objet (les boîtes englobantes sont dans sceneEntities)
+std::vector<uint32_t> sceneLightMasks;
+
+// Index spatial des objets (quadtree lâche sur XZ, la forêt va de -150 à 150)
+SpatialIndex sceneIndex;
+
+// Objets dans la pyramide de vue de l'image (1 : visible)
+std::vector<uint8_t> sceneVisible;
+std::vector<uint32_t> visibleObjects;
+
+// Lots statiques visibles dans l'image et nombre de lots dessinés
+std::vector<uint8_t> batchVisible;
+size_t batchDrawCount = 0;
+
+// Instance de chaque objet (matrices calculées une fois, reprises quand un objet est déplacé)
+std::vector<InstanceData> sceneInstances;
+
+// Objets de la scène regroupés par modèle (index dans sceneEntities)
+struct ModelGroup
+{
+    ModelHandle model;
+    const Mesh* mesh;
+    Texture2D* texture;
+    std::vector<size_t> objects;
+};
+std::vector<ModelGroup> modelGroups;
+
+InstanceBuffer instanceBuffer;
+std::vector<GLuint> sceneSlots; // Emplacement fixe de chaque objet dans le buffer d'instances (objets d'un groupe consécutifs)
+GLuint batchSlots = 0; // Premier emplacement des lots statiques (un par lot, après ceux des objets)
+RenderQueue renderQueue; // Commandes de dessin de l'image, triées par clé
+const float SORT_DEPTH_RANGE = 200.0f; // Distance ramenée à 1 dans les clés de tri (plan lointain)
+
+// Boîte occultante d'un modèle : partie de sa boîte locale toujours pleine (fractions de la boîte)
+struct OccluderProxy
+{
     std::string name;
-    glm::vec3 position;
-    glm::vec3 rotation;
+    glm::vec3 minFraction;
+    glm::vec3 maxFraction;
 };
 
-// Vecteur pour stocker la vegetation
-std::vector<SceneObject> vegetation;
+// Boîte occultante d'un objet de la scène, coins en monde (objets statiques : calculés une fois)
+struct SceneOccluder
+{
+    uint32_t object;
+    glm::vec3 corners[8];
+};
+std::vector<SceneOccluder> sceneOccluders;
+const float OCCLUDER_DISTANCE = 60.0f; // Au-delà, un occultant couvre trop peu de pixels pour être utile
+
+// Élément de requête d'occlusion de chaque objet : un par modèle lourd, sinon un par cellule de la grille
+std::vector<uint32_t> sceneQueryItems;
+const uint32_t NO_QUERY_ITEM = 0xFFFFFFFF;
+const GLsizei HEAVY_VERTEX_COUNT = 4500; // Sommets à partir desquels un modèle a sa propre requête
+const float QUERY_CELL_SIZE = 20.0f; // Côté des cellules qui regroupent les autres objets
+const int QUERY_GRID_SIZE = 16; // Cellules par côté (de -160 à 160)
+
+// Couche d'atlas d'imposteur de chaque modèle (-1 : pas d'imposteur), sphère englobante en monde
+// de chaque objet et fondu de l'image (0 : maillage seul, 1 : imposteur seul)
+std::vector<int> impostorLayers;
+std::vector<glm::vec4> sceneImpostorSpheres;
+std::vector<float> sceneLodFade;
+
+// Requête du rendu conditionnel de chaque objet dans l'image (0 : dessin normal) et éléments dans la vue
+std::vector<GLuint> sceneConditions;
+std::vector<uint8_t> queryItemsInView;
+
+// Fonction pour charger la scène du village (objets et lumières) depuis son fichier binaire,
+// recompilé depuis la forme texte si elle a changé
+bool loadSceneFile(const std::string& textFilename, const std::string& binaryFilename)
+{
+    auto loadStart = std::chrono::high_resolution_clock::now();
+
+    if (!SceneFile::isUpToDate(textFilename, binaryFilename) && !SceneFile::compile(textFilename, binaryFilename))
+    {
+        return false;
+    }
+
+    SceneFile file;
+    if (!file.open(binaryFilename))
+    {
+        std::cerr << "Impossible de charger la scene : " << binaryFilename << std::endl;
+        return false;
+    }
+
+    // Table des modèles du fichier convertie en identifiants, une fois par modèle
+    std::vector<ModelHandle> fileModels;
+    for (uint32_t m = 0; m < file.getModelCount(); m++)
+    {
+        fileModels.push_back(models.findModel(file.getModelName(m)));
+    }
+
+    std::vector<glm::vec3> modelScales;
+    for (ModelHandle model = 0; model < models.getModelCount(); model++)
+    {
+        modelScales.push_back(models.getScale(model));
+    }
+
+    // Colonnes du fichier copiées dans le stockage des objets (seuls les modèles sont convertis)
+    std::vector<ModelHandle> entityModels(file.getEntityCount());
+    const uint32_t* fileEntityModels = file.getEntityModels();
+    for (size_t i = 0; i < entityModels.size(); i++)
+    {
+        entityModels[i] = fileModels[fileEntityModels[i]];
+    }
+    size_t firstEntity = sceneEntities.size();
+    sceneEntities.addBatch(entityModels.size(), entityModels.data(), file.getPositionsX(), file.getPositionsY(), file.getPositionsZ(), file.getYaws(), file.getFlags(), modelScales);
+    for (size_t i = firstEntity; i < sceneEntities.size(); i++)
+    {
+        villageEntities.push_back(sceneEntities.getId((uint32_t)i));
+    }
 
-// Fonction pour initialiser la végétation
+    sceneLights.assign(file.getLights(), file.getLights() + file.getLightCount());
+    if (sceneLights.size() > MAX_POINT_LIGHTS)
+    {
+        std::cerr << "La scene a " << sceneLights.size() << " lumieres, seules les " << MAX_POINT_LIGHTS << " premieres sont utilisees" << std::endl;
+        sceneLights.resize(MAX_POINT_LIGHTS);
+    }
+
+    // Lampes fixes : précalculées avec les objets statiques
+    staticLampMask = 0;
+    for (size_t l = 0; l < sceneLights.size(); l++)
+    {
+        if (sceneLights[l].type == SceneLight::LAMP)
+        {
+            staticLampMask = staticLampMask | (1u << l);
+        }
+    }
+
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - loadStart).count();
+    std::cout << "Scene chargee : " << file.getEntityCount() << " objets, " << sceneLights.size() << " lumieres en " << loadMs << " ms" << std::endl;
+    return true;
+}
+
+// Fonction pour initialiser le relief et le terrain qui l'affiche (texture du sol), avant les objets posés dessus
+void initializeTerrain()
+{
+    HeightfieldSettings settings;
+    settings.seed = FOREST_SEED;
+    settings.amplitude = TERRAIN_AMPLITUDE;
+    settings.flatRadius = TERRAIN_FLAT_RADIUS;
+    settings.blendDistance = TERRAIN_BLEND_DISTANCE;
+    heightfield = Heightfield(settings);
+
+    terrain.init(heightfield, models.getTexture(models.findModel("sol")));
+    display.setGround(&heightfield);
+}
+
+// Fonction pour initialiser les objets de la scène : village lu dans le fichier de scène, puis forêt générée autour
 void initializeSceneObjects() 
 {
+    sceneEntities.clear();
+    villageEntities.clear();
+    if (!loadSceneFile("Scenes/village.scene", "village.rscn"))
+    {
+        std::cerr << "Scene du village indisponible, foret seule" << std::endl;
+    }
+
+    // Forêt générée autour du village (même graine, même forêt)---
+    ForestSettings forest;
+    forest.seed = FOREST_SEED;
+    forest.worldMin = glm::vec2(-RESIDENT_HALF_SIZE);
+    forest.worldSize = 2.0f * RESIDENT_HALF_SIZE;
+    forest.minDistance = 5.0f;
+    forest.candidateDensity = 0.03f;
+
+    // 80 % d'arbres, 20 % d'autre végétation
+    forest.species = {
+        { models.findModel("sapin"), 8.0f }, { models.findModel("pin"), 8.0f }, { models.findModel("chene"), 8.0f },
+        { models.findModel("arbuste"), 2.0f }, { models.findModel("tronc1"), 2.0f }, { models.findModel("pomme_pin"), 2.0f }
+    };
+
+    // Clairière du village, puis forêt dense
+    forest.densities = { { 28.0f, 0.0f }, { 36.0f, 1.0f } };
+
+    auto forestStart = std::chrono::high_resolution_clock::now();
+    ForestGenerator generator(forest);
+    std::vector<ForestInstance> instances = generator.generate((int)glm::clamp(std::thread::hardware_concurrency(), 1u, 8u));
+    for (const ForestInstance& instance : instances)
+    {
+        // Posé sur le relief
+        glm::vec3 position = instance.position;
+        position.y = heightfield.getHeight(position.x, position.z);
+        sceneEntities.add(instance.model, position, instance.yaw, models.getScale(instance.model), EntityStore::STATIC | EntityStore::CAST_SHADOW);
+    }
+
+    double forestMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - forestStart).count();
+    std::cout << "Foret generee : " << instances.size() << " objets en " << forestMs << " ms" << std::endl;
+
+    // Objets proches dans la scène rangés côte à côte en mémoire (même étendue que l'index spatial)
+    sceneEntities.sortMorton(glm::vec2(-160.0f, -160.0f), 320.0f);
+}
+
+// Fonction pour calculer les matrices de modèle des objets (objets statiques : une seule fois)
+void initializeSceneTransforms()
+{
+    sceneTransforms.clear();
+    sceneEntities.forEachBatch(64, [](uint32_t first, uint32_t last)
+    {
+        for (uint32_t i = first; i < last; i++)
+        {
+            sceneTransforms.add(sceneEntities.getPosition(i), sceneEntities.getYaw(i), sceneEntities.getScale(i), (sceneEntities.getFlags(i) & EntityStore::STATIC) != 0);
+        }
+    });
+    sceneTransforms.update();
+}
+
+// Fonction pour calculer les boîtes englobantes des objets (objets statiques : une seule fois)
+void initializeSceneBounds()
+{
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        const Mesh* mesh = models.getMesh(sceneEntities.getModel(i));
+        sceneEntities.setBounds(i, mesh != nullptr ? transformAABB(mesh->getBounds(), sceneTransforms.getWorld(i)) : AABB());
+    }
+
+    sceneIndex.init(glm::vec2(-160.0f, -160.0f), 320.0f, 7);
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        sceneIndex.insert((uint32_t)i, sceneEntities.getBounds().get(i));
+    }
+}
+
+// Fonction pour préparer les instances des objets et les regrouper par modèle
+void initializeSceneInstances()
+{
+    std::vector<size_t> groupIndices(models.getModelCount(), SIZE_MAX); // Groupe de chaque modèle
+
+    sceneInstances.clear();
+    modelGroups.clear();
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        ModelHandle model = sceneEntities.getModel(i);
+        const TransformMatrices& matrices = sceneTransforms.getMatrices(i);
+        sceneInstances.push_back(InstanceBuffer::makeInstance(matrices.world, matrices.normal));
+
+        if (!models.isValid(model))
+        {
+            continue;
+        }
+
+        if (groupIndices[model] == SIZE_MAX)
+        {
+            groupIndices[model] = modelGroups.size();
+            modelGroups.push_back({ model, models.getMesh(model), models.getTexture(model), {} });
+        }
+        modelGroups[groupIndices[model]].objects.push_back(i);
+    }
+
+    // Emplacements dans l'ordre des groupes : les objets visibles d'un groupe forment des plages à dessiner
+    sceneSlots.assign(sceneEntities.size(), UINT32_MAX);
+    GLuint slot = 0;
+    for (const auto& group : modelGroups)
+    {
+        for (size_t i : group.objects)
+        {
+            sceneSlots[i] = slot;
+            slot = slot + 1;
+        }
+    }
+    batchSlots = slot;
+    instanceBuffer.resize(batchSlots);
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        if (sceneSlots[i] != UINT32_MAX)
+        {
+            instanceBuffer.set(sceneSlots[i], sceneInstances[i]);
+        }
+    }
+}
+
+// Fonction pour reprendre les matrices des objets déplacés depuis l'image précédente
+void updateSceneInstances()
+{
+    if (sceneTransforms.update() == 0)
+    {
+        return;
+    }
+
+    for (uint32_t i : sceneTransforms.getUpdated())
+    {
+        const TransformMatrices& matrices = sceneTransforms.getMatrices(i);
+        sceneInstances[i].model = matrices.world;
+        for (int c = 0; c < 3; c++)
+        {
+            sceneInstances[i].normalMatrix[c] = matrices.normal[c];
+        }
+    }
+}
+
+// Fonction pour mettre à jour l'emplacement d'un objet dans le buffer d'instances (renvoie l'emplacement)
+// Seuls les emplacements dont le contenu change (matrices, lumières, fondu) sont renvoyés au GPU
+GLuint updateSceneInstance(size_t i, int level, bool forward, bool bakedLighting)
+{
+    InstanceData instance = sceneInstances[i];
+    instance.lodFade = sceneLodFade[i];
+    if (forward)
+    {
+        // Le niveau SUN_ONLY n'utilise pas les lumières ponctuelles : masque fixe, pas de renvoi
+        instance.lightMask = (level == ShadingLod::SUN_ONLY) ? 0 : sceneLightMasks[i];
+        instance.bakeOffset = bakedLighting ? lightBaker.getOffset(i) : -1;
+    }
+    instanceBuffer.set(sceneSlots[i], instance);
+    return sceneSlots[i];
+}
+
+// Fonction pour obtenir l'index du mesh d'un lot statique dans les clés de tri (après ceux des modèles)
+uint32_t getBatchMeshKey(size_t batch)
+{
+    return (uint32_t)(models.getModelCount() + batch);
+}
+
+// Fonction pour soumettre un dessin par lot statique visible (instance identité : sommets déjà en monde)
+// Le masque des lumières d'un lot réunit ceux de ses objets
+void submitStaticBatches(bool forward)
+{
+    batchDrawCount = 0;
+    if (instanceBuffer.size() < batchSlots + staticBatcher.size())
+    {
+        instanceBuffer.resize(batchSlots + staticBatcher.size());
+    }
+    for (size_t b = 0; b < staticBatcher.size(); b++)
+    {
+        const Mesh* mesh = batchMeshes[b].get();
+        if (!batchVisible[b] || mesh->getVertexCount() == 0)
+        {
+            continue;
+        }
+
+        int level = forward ? batchLod.getLevel(b) : 0;
+        InstanceData instance = InstanceBuffer::makeInstance(glm::mat4(1.0f));
+        for (uint32_t i : staticBatcher.getObjects(b))
+        {
+            instance.lightMask = instance.lightMask | ((forward && level != ShadingLod::SUN_ONLY) ? sceneLightMasks[i] : 0);
+        }
+
+        GLuint slot = batchSlots + (GLuint)b;
+        instanceBuffer.set(slot, instance);
+        RenderCommand command = { forward ? shadingShaders[level] : &gbufferShader, models.getTexture(staticBatcher.getMaterial(b)), mesh, false, slot, 1, glm::mat4(1.0f), 0 };
+        uint32_t pass = forward ? RenderQueue::PASS_FORWARD : RenderQueue::PASS_GEOMETRY;
+        renderQueue.submit(RenderQueue::makeKey(pass, level, staticBatcher.getMaterial(b), getBatchMeshKey(b), batchLod.getDistance(b) / SORT_DEPTH_RANGE), command);
+        batchDrawCount = batchDrawCount + 1;
+
+        if (forward)
+        {
+            shadingLod.countDraw(level, (int)staticBatcher.getObjects(b).size());
+        }
+    }
+}
+
+// Fonction pour soumettre une plage d'emplacements consécutifs d'un groupe (un dessin instancié)
+void submitSceneRun(const RenderCommand& command, uint32_t pass, int level, const ModelGroup& group, float nearest, bool forward)
+{
+    if (command.instanceCount == 0)
+    {
+        return;
+    }
+
+    // Clé : passe, niveau d'ombrage, texture et mesh (le modèle), puis instance la plus proche (de l'avant vers l'arrière)
+    renderQueue.submit(RenderQueue::makeKey(pass, level, group.model, group.model, nearest / SORT_DEPTH_RANGE), command);
+    if (forward)
+    {
+        shadingLod.countDraw(level, command.instanceCount);
+    }
+}
+
+// Fonction pour mettre à jour les emplacements des objets dessinés et soumettre les dessins instanciés par modèle et par niveau d'ombrage
+// forward : rendu direct (niveaux d'ombrage, lumières ponctuelles et éclairage précalculé par instance)
+// staticBatching : les objets des lots statiques sont dessinés par leurs lots
+// Chaque objet a un emplacement fixe : un dessin par plage d'emplacements consécutifs à dessiner dans l'image
+// Les objets cachés à l'image précédente selon les requêtes d'occlusion sont soumis à part, des dessins conditionnels par requête
+void submitSceneCommands(bool forward, bool bakedLighting, bool staticBatching)
+{
+    std::vector<size_t> conditionalObjects;
+    uint32_t pass = forward ? RenderQueue::PASS_FORWARD : RenderQueue::PASS_GEOMETRY;
+    uint32_t conditionalPass = forward ? RenderQueue::PASS_FORWARD_CONDITIONAL : RenderQueue::PASS_GEOMETRY_CONDITIONAL;
+
+    int levelCount = forward ? (int)ShadingLod::LEVEL_COUNT : 1;
+    for (int level = 0; level < levelCount; level++)
+    {
+        for (const auto& group : modelGroups)
+        {
+            if (group.mesh == nullptr || group.texture == nullptr)
+            {
+                continue;
+            }
+
+            RenderCommand command = { forward ? shadingShaders[level] : &gbufferShader, group.texture, group.mesh, false, 0, 0, glm::mat4(1.0f), 0 };
+            float nearest = SORT_DEPTH_RANGE;
+            conditionalObjects.clear();
 
-    for (int i = -150; i <= 150; i = i + 10) 
+            for (size_t i : group.objects)
+            {
+                if (!sceneVisible[i] || sceneLodFade[i] >= 1.0f || (forward && shadingLod.getLevel(i) != level) || (staticBatching && staticBatcher.isBatched((uint32_t)i)))
+                {
+                    continue;
+                }
+
+                if (sceneConditions[i] != 0)
+                {
+                    conditionalObjects.push_back(i);
+                    continue;
+                }
+
+                // Emplacement qui ne suit pas la plage en cours : elle est dessinée telle quelle
+                GLuint slot = updateSceneInstance(i, level, forward, bakedLighting);
+                if (command.instanceCount > 0 && slot != command.firstInstance + (GLuint)command.instanceCount)
+                {
+                    submitSceneRun(command, pass, level, group, nearest, forward);
+                    command.instanceCount = 0;
+                    nearest = SORT_DEPTH_RANGE;
+                }
+
+                if (command.instanceCount == 0)
+                {
+                    command.firstInstance = slot;
+                }
+                command.instanceCount = command.instanceCount + 1;
+                nearest = glm::min(nearest, shadingLod.getDistance(i));
+            }
+            submitSceneRun(command, pass, level, group, nearest, forward);
+
+            // Objets cachés : regroupés par requête puis par emplacement, dessinés après l'émission des requêtes de l'image
+            std::sort(conditionalObjects.begin(), conditionalObjects.end(), [](size_t a, size_t b)
+            {
+                return sceneConditions[a] != sceneConditions[b] ? sceneConditions[a] < sceneConditions[b] : sceneSlots[a] < sceneSlots[b];
+            });
+
+            RenderCommand conditional = command;
+            conditional.instanceCount = 0;
+            float conditionalNearest = SORT_DEPTH_RANGE;
+            for (size_t i : conditionalObjects)
+            {
+                GLuint slot = updateSceneInstance(i, level, forward, bakedLighting);
+                if (conditional.instanceCount > 0 && (sceneConditions[i] != conditional.condition || slot != conditional.firstInstance + (GLuint)conditional.instanceCount))
+                {
+                    submitSceneRun(conditional, conditionalPass, level, group, conditionalNearest, forward);
+                    conditional.instanceCount = 0;
+                    conditionalNearest = SORT_DEPTH_RANGE;
+                }
+
+                if (conditional.instanceCount == 0)
+                {
+                    conditional.firstInstance = slot;
+                    conditional.condition = sceneConditions[i];
+                }
+                conditional.instanceCount = conditional.instanceCount + 1;
+                conditionalNearest = glm::min(conditionalNearest, shadingLod.getDistance(i));
+            }
+            submitSceneRun(conditional, conditionalPass, level, group, conditionalNearest, forward);
+        }
+    }
+
+    if (staticBatching)
+    {
+        submitStaticBatches(forward);
+    }
+
+    instanceBuffer.upload();
+}
+
+// Fonction pour soumettre les objets de chaque cascade d'ombre à redessiner (un dessin par objet ou par lot statique, tri par mesh puis depuis le soleil)
+void submitShadowCommands(bool staticBatching)
+{
+    for (int c = 0; c < ShadowMaps::CASCADE_COUNT; c++)
     {
-        for (int j = -150; j <= 150; j = j + 10) 
+        if (!shadowMaps.needsRender(c))
+        {
+            continue;
+        }
+
+        for (const auto& group : modelGroups)
+        {
+            if (group.mesh == nullptr)
+            {
+                continue;
+            }
+
+            for (size_t i : group.objects)
+            {
+                AABB box = sceneEntities.getBounds().get(i);
+                if (!sceneEntities.castsShadow(i) || !shadowMaps.intersectsCascade(box, c) || (staticBatching && staticBatcher.isBatched((uint32_t)i)))
+                {
+                    continue;
+                }
+
+                // Profondeur du centre de la boîte dans la projection orthographique de la cascade
+                float depth = (shadowMaps.getLightSpaceMatrix(c) * glm::vec4(box.getCenter(), 1.0f)).z * 0.5f + 0.5f;
+                RenderCommand command = { &shadowShader, nullptr, group.mesh, true, 0, 0, sceneInstances[i].model, 0 };
+                renderQueue.submit(RenderQueue::makeKey(RenderQueue::PASS_SHADOW + c, 0, 0, group.model, depth), command);
+            }
+        }
+
+        // Lots statiques : un dessin par lot (sommets en monde, matrice identité)
+        for (size_t b = 0; b < staticBatcher.size() && staticBatching; b++)
         {
-            if (i * i + j * j > 800) // Éviter la forêt proche du village
+            const Mesh* mesh = batchMeshes[b].get();
+            AABB box = staticBatcher.getBounds().get(b);
+            if (!staticBatcher.castsShadow(b) || mesh->getVertexCount() == 0 || !shadowMaps.intersectsCascade(box, c))
             {
-                glm::vec3 position(i + (rand() % 2) + (rand() % 2), 0.0f, j + (rand() % 2) - (rand() % 2)); // Position aléatoire + ou - 2
-                glm::vec3 rotation(0.0f, rand() % 360, 0.0f);
-
-                int randomProbability = rand() % 100; // Probabilité (0 à 99)
-
-                if (randomProbability < 80) 
-                { 
-                    // 85% de probabilité pour les arbres
-                    int randomTree = rand() % 3;
-                    switch(randomTree) 
-                    {
-                        case 0: vegetation.push_back({"sapin", position, rotation}); break;
-                        case 1: vegetation.push_back({"pin", position, rotation}); break;
-                        case 2: vegetation.push_back({"chene", position, rotation}); break;
-                    }
-                } 
-                else
-                { 
-                    // 15% pour autres types de végétation
-                    int randomVegetation = rand() % 3;
-                    switch(randomVegetation) 
-                    {
-                        case 0: vegetation.push_back({"arbuste", position, rotation}); break;
-                        case 1: vegetation.push_back({"tronc1", position, rotation}); break;
-                        case 2: vegetation.push_back({"pomme_pin", position, rotation}); break;
-                    }
-                } 
+                continue;
             }
+
+            float depth = (shadowMaps.getLightSpaceMatrix(c) * glm::vec4(box.getCenter(), 1.0f)).z * 0.5f + 0.5f;
+            RenderCommand command = { &shadowShader, nullptr, mesh, true, 0, 0, glm::mat4(1.0f), 0 };
+            renderQueue.submit(RenderQueue::makeKey(RenderQueue::PASS_SHADOW + c, 0, 0, getBatchMeshKey(b), depth), command);
+        }
+    }
+}
+
+// Fonction pour refaire les lots statiques modifiés et envoyer leurs sommets
+// (les cascades d'ombre en cache montrent encore l'ancienne géométrie)
+void rebuildStaticBatches()
+{
+    if (staticBatcher.rebuild() == 0)
+    {
+        return;
+    }
+
+    for (uint32_t b : staticBatcher.getRebuilt())
+    {
+        while (batchMeshes.size() <= b)
+        {
+            batchMeshes.emplace_back(new Mesh());
+        }
+        batchMeshes[b]->loadVertices(staticBatcher.getVertices(b));
+    }
+    shadowMaps.invalidate();
+}
+
+// Fonction pour fusionner les objets statiques du village en lots pré-transformés (par texture et par cellule)
+void initializeStaticBatches()
+{
+    staticBatcher.init(glm::vec2(-160.0f, -160.0f), BATCH_CELL_SIZE);
+    batchMeshes.clear();
+    for (EntityId id : villageEntities)
+    {
+        if (!sceneEntities.isValid(id))
+        {
+            continue;
+        }
+
+        uint32_t i = sceneEntities.getIndex(id);
+        ModelHandle model = sceneEntities.getModel(i);
+        const Mesh* mesh = models.getMesh(model);
+        if (mesh != nullptr && models.getTexture(model) != nullptr && (sceneEntities.getFlags(i) & EntityStore::STATIC) != 0)
+        {
+            staticBatcher.add(i, mesh->getVertices(), mesh->getBounds(), model, sceneTransforms.getWorld(i), sceneEntities.castsShadow(i));
+        }
+    }
+    rebuildStaticBatches();
+    batchLod.setDistances(GOURAUD_DISTANCE, SUN_ONLY_DISTANCE, SHADING_HYSTERESIS);
+
+    std::cout << "Lots statiques : " << staticBatcher.getObjectCount() << " objets en " << staticBatcher.size() << " lots" << std::endl;
+}
+
+// Fonction pour préparer les boîtes occultantes : murs des bâtiments et cœur des conifères
+void initializeSceneOccluders()
+{
+    std::vector<OccluderProxy> proxies =
+    {
+        { "cabane1", glm::vec3(0.15f, 0.0f, 0.15f), glm::vec3(0.85f, 0.55f, 0.85f) },
+        { "cabane2", glm::vec3(0.15f, 0.0f, 0.15f), glm::vec3(0.85f, 0.55f, 0.85f) },
+        { "chalet", glm::vec3(0.15f, 0.0f, 0.15f), glm::vec3(0.85f, 0.55f, 0.85f) },
+        { "eglise", glm::vec3(0.15f, 0.0f, 0.15f), glm::vec3(0.85f, 0.55f, 0.85f) },
+        { "cabane_rondins", glm::vec3(0.15f, 0.0f, 0.15f), glm::vec3(0.85f, 0.55f, 0.85f) },
+        { "sapin", glm::vec3(0.35f, 0.2f, 0.35f), glm::vec3(0.65f, 0.5f, 0.65f) },
+        { "pin", glm::vec3(0.35f, 0.2f, 0.35f), glm::vec3(0.65f, 0.5f, 0.65f) }
+    };
+
+    // Boîte occultante locale de chaque modèle (vide : pas un occultant)
+    std::vector<AABB> localBoxes(models.getModelCount());
+    for (const auto& proxy : proxies)
+    {
+        ModelHandle model = models.findModel(proxy.name);
+        const Mesh* mesh = models.getMesh(model);
+        if (mesh != nullptr && !mesh->getBounds().isEmpty())
+        {
+            const AABB& bounds = mesh->getBounds();
+            localBoxes[model].min = glm::mix(bounds.min, bounds.max, proxy.minFraction);
+            localBoxes[model].max = glm::mix(bounds.min, bounds.max, proxy.maxFraction);
+        }
+    }
+
+    sceneOccluders.clear();
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        ModelHandle model = sceneEntities.getModel(i);
+        if (!models.isValid(model) || localBoxes[model].isEmpty())
+        {
+            continue;
+        }
+
+        SceneOccluder occluder;
+        occluder.object = (uint32_t)i;
+        const AABB& box = localBoxes[model];
+        for (int k = 0; k < 8; k++)
+        {
+            glm::vec3 corner((k & 1) ? box.max.x : box.min.x, (k & 2) ? box.max.y : box.min.y, (k & 4) ? box.max.z : box.min.z);
+            occluder.corners[k] = glm::vec3(sceneTransforms.getWorld(i) * glm::vec4(corner, 1.0f));
+        }
+        sceneOccluders.push_back(occluder);
+    }
+}
+
+// Fonction pour éliminer les objets visibles cachés par les occultants proches (renvoie le nombre d'objets cachés)
+size_t cullOccludedObjects(const glm::mat4& viewProjection)
+{
+    occlusionCuller.beginFrame(viewProjection);
+    for (const auto& occluder : sceneOccluders)
+    {
+        if (sceneVisible[occluder.object] && shadingLod.getDistance(occluder.object) < OCCLUDER_DISTANCE)
+        {
+            occlusionCuller.addBox(occluder.corners);
+        }
+    }
+    occlusionCuller.rasterize();
+
+    size_t occludedCount = 0;
+    for (uint32_t id : visibleObjects)
+    {
+        if (occlusionCuller.isOccluded(sceneEntities.getBounds().get(id)))
+        {
+            sceneVisible[id] = 0;
+            occludedCount = occludedCount + 1;
+        }
+    }
+    return occludedCount;
+}
+
+// Fonction pour créer les éléments des requêtes d'occlusion : les modèles lourds et les grands objets seuls,
+// les autres objets (arbres, végétation, accessoires) regroupés par cellule
+void initializeSceneQueries()
+{
+    occlusionQueries.clear();
+    sceneQueryItems.assign(sceneEntities.size(), NO_QUERY_ITEM);
+
+    std::vector<AABB> cellBoxes(QUERY_GRID_SIZE * QUERY_GRID_SIZE);
+    std::vector<int> objectCells(sceneEntities.size(), -1);
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        AABB box = sceneEntities.getBounds().get(i);
+        const Mesh* mesh = models.getMesh(sceneEntities.getModel(i));
+        if (mesh == nullptr || box.isEmpty())
+        {
+            continue;
+        }
+
+        glm::vec3 size = box.max - box.min;
+        if (mesh->getVertexCount() >= HEAVY_VERTEX_COUNT || glm::max(size.x, size.z) > QUERY_CELL_SIZE)
+        {
+            sceneQueryItems[i] = occlusionQueries.addItem(box);
+            continue;
+        }
+
+        glm::vec3 center = box.getCenter();
+        int x = glm::clamp((int)std::floor((center.x + QUERY_CELL_SIZE * QUERY_GRID_SIZE * 0.5f) / QUERY_CELL_SIZE), 0, QUERY_GRID_SIZE - 1);
+        int z = glm::clamp((int)std::floor((center.z + QUERY_CELL_SIZE * QUERY_GRID_SIZE * 0.5f) / QUERY_CELL_SIZE), 0, QUERY_GRID_SIZE - 1);
+        objectCells[i] = z * QUERY_GRID_SIZE + x;
+        cellBoxes[objectCells[i]].expand(box.min);
+        cellBoxes[objectCells[i]].expand(box.max);
+    }
+
+    std::vector<uint32_t> cellItems(cellBoxes.size(), NO_QUERY_ITEM);
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        int cell = objectCells[i];
+        if (cell < 0)
+        {
+            continue;
+        }
+        if (cellItems[cell] == NO_QUERY_ITEM)
+        {
+            cellItems[cell] = occlusionQueries.addItem(cellBoxes[cell]);
+        }
+        sceneQueryItems[i] = cellItems[cell];
+    }
+}
+
+// Fonction pour lire les résultats des requêtes d'occlusion prêts et choisir les objets dessinés en rendu conditionnel
+// (objets visibles dont l'élément était caché selon le dernier résultat)
+void updateQueryConditions()
+{
+    occlusionQueries.beginFrame();
+    queryItemsInView.assign(occlusionQueries.size(), 0);
+
+    for (uint32_t id : visibleObjects)
+    {
+        uint32_t item = sceneQueryItems[id];
+        if (!sceneVisible[id] || item == NO_QUERY_ITEM)
+        {
+            continue;
+        }
+
+        queryItemsInView[item] = 1;
+        if (!occlusionQueries.isVisible(item))
+        {
+            sceneConditions[id] = occlusionQueries.getQuery(item);
         }
     }
 }
 
-// Fontion pour afficher la scene complete
-void renderScene(glm::mat4 model)
+// Fonction pour précalculer les atlas d'imposteurs des arbres et la sphère englobante en monde de leurs instances
+void initializeImpostors()
 {
-    // Sol de base---------------------------------------------------
-    models.renderModel("sol", glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
+    const std::string names[3] = { "sapin", "pin", "chene" };
+
+    std::vector<ImpostorModel> impostorModels;
+    impostorLayers.assign(models.getModelCount(), -1);
+    for (const std::string& name : names)
+    {
+        ModelHandle model = models.findModel(name);
+        if (models.isValid(model) && models.getMesh(model) != nullptr && models.getTexture(model) != nullptr)
+        {
+            impostorLayers[model] = (int)impostorModels.size();
+            impostorModels.push_back({ models.getMesh(model), models.getTexture(model) });
+        }
+    }
 
-    // Positionner les bâtiments avec un espacement légèrement réduit (distance minimum de 9 unités)
-    models.renderModel("cabane1", glm::vec3(-14.0f, 0.0f, -14.0f), glm::vec3(0.0f, 45.0f, 0.0f), model);
-    models.renderModel("cabane2", glm::vec3(14.0f, 0.0f, -14.0f), glm::vec3(0.0f, -45.0f, 0.0f), model);
-    models.renderModel("chalet", glm::vec3(-15.0f, 0.0f, 7.0f), glm::vec3(0.0f, 290.0f, 0.0f), model);
-    models.renderModel("eglise", glm::vec3(0.0f, 0.0f, 19.0f), glm::vec3(0.0f, 180.0f, 0.0f), model);
-    models.renderModel("cabane_rondins", glm::vec3(15.0f, 0.0f, 7.0f), glm::vec3(0.0f, -120.0f, 0.0f), model);
-    models.renderModel("cabane_arbre", glm::vec3(0.0f, 0.0f, -15.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
+    if (!impostors.bake(impostorBakeShader, impostorModels, Display::gWindowWidth, Display::gWindowHeight))
+    {
+        std::cerr << "Imposteurs indisponibles, arbres lointains dessines en maillages" << std::endl;
+        impostorLayers.assign(models.getModelCount(), -1);
+    }
+
+    // Sphère locale transformée (échelle uniforme des arbres : plus grande composante)
+    sceneImpostorSpheres.assign(sceneEntities.size(), glm::vec4(0.0f));
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        ModelHandle model = sceneEntities.getModel(i);
+        if (!models.isValid(model) || impostorLayers[model] < 0)
+        {
+            continue;
+        }
+
+        glm::vec4 sphere = impostors.getSphere(impostorLayers[model]);
+        glm::vec3 scale = models.getScale(model);
+        glm::vec3 center = glm::vec3(sceneTransforms.getWorld(i) * glm::vec4(glm::vec3(sphere), 1.0f));
+        sceneImpostorSpheres[i] = glm::vec4(center, sphere.w * glm::max(scale.x, glm::max(scale.y, scale.z)));
+    }
+}
 
-    // Végétation (forêt)--------------------------------------------
-    for (const auto& plant : vegetation) 
+// Fonction pour fusionner les arbres de la forêt en proxys par cellule (cartes texturées par les atlas d'imposteurs)
+void initializeForestHlod()
+{
+    if (!impostors.isReady())
     {
-        models.renderModel(plant.name, plant.position, plant.rotation, model);
+        return;
     }
 
-    // Animaux-------------------------------------------------------
-    // Plusieurs oiseaux dans le ciel à une hauteur de 30
-    models.renderModel("oiseau", glm::vec3(-10.0f, 30.0f, -20.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
-    models.renderModel("oiseau", glm::vec3(15.0f, 30.0f, 10.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
-    models.renderModel("oiseau", glm::vec3(-5.0f, 30.0f, 15.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
-    models.renderModel("oiseau", glm::vec3(25.0f, 30.0f, -10.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
-    models.renderModel("oiseau", glm::vec3(-20.0f, 30.0f, 25.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
+    std::vector<HlodTree> trees;
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        ModelHandle model = sceneEntities.getModel(i);
+        if (models.isValid(model) && impostorLayers[model] >= 0)
+        {
+            trees.push_back({ (uint32_t)i, sceneImpostorSpheres[i], glm::radians(sceneEntities.getYaw(i)), impostorLayers[model] });
+        }
+    }
 
-    // Ajout de groupes de chaque animal pour plus de vie dans la forêt
+    forestHlod.build(trees, sceneEntities.size(), glm::vec2(-160.0f, -160.0f), 320.0f, HLOD_CELL_SIZE, Impostors::FRAMES);
+}
 
-    // Blaireaux
-    models.renderModel("blaireau", glm::vec3(-25.0f, 0.0f, 10.0f), glm::vec3(0.0f, 15.0f, 0.0f), model);
-    models.renderModel("blaireau", glm::vec3(-28.0f, 0.0f, 12.0f), glm::vec3(0.0f, -30.0f, 0.0f), model);
+// Fonction pour retirer des objets visibles les arbres des cellules lointaines dessinées par leur proxy (renvoie leur nombre)
+size_t replaceHlodObjects(const glm::vec3& viewPos, const Frustum& frustum)
+{
+    forestHlod.update(viewPos, frustum, HLOD_DISTANCE, HLOD_HYSTERESIS);
 
-    // Sangliers
-    models.renderModel("sanglier", glm::vec3(-18.0f, 0.0f, 25.0f), glm::vec3(0.0f, -30.0f, 0.0f), model);
-    models.renderModel("sanglier", glm::vec3(-20.0f, 0.0f, 23.0f), glm::vec3(0.0f, 45.0f, 0.0f), model);
+    size_t replacedCount = 0;
+    for (uint32_t id : visibleObjects)
+    {
+        if (sceneVisible[id] && forestHlod.isReplaced(id))
+        {
+            sceneVisible[id] = 0;
+            replacedCount = replacedCount + 1;
+        }
+    }
+    return replacedCount;
+}
 
-    // Cerfs
-    models.renderModel("cerf", glm::vec3(30.0f, 0.0f, -25.0f), glm::vec3(0.0f, 45.0f, 0.0f), model);
-    models.renderModel("cerf", glm::vec3(28.0f, 0.0f, -27.0f), glm::vec3(0.0f, 30.0f, 0.0f), model);
+// Fonction pour remplacer les arbres visibles lointains par des imposteurs (fondu tramé avant IMPOSTOR_DISTANCE)
+void submitImpostors()
+{
+    sceneLodFade.assign(sceneEntities.size(), 0.0f);
+    impostors.clear();
 
-    // Elans
-    models.renderModel("elan", glm::vec3(-35.0f, 0.0f, 20.0f), glm::vec3(0.0f, -20.0f, 0.0f), model);
-    models.renderModel("elan", glm::vec3(-33.0f, 0.0f, 22.0f), glm::vec3(0.0f, 10.0f, 0.0f), model);
+    for (uint32_t id : visibleObjects)
+    {
+        ModelHandle model = sceneEntities.getModel(id);
+        if (!sceneVisible[id] || !models.isValid(model) || impostorLayers[model] < 0)
+        {
+            continue;
+        }
 
-    // Faons proches des élans
-    models.renderModel("faon", glm::vec3(-36.0f, 0.0f, 18.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
-    models.renderModel("faon", glm::vec3(-32.0f, 0.0f, 24.0f), glm::vec3(0.0f, 0.0f, 0.0f), model);
+        float fade = glm::clamp((shadingLod.getDistance(id) - (IMPOSTOR_DISTANCE - IMPOSTOR_FADE_BAND)) / IMPOSTOR_FADE_BAND, 0.0f, 1.0f);
+        if (fade <= 0.0f)
+        {
+            continue;
+        }
 
-    // Furets
-    models.renderModel("furet", glm::vec3(20.0f, 0.0f, 30.0f), glm::vec3(0.0f, 90.0f, 0.0f), model);
-    models.renderModel("furet", glm::vec3(18.0f, 0.0f, 32.0f), glm::vec3(0.0f, -45.0f, 0.0f), model);
+        float yaw = glm::radians(sceneEntities.getYaw(id));
+        sceneLodFade[id] = fade;
+        impostors.push({ sceneImpostorSpheres[id], glm::vec4(std::cos(yaw), std::sin(yaw), (float)impostorLayers[model], fade) });
+    }
 
-    // Renards
-    models.renderModel("renard", glm::vec3(-20.0f, 0.0f, -30.0f), glm::vec3(0.0f, -45.0f, 0.0f), model);
-    models.renderModel("renard", glm::vec3(-22.0f, 0.0f, -28.0f), glm::vec3(0.0f, 25.0f, 0.0f), model);
+    impostors.upload();
+}
 
-    // Lapins dispersés en petits groupes
-    models.renderModel("lapin", glm::vec3(22.0f, 0.0f, -28.0f), glm::vec3(0.0f, 15.0f, 0.0f), model);
-    models.renderModel("lapin", glm::vec3(24.0f, 0.0f, -30.0f), glm::vec3(0.0f, -10.0f, 0.0f), model);
-    models.renderModel("lapin", glm::vec3(25.0f, 0.0f, -26.0f), glm::vec3(0.0f, 5.0f, 0.0f), model);
-    models.renderModel("lapin", glm::vec3(-15.0f, 0.0f, 32.0f), glm::vec3(0.0f, -10.0f, 0.0f), model);
-    models.renderModel("lapin", glm::vec3(-14.0f, 0.0f, 34.0f), glm::vec3(0.0f, 20.0f, 0.0f), model);
+// Fonction pour envoyer toutes les instances de la scène au GPU (élimination et dessin indirect, OpenGL 4.3 seulement)
+void initializeGpuScene()
+{
+    if (!GpuScene::isSupported())
+    {
+        std::cerr << "OpenGL 4.3 indisponible, pas de rendu par le GPU" << std::endl;
+        return;
+    }
 
-    // Loups éloignés
-    models.renderModel("loup", glm::vec3(-40.0f, 0.0f, 40.0f), glm::vec3(0.0f, 180.0f, 0.0f), model);
-    models.renderModel("loup", glm::vec3(35.0f, 0.0f, 25.0f), glm::vec3(0.0f, -45.0f, 0.0f), model);
+    gpuCullShader.loadComputeShader("Shaders/gpu_cull.comp");
+    gpuSceneShader.loadShaders("Shaders/gpu_scene.vert", "Shaders/gpu_scene.frag");
 
+    // Une commande et une couche de texture par modèle (même index que l'identifiant du modèle)
+    std::vector<GpuSceneModel> gpuModels;
+    for (ModelHandle model = 0; model < models.getModelCount(); model++)
+    {
+        gpuModels.push_back({ models.getMesh(model), models.getTexture(model) });
+    }
 
-    // Accessoires---------------------------------------------------
-    models.renderModel("voiture", glm::vec3(-17.0f, 0.0f, -11.0f), glm::vec3(0.0f, 45.0f, 0.0f), model); // Cabane1
-    models.renderModel("voiture", glm::vec3(18.0f, 0.0f, -12.0f), glm::vec3(0.0f, -45.0f, 0.0f), model); // Cabane2
-    models.renderModel("voiture", glm::vec3(-13.0f, 0.0f, 12.0f), glm::vec3(0.0f, 110.0f, 0.0f), model); // Chalet
-    models.renderModel("voiture", glm::vec3(20.0f, 0.0f, 3.0f), glm::vec3(0.0f, -120.0f, 0.0f), model); // Cabane en rondins
-    models.renderModel("feu_camp", glm::vec3(2.0f, 0.0f, 3.0f), glm::vec3(0.0f, 0.0f, 0.0f), model); // Feu de camp au centre
-    models.renderModel("balancoire", glm::vec3(-3.0f, 0.0f, 2.0f), glm::vec3(0.0f, 30.0f, 0.0f), model); // Balançoire près du centre
-    models.renderModel("soleil", glm::vec3(0.0f, 100.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f), model); // Soleil dans le ciel
+    std::vector<GpuSceneInstance> gpuInstances;
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        ModelHandle model = sceneEntities.getModel(i);
+        if (!models.isValid(model) || models.getMesh(model) == nullptr)
+        {
+            continue;
+        }
 
-    // Lumières-----------------------------------------------------
-    models.renderModel("lumiere", glm::vec3(11.5f, 3.25f, -11.5f), glm::vec3(0.0f, 0.0f, 0.0f), model); // Lumière 1
-    models.renderModel("lumiere", glm::vec3(-11.21f, 2.07f, -11.21f), glm::vec3(0.0f, 0.0f, 0.0f), model); // Lumière 2
+        AABB bounds = sceneEntities.getBounds().get(i);
+        GpuSceneInstance instance;
+        instance.model = sceneInstances[i].model;
+        for (int c = 0; c < 3; c++)
+        {
+            instance.normalMatrix[c] = sceneInstances[i].normalMatrix[c];
+        }
+        instance.boundsMin = glm::vec4(bounds.min, 1.0f);
+        instance.boundsMax = glm::vec4(bounds.max, 1.0f);
+        instance.draw = (uint32_t)model;
+        instance.layer = (uint32_t)model;
+        instance.padding[0] = 0;
+        instance.padding[1] = 0;
+        gpuInstances.push_back(instance);
+    }
+
+    gpuScene.build(gpuCullShader, gpuModels, gpuInstances);
+}
+
+// Fonction pour initialiser l'herbe : touffes posées sur le relief, absentes sous les objets fixes du village
+void initializeGrass()
+{
+    GrassSettings settings;
+    settings.seed = FOREST_SEED + 2;
+    settings.fadeStart = GRASS_FADE_START;
+    settings.drawDistance = GRASS_DISTANCE;
+    settings.instanceBudget = GRASS_INSTANCE_BUDGET;
+    settings.ground = &heightfield;
+
+    // Emprise des objets fixes posés au sol (pas celle du soleil ni des objets en hauteur)
+    for (EntityId id : villageEntities)
+    {
+        if (!sceneEntities.isValid(id))
+        {
+            continue;
+        }
+
+        uint32_t i = sceneEntities.getIndex(id);
+        AABB box = sceneEntities.getBounds().get(i);
+        glm::vec3 center = box.getCenter();
+        if ((sceneEntities.getFlags(i) & EntityStore::STATIC) != 0 && box.min.y < heightfield.getHeight(center.x, center.z) + 1.0f)
+        {
+            settings.obstacles.push_back(box);
+        }
+    }
+
+    ModelHandle model = models.findModel("herbe");
+    grass.init(models.getMesh(model), models.getTexture(model), models.getScale(model), settings);
+}
+
+// Fonction pour initialiser les particules : un émetteur par feu de la scène, posé au sol sous sa lumière
+// (fumée dessinée en premier, puis flammes additives et braises)
+void initializeParticles()
+{
+    // Fumée : monte lentement, grossit et s'éclaircit
+    ParticleLayerSettings smoke;
+    smoke.capacity = 96;
+    smoke.rate = 12.0f;
+    smoke.minLife = 3.0f;
+    smoke.maxLife = 5.0f;
+    smoke.radius = 0.3f;
+    smoke.velocity = glm::vec3(0.0f, 0.8f, 0.0f);
+    smoke.velocitySpread = glm::vec3(0.15f, 0.2f, 0.15f);
+    smoke.acceleration = glm::vec3(0.2f, 0.1f, 0.0f); // Légère dérive dans le vent
+    smoke.drag = 0.2f;
+    smoke.startSize = 0.4f;
+    smoke.endSize = 2.2f;
+    smoke.startColor = glm::vec4(0.12f, 0.12f, 0.12f, 0.3f);
+    smoke.endColor = glm::vec4(0.0f);
+
+    // Flammes : courtes, accélérées par l'air chaud, rétrécissent en montant ; elles font la lumière du feu
+    ParticleLayerSettings flames;
+    flames.capacity = 64;
+    flames.rate = 60.0f;
+    flames.minLife = 0.4f;
+    flames.maxLife = 0.8f;
+    flames.radius = 0.25f;
+    flames.velocity = glm::vec3(0.0f, 0.6f, 0.0f);
+    flames.velocitySpread = glm::vec3(0.1f, 0.2f, 0.1f);
+    flames.acceleration = glm::vec3(0.0f, 1.5f, 0.0f);
+    flames.startSize = 0.6f;
+    flames.endSize = 0.15f;
+    flames.startColor = glm::vec4(1.0f, 0.45f, 0.1f, 0.0f);
+    flames.endColor = glm::vec4(0.3f, 0.05f, 0.0f, 0.0f);
+    flames.lightWeight = 1.0f;
+
+    // Braises : projetées vers le haut puis retombent
+    ParticleLayerSettings embers;
+    embers.capacity = 24;
+    embers.rate = 6.0f;
+    embers.minLife = 1.5f;
+    embers.maxLife = 3.0f;
+    embers.radius = 0.2f;
+    embers.velocity = glm::vec3(0.0f, 2.5f, 0.0f);
+    embers.velocitySpread = glm::vec3(0.6f, 0.8f, 0.6f);
+    embers.acceleration = glm::vec3(0.0f, -0.8f, 0.0f);
+    embers.drag = 0.3f;
+    embers.startSize = 0.05f;
+    embers.endSize = 0.03f;
+    embers.startColor = glm::vec4(1.0f, 0.6f, 0.2f, 0.0f);
+    embers.endColor = glm::vec4(0.6f, 0.1f, 0.0f, 0.0f);
+
+    for (size_t l = 0; l < sceneLights.size(); l++)
+    {
+        const SceneLight& light = sceneLights[l];
+        if (light.type != SceneLight::FIRE)
+        {
+            continue;
+        }
+
+        glm::vec3 position(light.position.x, heightfield.getHeight(light.position.x, light.position.z) + FIRE_EMITTER_HEIGHT, light.position.z);
+        ParticleEmitter emitter(position, (uint32_t)(FOREST_SEED + l));
+        emitter.addLayer(smoke);
+        emitter.addLayer(flames);
+        emitter.addLayer(embers);
+        particles.addEmitter(emitter);
+    }
+
+    particles.init(jobSystem);
+}
+
+// Fonction pour initialiser la nuée d'oiseaux (simulée sur les threads du JobSystem)
+void initializeBirds()
+{
+    FlockSettings settings;
+    settings.seed = FOREST_SEED + 3;
+    settings.count = BIRD_COUNT;
+    settings.center = glm::vec3(0.0f, 0.5f * (BIRD_MIN_HEIGHT + BIRD_MAX_HEIGHT), 0.0f);
+    settings.radius = BIRD_FLIGHT_RADIUS;
+    settings.minHeight = BIRD_MIN_HEIGHT;
+    settings.maxHeight = BIRD_MAX_HEIGHT;
+
+    ModelHandle model = models.findModel("oiseau");
+    birds.init(models.getMesh(model), models.getTexture(model), models.getScale(model), settings, jobSystem);
 }
 
-// Fonction pour mettre à jour la lumière du feu avec des variations de couleur et d'intensité
-void updateFireLight(Lights& lights, ShaderProgram& shader, int index, glm::vec3 position) 
+// Fonction pour lancer le chargement par morceaux du monde autour de la forêt du village : forêt et accessoires posés sur le relief
+void initializeWorldStreaming()
 {
-    // Générer une couleur aléatoire dans les teintes de rouge, orange et jaune
-    glm::vec3 colorOptions[] = 
+    std::vector<StreamModel> streamModels;
+    for (ModelHandle model = 0; model < models.getModelCount(); model++)
     {
-        glm::vec3(1.0f, 0.5f, 0.0f), // Orange
-        glm::vec3(1.0f, 0.3f, 0.0f), // Rouge orangé
-        glm::vec3(1.0f, 0.8f, 0.0f)  // Jaune
+        streamModels.push_back({ models.getMesh(model), models.getTexture(model), models.getScale(model) });
+    }
+
+    StreamSettings settings;
+    settings.chunkSize = STREAM_CHUNK_SIZE;
+    settings.loadDistance = STREAM_LOAD_DISTANCE;
+    settings.hysteresis = STREAM_HYSTERESIS;
+    settings.memoryBudget = STREAM_MEMORY_BUDGET;
+    settings.residentMin = glm::vec2(-RESIDENT_HALF_SIZE);
+    settings.residentMax = glm::vec2(RESIDENT_HALF_SIZE);
+    settings.ground = &heightfield;
+
+    // Forêt : mêmes espèces et espacement que la forêt du village
+    ForestSettings forest;
+    forest.seed = FOREST_SEED;
+    forest.minDistance = 5.0f;
+    forest.candidateDensity = 0.03f;
+    forest.species = {
+        { models.findModel("sapin"), 8.0f }, { models.findModel("pin"), 8.0f }, { models.findModel("chene"), 8.0f },
+        { models.findModel("arbuste"), 2.0f }, { models.findModel("tronc1"), 2.0f }, { models.findModel("pomme_pin"), 2.0f }
     };
-    glm::vec3 chosenColor = colorOptions[rand() % 3];
+    settings.layers.push_back(forest);
+
+    // Accessoires épars : rochers, troncs couchés et herbe
+    ForestSettings props;
+    props.seed = FOREST_SEED + 1;
+    props.minDistance = 15.0f;
+    props.candidateDensity = 0.002f;
+    props.species = { { models.findModel("roche"), 3.0f }, { models.findModel("tronc2"), 1.0f }, { models.findModel("herbe"), 2.0f } };
+    settings.layers.push_back(props);
+
+    worldStreamer.init(settings, streamModels);
+}
+
+// Fonction pour précalculer l'éclairage statique de la scène (ou le relire depuis le fichier de cache)
+void initializeBakedLighting(glm::vec3 sunDirection)
+{
+    std::vector<BakeObject> bakeObjects;
+    for (size_t i = 0; i < sceneEntities.size(); i++)
+    {
+        bakeObjects.push_back({ models.getMesh(sceneEntities.getModel(i)), sceneTransforms.getWorld(i), sceneEntities.castsShadow(i) });
+    }
+
+    // Lampes fixes de la scène, mêmes valeurs que dans applyLights
+    std::vector<BakeLight> bakeLights;
+    for (const SceneLight& light : sceneLights)
+    {
+        if (light.type == SceneLight::LAMP)
+        {
+            bakeLights.push_back({ light.position, light.diffuse, light.constant, light.linear, light.exponent, Lights::computeLightRadius(glm::vec3(light.diffuse), light.constant, light.linear, light.exponent) });
+        }
+    }
+
+    if (!lightBaker.bakeOrLoad(bakeObjects, bakeLights, sunDirection, "eclairage.bake"))
+    {
+        std::cerr << "Eclairage precalcule indisponible, eclairage dynamique seulement" << std::endl;
+    }
+}
+
+// Fonction pour dessiner les cascades d'ombre du soleil qui ne sont pas en cache
+void renderShadowMaps()
+{
+    shadowShader.use();
+
+    for (int c = 0; c < ShadowMaps::CASCADE_COUNT; c++)
+    {
+        if (!shadowMaps.needsRender(c))
+        {
+            continue;
+        }
+
+        shadowTimers[c].begin();
+        shadowMaps.beginCascade(c);
+        shadowShader.setUniform("lightSpace", shadowMaps.getLightSpaceMatrix(c));
+
+        renderQueue.execute(RenderQueue::PASS_SHADOW + c, instanceBuffer);
+
+        shadowMaps.endCascade(c);
+        shadowTimers[c].end();
+    }
+
+    shadowMaps.endPass(Display::gWindowWidth, Display::gWindowHeight);
+}
+
+// Couleurs de la lumière du feu pour l'image courante (les mêmes pour tous les shaders)
+glm::vec3 fireAmbient, fireDiffuse, fireSpecular;
+
+// Fonction pour mettre à jour la lumière du feu avec des variations de couleur et d'intensité (une fois par image, après les particules)
+void updateFireLight() 
+{
+    // Lumière des flammes dessinées, moyenne des émetteurs (1 en moyenne, plus haute quand le feu s'emballe)
+    float flameLight = 1.0f;
+    if (particles.getEmitterCount() > 0)
+    {
+        flameLight = 0.0f;
+        for (size_t e = 0; e < particles.getEmitterCount(); e++)
+        {
+            flameLight += particles.getEmitter(e).getLight();
+        }
+        flameLight /= (float)particles.getEmitterCount();
+    }
 
-    // Intensité aléatoire 
-    float intensityFactor = 0.5f + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (1.0f - 0.5f)));
+    // Teinte du rouge orangé au jaune selon la vigueur des flammes
+    glm::vec3 chosenColor = glm::mix(glm::vec3(1.0f, 0.3f, 0.0f), glm::vec3(1.0f, 0.8f, 0.0f), glm::clamp(flameLight - 0.5f, 0.0f, 1.0f));
+
+    // Intensité qui suit les flammes
+    float intensityFactor = glm::clamp(flameLight * FIRE_INTENSITY_SCALE, 0.4f, 1.0f);
 
     // Appliquer l'intensité à la couleur choisie
-    glm::vec3 ambient = chosenColor * intensityFactor * 0.2f; // Plus faible pour l'ambiant
-    glm::vec3 diffuse = chosenColor * intensityFactor;        // Pleine intensité pour le diffuse
-    glm::vec3 specular = chosenColor * 0.3f;                  // Faible valeur de speculaire pour adoucir
+    fireAmbient = chosenColor * intensityFactor * 0.2f; // Plus faible pour l'ambiant
+    fireDiffuse = chosenColor * intensityFactor;        // Pleine intensité pour le diffuse
+    fireSpecular = chosenColor * 0.3f;                  // Faible valeur de speculaire pour adoucir
+}
+
+// Fonction pour envoyer toutes les lumières de la scène à un shader d'éclairage
+// shadingLevel : niveau d'ombrage du shader (SUN_ONLY : soleil et ambiant seulement)
+void applyLights(ShaderProgram& shader, int shadingLevel, float intensity, glm::vec3 sunDirection)
+{
+    // Configuration de la lumière directionnelle (soleil)
+    lights.setSunLight(shader, sunDirection, glm::vec3(1.0f, 1.0f, 0.9f) * intensity, glm::vec3(1.0f, 1.0f, 0.8f) * intensity); // Lumière du soleil jaune
 
-    // Appeler setPointLight avec des valeurs d'atténuation adaptées pour la proximité
-    float constant = 1.0f;
-    float linear = 0.14f;
-    float exponent = 0.07f;
+    // Matériau commun
+    models.setMaterial(shader);
+
+    if (shadingLevel == ShadingLod::SUN_ONLY)
+    {
+        lights.setAmbientLight(shader);
+        return;
+    }
+
+    // Lampe torche
+    lights.spotlightShaders(shader, fpsCamera.getPosition());
+
+    // Lumières ponctuelles de la scène (lampes blanches, feu aux couleurs de l'image), emplacements restants éteints
+    for (size_t l = 0; l < MAX_POINT_LIGHTS; l++)
+    {
+        if (l >= sceneLights.size())
+        {
+            lights.setPointLight(shader, (int)l, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f), 1.0f, 0.0f, 0.0f);
+            continue;
+        }
 
-    lights.setPointLight(shader, index, ambient, diffuse, specular, position, constant, linear, exponent);
+        const SceneLight& light = sceneLights[l];
+        if (light.type == SceneLight::FIRE)
+        {
+            lights.setPointLight(shader, (int)l, fireAmbient, fireDiffuse * light.diffuse, fireSpecular, light.position, light.constant, light.linear, light.exponent);
+        }
+        else
+        {
+            lights.setPointLight(shader, (int)l, glm::vec3(0.1f, 0.1f, 0.1f), glm::vec3(light.diffuse), glm::vec3(1.0f, 1.0f, 1.0f), light.position, light.constant, light.linear, light.exponent);
+        }
+    }
 }
 
 
@@ -209,8 +1313,7 @@ int main()
     float nightFactor; // Facteur de transition entre le jour et la nuit
     glm::vec4 currentBackgroundColor; // Couleur de fond actuelle
 
-    // Matrices de modèle, vue et projection
-    glm::mat4 model = glm::mat4(1.0f);   
+    // Matrices de vue et projection (les matrices de modèle sont dans le buffer d'instances)
     glm::mat4 view = glm::mat4(1.0f);  
     glm::mat4 projection = glm::mat4(1.0f);
 
@@ -226,20 +1329,98 @@ int main()
 
     // Shaders-------------------------------------------------------
 	lightingShader.loadShaders("Shaders/lighting.vert", "Shaders/lighting.frag");
-    lightingShader.use();
+    lightingGouraudShader.loadShaders("Shaders/lighting_gouraud.vert", "Shaders/lighting_gouraud.frag");
+    lightingSunShader.loadShaders("Shaders/lighting.vert", "Shaders/lighting_sun.frag");
+    gbufferShader.loadShaders("Shaders/gbuffer.vert", "Shaders/gbuffer.frag");
+    deferredShader.loadShaders("Shaders/deferred.vert", "Shaders/deferred.frag");
+    shadowShader.loadShaders("Shaders/shadow_depth.vert", "Shaders/shadow_depth.frag");
+    occlusionBoxShader.loadShaders("Shaders/occlusion_box.vert", "Shaders/occlusion_box.frag");
+    impostorBakeShader.loadShaders("Shaders/impostor_bake.vert", "Shaders/impostor_bake.frag");
+    impostorShader.loadShaders("Shaders/impostor.vert", "Shaders/impostor.frag");
+    impostorGBufferShader.loadShaders("Shaders/impostor.vert", "Shaders/impostor_gbuffer.frag");
+    hlodShader.loadShaders("Shaders/hlod.vert", "Shaders/impostor.frag");
+    hlodGBufferShader.loadShaders("Shaders/hlod.vert", "Shaders/impostor_gbuffer.frag");
+    terrainShader.loadShaders("Shaders/terrain.vert", "Shaders/lighting.frag");
+    terrainGBufferShader.loadShaders("Shaders/terrain.vert", "Shaders/gbuffer.frag");
+    grassShader.loadShaders("Shaders/grass.vert", "Shaders/lighting_sun.frag");
+    grassGBufferShader.loadShaders("Shaders/grass.vert", "Shaders/gbuffer.frag");
+    birdShader.loadShaders("Shaders/bird.vert", "Shaders/lighting_sun.frag");
+    birdGBufferShader.loadShaders("Shaders/bird.vert", "Shaders/gbuffer.frag");
+    particleShader.loadShaders("Shaders/particle.vert", "Shaders/particle.frag");
+
+    // Unité de texture de la texture diffuse (fixe)
+    gbufferShader.use();
+    gbufferShader.setUniformSampler("material.diffuseMap", 0);
+    terrainShader.use();
+    terrainShader.setUniformSampler("material.diffuseMap", 0);
+    terrainGBufferShader.use();
+    terrainGBufferShader.setUniformSampler("material.diffuseMap", 0);
+    grassShader.use();
+    grassShader.setUniformSampler("material.diffuseMap", 0);
+    grassGBufferShader.use();
+    grassGBufferShader.setUniformSampler("material.diffuseMap", 0);
+    birdShader.use();
+    birdShader.setUniformSampler("material.diffuseMap", 0);
+    birdGBufferShader.use();
+    birdGBufferShader.setUniformSampler("material.diffuseMap", 0);
+    impostorBakeShader.use();
+    impostorBakeShader.setUniformSampler("material.diffuseMap", 0);
+    for (ShaderProgram* shader : shadingShaders)
+    {
+        shader->use();
+        shader->setUniformSampler("material.diffuseMap", 0);
+        shader->setUniformSampler("bakedLighting", 5);
+    }
+
+    // Rendu différé et mesure des temps GPU------------------------
+    gbuffer.init(Display::gWindowWidth, Display::gWindowHeight);
+    forwardTimer.init();
+    deferredTimer.init();
+
+    // Ombres du soleil----------------------------------------------
+    shadowMaps.init();
+    for (int c = 0; c < ShadowMaps::CASCADE_COUNT; c++)
+    {
+        shadowTimers[c].init();
+    }
+
+    // Buffer d'instances---------------------------------------------
+    instanceBuffer.init();
+
+    // Élimination des objets cachés : petit tampon de profondeur, un thread par bande de lignes
+    occlusionCuller.init(256, 128, (int)glm::clamp(std::thread::hardware_concurrency(), 1u, 4u));
+
+    // Threads des calculs de chaque image (particules, oiseaux)
+    jobSystem.init((int)glm::clamp(std::thread::hardware_concurrency(), 1u, 4u));
+
+    // Requêtes d'occlusion GPU---------------------------------------
+    occlusionQueries.init();
 
     // Initialisation des modèles------------------------------------
     models.initializeModels(lightingShader);
 
-    //Position des lumieres------------------------------------------
-    glm::vec3 pointLightPos[2] = 
-    {
-		glm::vec3(11.5f, 3.25f, -11.5f),
-		glm::vec3(-11.21f, 2.07f, -11.21f)
-	};
-    
-    // Initialisation de la végétation--------------------------------
+    // Niveaux d'ombrage--------------------------------------------
+    shadingLod.setDistances(GOURAUD_DISTANCE, SUN_ONLY_DISTANCE, SHADING_HYSTERESIS);
+
+    // Relief et terrain----------------------------------------------
+    initializeTerrain();
+
+    // Initialisation des objets de la scène------------------------
     initializeSceneObjects();
+    initializeSceneTransforms();
+    initializeSceneBounds();
+    initializeSceneInstances();
+    initializeStaticBatches();
+    initializeSceneOccluders();
+    initializeSceneQueries();
+    initializeImpostors();
+    initializeForestHlod();
+    initializeGpuScene();
+    initializeBakedLighting(sunDirection);
+    initializeWorldStreaming();
+    initializeGrass();
+    initializeParticles();
+    initializeBirds();
 
     // Temps écoulé depuis l'initialisation de GLFW------------------
     lastTime = glfwGetTime(); 
@@ -273,7 +1454,6 @@ int main()
 
         //Dessin------------------------------------------------
         // Initialisation des matrices (identité)
-        model = glm::mat4(1.0f);  
         view = glm::mat4(1.0f);   
         projection = glm::mat4(1.0f); 
 
@@ -285,31 +1465,368 @@ int main()
 
         // Position de la vue
         glm::vec3 viewPos = fpsCamera.getPosition();
-        
-        // Utiliser le programme de shader
-        lightingShader.use();
 
-        // Uniforms du shader .vert
-        lightingShader.setUniform("model", model);
-        lightingShader.setUniform("view", view);
-        lightingShader.setUniform("projection", projection);
-        lightingShader.setUniform("viewPos", viewPos);
+        // Particules des feux (threads, instances écrites dans le buffer), puis lumière du feu selon les flammes
+        particles.update((float)deltaTime);
+        updateFireLight();
+        shadingLod.resetCounts();
+
+        // Scène éliminée et dessinée par le GPU (rendu direct seulement, sans éclairage précalculé ni imposteurs)
+        bool gpuDriven = Display::gGpuDriven && gpuScene.isReady() && !Display::gDeferredShading;
+
+        // Éclairage précalculé (rendu direct seulement)
+        bool bakedLighting = Display::gBakedLighting && lightBaker.isReady() && !Display::gDeferredShading && !gpuDriven;
+
+        // Objets déplacés : nouvelles matrices, renvoyées avec leur emplacement
+        updateSceneInstances();
+
+        // Niveau d'ombrage et distance de chaque objet à la caméra
+        shadingLod.update(sceneEntities.getBounds(), viewPos);
+
+        // Objets dans la pyramide de vue, trouvés par l'index spatial (les ombres gardent tous les objets : un objet hors champ peut en projeter une)
+        Frustum frustum = fpsCamera.getFrustum(projection);
+        visibleObjects.clear();
+        sceneIndex.queryFrustum(frustum, visibleObjects);
+        sceneVisible.assign(sceneEntities.size(), 0);
+        for (uint32_t id : visibleObjects)
+        {
+            sceneVisible[id] = 1;
+        }
+        size_t visibleCount = visibleObjects.size();
+
+        // Objets visibles cachés par les occultants proches (temps CPU mesuré)
+        size_t occludedCount = 0;
+        double occlusionMs = 0.0;
+        if (Display::gOcclusionCulling)
+        {
+            auto occlusionStart = std::chrono::high_resolution_clock::now();
+            occludedCount = cullOccludedObjects(projection * view);
+            occlusionMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - occlusionStart).count();
+        }
+
+        // Lots statiques : niveau d'ombrage, pyramide de vue et occultants
+        // (inutilisés avec l'éclairage précalculé, lu par objet, et avec le rendu par le GPU)
+        bool staticBatching = Display::gStaticBatching && staticBatcher.size() > 0 && !bakedLighting && !gpuDriven;
+        batchDrawCount = 0;
+        if (staticBatching)
+        {
+            rebuildStaticBatches();
+            batchLod.update(staticBatcher.getBounds(), viewPos);
+            batchVisible.assign(staticBatcher.getBounds().paddedSize(), 0);
+            frustumCullAABB(staticBatcher.getBounds(), frustum, batchVisible.data());
+            for (size_t b = 0; b < staticBatcher.size() && Display::gOcclusionCulling; b++)
+            {
+                if (batchVisible[b] && occlusionCuller.isOccluded(staticBatcher.getBounds().get(b)))
+                {
+                    batchVisible[b] = 0;
+                }
+            }
+        }
+
+        // Arbres des cellules lointaines remplacés par les proxys, arbres lointains restants par des imposteurs
+        size_t hlodCount = replaceHlodObjects(viewPos, frustum);
+        submitImpostors();
+
+        // Morceaux du monde : chargement asynchrone autour de la caméra, morceaux visibles
+        worldStreamer.update(viewPos, frustum);
+
+        // Terrain : fenêtre de hauteurs autour de la caméra, noeuds visibles
+        terrain.update(viewPos, frustum);
+
+        // Herbe : tuiles autour de la caméra, lots visibles et touffes de chacun dans le budget
+        if (Display::gGrass)
+        {
+            grass.update(viewPos, frustum);
+        }
+
+        // Oiseaux : un pas de la nuée sur les threads, oiseaux visibles envoyés au GPU
+        birds.update((float)deltaTime, frustum);
 
-		// Configuration de la lumière directionnelle (soleil)
-        lights.setSunLight(lightingShader, sunDirection, glm::vec3(1.0f, 1.0f, 0.9f) * intensity, glm::vec3(1.0f, 1.0f, 0.8f) * intensity); // Lumière du soleil jaune
+        // Requêtes d'occlusion GPU : résultats des images précédentes, sans attente
+        sceneConditions.assign(sceneEntities.size(), 0);
+        if (Display::gOcclusionQueries)
+        {
+            updateQueryConditions();
+        }
 
-		// Lampe torche
-        lights.spotlightShaders(lightingShader, fpsCamera.getPosition());
+        // File de rendu de l'image-----------------------------
+        renderQueue.clear();
+        double submitMs = 0.0; // Temps CPU de soumission de la scène en rendu direct (file de rendu ou GPU)
 
-        // Configuration des points de lumière
-        lights.setPointLight(lightingShader, 0, glm::vec3(0.1f, 0.1f, 0.1f), glm::vec3(0.8f, 0.8f, 0.8f), glm::vec3(1.0f, 1.0f, 1.0f), pointLightPos[0], 1.0f, 0.09f, 0.032f);
-        lights.setPointLight(lightingShader, 1, glm::vec3(0.1f, 0.1f, 0.1f), glm::vec3(0.8f, 0.8f, 0.8f), glm::vec3(1.0f, 1.0f, 1.0f), pointLightPos[1], 1.0f, 0.09f, 0.032f);
+        // Ombres du soleil : seules les cascades hors cache sont redessinées
+        // (aussi avec l'éclairage précalculé : le terrain n'est pas précalculé et lit ses ombres dans les cascades)
+        shadowMaps.update(view, fpsCamera.getFOV(), (float)display.gWindowWidth / (float)display.gWindowHeight, 0.1f, sunDirection);
+        submitShadowCommands(staticBatching);
 
-        // Lumière du feu
-        updateFireLight(lights, lightingShader, 2, glm::vec3(2.0f, 0.4f, 3.0f));
+        if(Display::gDeferredShading)
+        {
+            submitSceneCommands(false, false, staticBatching);
+        }
+        else
+        {
+            // Uniforms de chaque niveau d'ombrage, avant les dessins
+            for (int level = 0; level < ShadingLod::LEVEL_COUNT; level++)
+            {
+                ShaderProgram& shader = *shadingShaders[level];
 
-        // Affichage de la scene
-        renderScene(model);
+                // Utiliser le programme de shader
+                models.useShader(shader);
+
+                // Uniforms du shader .vert
+                shader.setUniform("view", view);
+                shader.setUniform("projection", projection);
+                shader.setUniform("viewPos", viewPos);
+
+                // Lumières de la scène
+                applyLights(shader, level, intensity, sunDirection);
+                shadowMaps.applyUniforms(shader, 4);
+            }
+
+            // Terrain : éclairage complet, toutes les lumières ponctuelles de la scène
+            terrainShader.use();
+            terrainShader.setUniform("view", view);
+            terrainShader.setUniform("projection", projection);
+            terrainShader.setUniform("viewPos", viewPos);
+            terrainShader.setUniform("lightMask", (GLint)((1u << sceneLights.size()) - 1));
+            applyLights(terrainShader, ShadingLod::FULL, intensity, sunDirection);
+            shadowMaps.applyUniforms(terrainShader, 4);
+
+            // Herbe : soleil et ambiant
+            grassShader.use();
+            grassShader.setUniform("view", view);
+            grassShader.setUniform("projection", projection);
+            grassShader.setUniform("viewPos", viewPos);
+            applyLights(grassShader, ShadingLod::SUN_ONLY, intensity, sunDirection);
+            shadowMaps.applyUniforms(grassShader, 4);
+
+            // Oiseaux : soleil et ambiant
+            birdShader.use();
+            birdShader.setUniform("view", view);
+            birdShader.setUniform("projection", projection);
+            birdShader.setUniform("viewPos", viewPos);
+            applyLights(birdShader, ShadingLod::SUN_ONLY, intensity, sunDirection);
+            shadowMaps.applyUniforms(birdShader, 4);
+
+            // Lumières ponctuelles qui touchent chaque objet
+            lights.cullLights(sceneIndex, sceneEntities.size(), sceneLightMasks);
+
+            // Les lampes statiques des objets précalculés sont déjà dans l'éclairage précalculé
+            for (size_t i = 0; i < sceneEntities.size() && bakedLighting; i++)
+            {
+                if (lightBaker.getOffset(i) >= 0)
+                {
+                    sceneLightMasks[i] = sceneLightMasks[i] & ~staticLampMask;
+                }
+            }
+
+            if (!gpuDriven)
+            {
+                auto submitStart = std::chrono::high_resolution_clock::now();
+                submitSceneCommands(true, bakedLighting, staticBatching);
+                submitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - submitStart).count();
+            }
+        }
+
+        renderQueue.sort();
+
+        // Dessin------------------------------------------------
+        renderShadowMaps();
+
+        if(Display::gDeferredShading)
+        {
+            deferredTimer.begin();
+
+            // Passe géométrique : albedo, normale et profondeur dans le G-buffer
+            gbuffer.resize(Display::gWindowWidth, Display::gWindowHeight);
+            gbuffer.bindGeometryPass();
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            // Terrain en premier : il cache une bonne partie de ce qui est derrière les collines
+            terrainGBufferShader.use();
+            terrainGBufferShader.setUniform("view", view);
+            terrainGBufferShader.setUniform("projection", projection);
+            terrainGBufferShader.setUniform("viewPos", viewPos);
+            terrain.draw(terrainGBufferShader, 7);
+
+            if (Display::gGrass)
+            {
+                grassGBufferShader.use();
+                grassGBufferShader.setUniform("view", view);
+                grassGBufferShader.setUniform("projection", projection);
+                grassGBufferShader.setUniform("viewPos", viewPos);
+                grass.draw(grassGBufferShader, (float)currentTime);
+            }
+
+            birdGBufferShader.use();
+            birdGBufferShader.setUniform("view", view);
+            birdGBufferShader.setUniform("projection", projection);
+            birds.draw(birdGBufferShader, (float)currentTime);
+
+            models.useShader(gbufferShader);
+            gbufferShader.setUniform("view", view);
+            gbufferShader.setUniform("projection", projection);
+            renderQueue.execute(RenderQueue::PASS_GEOMETRY, instanceBuffer);
+
+            impostorGBufferShader.use();
+            impostorGBufferShader.setUniform("view", view);
+            impostorGBufferShader.setUniform("projection", projection);
+            impostorGBufferShader.setUniform("viewPos", viewPos);
+            impostors.draw(impostorGBufferShader, 6);
+
+            impostors.bindAtlas(hlodGBufferShader, 6);
+            hlodGBufferShader.setUniform("view", view);
+            hlodGBufferShader.setUniform("projection", projection);
+            forestHlod.draw(hlodGBufferShader);
+
+            // Morceaux du monde autour du village
+            worldStreamer.draw(gbufferShader);
+
+            // Requêtes contre la profondeur des objets visibles, puis objets cachés en rendu conditionnel
+            if (Display::gOcclusionQueries)
+            {
+                occlusionQueries.issueQueries(occlusionBoxShader, projection * view, viewPos, queryItemsInView);
+            }
+            renderQueue.execute(RenderQueue::PASS_GEOMETRY_CONDITIONAL, instanceBuffer);
+
+            // Passe d'éclairage : chaque pixel est éclairé une seule fois
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glViewport(0, 0, Display::gWindowWidth, Display::gWindowHeight);
+            glDisable(GL_DEPTH_TEST);
+
+            deferredShader.use();
+            deferredShader.setUniform("invViewProjection", glm::inverse(projection * view));
+            deferredShader.setUniform("screenSize", glm::vec2((float)Display::gWindowWidth, (float)Display::gWindowHeight));
+            deferredShader.setUniform("viewPos", viewPos);
+            deferredShader.setUniform("view", view);
+            deferredShader.setUniformSampler("gAlbedo", 1);
+            deferredShader.setUniformSampler("gNormal", 2);
+            deferredShader.setUniformSampler("gDepth", 3);
+            applyLights(deferredShader, ShadingLod::FULL, intensity, sunDirection);
+            shadowMaps.applyUniforms(deferredShader, 4);
+
+            gbuffer.bindTextures(1);
+            gbuffer.drawFullscreen();
+
+            glEnable(GL_DEPTH_TEST);
+            gbuffer.blitDepth();
+
+            deferredTimer.end();
+        }
+        else
+        {
+            forwardTimer.begin();
+
+            if (bakedLighting)
+            {
+                lightBaker.bind(5);
+            }
+
+            // Terrain en premier : il cache une bonne partie de ce qui est derrière les collines
+            terrain.draw(terrainShader, 7);
+
+            // Herbe sur le terrain, un dessin instancié par lot visible
+            if (Display::gGrass)
+            {
+                grass.draw(grassShader, (float)currentTime);
+            }
+
+            // Nuée d'oiseaux, un seul dessin instancié
+            birds.draw(birdShader, (float)currentTime);
+
+            if (gpuDriven)
+            {
+                // Élimination par le compute shader puis un seul dessin indirect pour toute la scène
+                gpuSceneShader.use();
+                gpuSceneShader.setUniform("view", view);
+                gpuSceneShader.setUniform("projection", projection);
+                gpuSceneShader.setUniform("viewPos", viewPos);
+                applyLights(gpuSceneShader, ShadingLod::SUN_ONLY, intensity, sunDirection);
+                shadowMaps.applyUniforms(gpuSceneShader, 4);
+
+                auto submitStart = std::chrono::high_resolution_clock::now();
+                gpuScene.cull(frustum);
+                gpuScene.draw(gpuSceneShader, 6);
+                submitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - submitStart).count();
+
+                // Morceaux du monde autour du village (soleil et ambiant, uniforms du niveau SUN_ONLY)
+                worldStreamer.draw(*shadingShaders[ShadingLod::SUN_ONLY]);
+            }
+            else
+            {
+                // Tous les niveaux d'ombrage en une passe, triés par shader, texture, mesh et profondeur
+                auto executeStart = std::chrono::high_resolution_clock::now();
+                renderQueue.execute(RenderQueue::PASS_FORWARD, instanceBuffer);
+                submitMs = submitMs + std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - executeStart).count();
+
+                // Imposteurs des arbres lointains (soleil et ambiant)
+                impostorShader.use();
+                impostorShader.setUniform("view", view);
+                impostorShader.setUniform("projection", projection);
+                impostorShader.setUniform("viewPos", viewPos);
+                applyLights(impostorShader, ShadingLod::SUN_ONLY, intensity, sunDirection);
+                impostors.draw(impostorShader, 6);
+
+                // Proxys des cellules lointaines, un seul appel
+                impostors.bindAtlas(hlodShader, 6);
+                hlodShader.setUniform("view", view);
+                hlodShader.setUniform("projection", projection);
+                applyLights(hlodShader, ShadingLod::SUN_ONLY, intensity, sunDirection);
+                forestHlod.draw(hlodShader);
+
+                // Morceaux du monde autour du village (soleil et ambiant, uniforms du niveau SUN_ONLY)
+                worldStreamer.draw(*shadingShaders[ShadingLod::SUN_ONLY]);
+
+                // Requêtes contre la profondeur des objets visibles, puis objets cachés en rendu conditionnel
+                if (Display::gOcclusionQueries)
+                {
+                    occlusionQueries.issueQueries(occlusionBoxShader, projection * view, viewPos, queryItemsInView);
+                }
+                executeStart = std::chrono::high_resolution_clock::now();
+                renderQueue.execute(RenderQueue::PASS_FORWARD_CONDITIONAL, instanceBuffer);
+                submitMs = submitMs + std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - executeStart).count();
+            }
+
+            forwardTimer.end();
+        }
+
+        // Particules des feux par-dessus la scène opaque (profondeur testée, non écrite), un dessin par émetteur
+        particleShader.use();
+        particleShader.setUniform("view", view);
+        particleShader.setUniform("projection", projection);
+        particles.draw(particleShader);
+
+        // Comparaison des temps GPU des deux modes de rendu
+        std::ostringstream stats;
+        stats.precision(2);
+        stats << std::fixed
+              << (Display::gDeferredShading ? "Differe" : (gpuDriven ? "Direct (GPU)" : (bakedLighting ? "Direct (precalcule)" : "Direct"))) << "   "
+              << "Direct: " << forwardTimer.getElapsedMs() << " ms   "
+              << "Differe: " << deferredTimer.getElapsedMs() << " ms   "
+              << "Ombrage: " << shadingLod.getDrawCount(ShadingLod::FULL) << " / " << shadingLod.getDrawCount(ShadingLod::GOURAUD)
+              << " / " << shadingLod.getDrawCount(ShadingLod::SUN_ONLY) << "   "
+              << "Visibles: " << visibleCount - occludedCount - hlodCount << " (elimines: " << sceneEntities.size() - visibleCount << ", caches: " << occludedCount
+              << " en " << occlusionMs << " ms, " << occlusionCuller.getTriangleCount() << " triangles)   "
+              << "Requetes: " << occlusionQueries.getIssuedCount() << " (elements caches: " << occlusionQueries.getHiddenCount() << " / " << occlusionQueries.size() << ")   "
+              << "Imposteurs: " << impostors.getCount() << "   "
+              << "HLOD: " << forestHlod.getDrawnCount() << " / " << forestHlod.getCellCount() << " cellules (arbres remplaces: " << forestHlod.getReplacedCount() << ")   "
+              << "Herbe: " << (Display::gGrass ? grass.getDrawnCount() : 0) << " / " << grass.getResidentCount() << " touffes ("
+              << (Display::gGrass ? grass.getDrawnTiles() : 0) << " lots / " << grass.getTileCount() << " tuiles" << (Display::gGrass ? "" : ", inactive") << ")   "
+              << "Oiseaux: " << birds.getDrawnCount() << " / " << birds.getCount() << " (" << birds.getUpdateMs() << " ms)   "
+              << "Particules: " << particles.getParticleCount() << " (" << particles.getEmitterCount() << " emetteurs, " << (particles.isPersistent() ? "buffer persistant" : "copie") << ")   "
+              << "Terrain: " << terrain.getNodeCount() << " noeuds (" << terrain.getStreamedSamples() << " echantillons envoyes)   "
+              << "Morceaux: " << worldStreamer.getDrawnCount() << " / " << worldStreamer.getResidentCount() << " / " << worldStreamer.getSlotCount()
+              << " (en attente: " << worldStreamer.getPendingCount() << ", " << worldStreamer.getResidentBytes() / 1024 << " Ko)   "
+              << "Lots: " << (staticBatching ? batchDrawCount : 0) << " / " << staticBatcher.size() << " (" << staticBatcher.getObjectCount() << " objets" << (staticBatching ? "" : ", inactifs") << ")   "
+              << "Commandes: " << renderQueue.getCommandCount() << "   "
+              << "Changements d'etat: " << renderQueue.getStateChanges() << " (evites: " << renderQueue.getStateChangesAvoided() << ")   "
+              << "Instances envoyees: " << instanceBuffer.getUploadedCount() << "   "
+              << "Soumission CPU: " << submitMs << " ms (" << (gpuDriven ? "GPU, 1 dessin indirect" : "file de rendu") << ")   "
+              << "Ombres:";
+        for (int c = 0; c < ShadowMaps::CASCADE_COUNT; c++)
+        {
+            stats << " C" << c << " " << shadowTimers[c].getElapsedMs() << " ms" << (shadowMaps.needsRender(c) ? "" : " (cache)");
+        }
+        display.setStats(stats.str());
 
         // Echange des buffers----------------------------------
         glfwSwapBuffers(display.gWindow);
@@ -0,0 +1,269 @@
+#include "SceneFile.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "EntityStore.hpp"
+
+
+SceneFile::SceneFile() : mData(nullptr), mSize(0), mHeader(nullptr)
+{
+}
+
+SceneFile::~SceneFile()
+{
+    close();
+}
+
+// Taille et date de modification d'un fichier (false s'il n'existe pas)
+static bool getFileInfo(const std::string& filename, uint64_t& size, int64_t& time)
+{
+    struct stat info;
+    if(stat(filename.c_str(), &info) != 0)
+    {
+        return false;
+    }
+
+    size = (uint64_t)info.st_size;
+    time = (int64_t)info.st_mtime;
+    return true;
+}
+
+// Compiler la forme texte :
+//   entity <modèle> <x> <y> <z> <rotation Y en degrés> [noshadow]
+//   light <lamp|fire> <x> <y> <z> <diffuse> <constant> <linear> <exponent>
+// Les lignes vides et celles qui commencent par # sont ignorées.
+bool SceneFile::compile(const std::string& textFilename, const std::string& binaryFilename)
+{
+    std::ifstream text(textFilename);
+    if(!text)
+    {
+        std::cerr << "Impossible d'ouvrir la scene : " << textFilename << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> modelNames;
+    std::map<std::string, uint32_t> modelIndices;
+    std::vector<uint32_t> entityModels;
+    std::vector<float> columns[4]; // x, y, z, rotation Y
+    std::vector<uint8_t> flags;
+    std::vector<SceneLight> lights;
+
+    std::string line;
+    int lineNumber = 0;
+    while(std::getline(text, line))
+    {
+        lineNumber = lineNumber + 1;
+        std::istringstream ss(line);
+        std::string keyword;
+        if(!(ss >> keyword) || keyword[0] == '#')
+        {
+            continue;
+        }
+
+        bool valid = false;
+        if(keyword == "entity")
+        {
+            std::string name;
+            float values[4];
+            if(ss >> name >> values[0] >> values[1] >> values[2] >> values[3] && (int)name.size() < NAME_LENGTH)
+            {
+                std::string option;
+                uint8_t entityFlags = EntityStore::STATIC | EntityStore::CAST_SHADOW;
+                if(ss >> option && option == "noshadow")
+                {
+                    entityFlags = EntityStore::STATIC;
+                }
+
+                auto it = modelIndices.find(name);
+                if(it == modelIndices.end())
+                {
+                    it = modelIndices.insert({ name, (uint32_t)modelNames.size() }).first;
+                    modelNames.push_back(name);
+                }
+
+                entityModels.push_back(it->second);
+                for(int c = 0; c < 4; c = c + 1)
+                {
+                    columns[c].push_back(values[c]);
+                }
+                flags.push_back(entityFlags);
+                valid = true;
+            }
+        }
+        else if(keyword == "light")
+        {
+            std::string type;
+            SceneLight light;
+            if(ss >> type >> light.position.x >> light.position.y >> light.position.z >> light.diffuse >> light.constant >> light.linear >> light.exponent && (type == "lamp" || type == "fire"))
+            {
+                light.type = (type == "fire") ? SceneLight::FIRE : SceneLight::LAMP;
+                lights.push_back(light);
+                valid = true;
+            }
+        }
+
+        if(!valid)
+        {
+            std::cerr << "Erreur dans la scene " << textFilename << " ligne " << lineNumber << " : " << line << std::endl;
+            return false;
+        }
+    }
+
+    // En-tête, puis tables alignées sur 4 octets
+    SceneFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "RSCN", 4);
+    header.version = VERSION;
+    getFileInfo(textFilename, header.sourceSize, header.sourceTime);
+    header.modelCount = (uint32_t)modelNames.size();
+    header.entityCount = (uint32_t)entityModels.size();
+    header.lightCount = (uint32_t)lights.size();
+    header.modelsOffset = sizeof(SceneFileHeader);
+    header.entitiesOffset = header.modelsOffset + header.modelCount * NAME_LENGTH;
+    header.lightsOffset = header.entitiesOffset + ((header.entityCount * 21 + 3) & ~3u);
+
+    std::ofstream binary(binaryFilename, std::ios::binary);
+    if(!binary)
+    {
+        std::cerr << "Impossible d'ecrire la scene : " << binaryFilename << std::endl;
+        return false;
+    }
+
+    binary.write((const char*)&header, sizeof(header));
+    for(const std::string& name : modelNames)
+    {
+        char buffer[NAME_LENGTH] = {};
+        std::memcpy(buffer, name.c_str(), name.size());
+        binary.write(buffer, NAME_LENGTH);
+    }
+    binary.write((const char*)entityModels.data(), entityModels.size() * sizeof(uint32_t));
+    for(int c = 0; c < 4; c = c + 1)
+    {
+        binary.write((const char*)columns[c].data(), columns[c].size() * sizeof(float));
+    }
+    binary.write((const char*)flags.data(), flags.size());
+    const char padding[4] = {};
+    binary.write(padding, (4 - flags.size() % 4) % 4);
+    binary.write((const char*)lights.data(), lights.size() * sizeof(SceneLight));
+
+    return binary.good();
+}
+
+// Binaire compilé depuis la version actuelle du texte (sans texte, le binaire seul fait foi)
+bool SceneFile::isUpToDate(const std::string& textFilename, const std::string& binaryFilename)
+{
+    std::ifstream binary(binaryFilename, std::ios::binary);
+    SceneFileHeader header;
+    if(!binary || !binary.read((char*)&header, sizeof(header)) || std::memcmp(header.magic, "RSCN", 4) != 0 || header.version != VERSION)
+    {
+        return false;
+    }
+
+    uint64_t size = 0;
+    int64_t time = 0;
+    if(!getFileInfo(textFilename, size, time))
+    {
+        return true;
+    }
+    return size == header.sourceSize && time == header.sourceTime;
+}
+
+// Projeter le fichier binaire en mémoire (lecture seule) et vérifier que les tables tiennent dans le fichier
+bool SceneFile::open(const std::string& filename)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    mSize = (size_t)fileSize.QuadPart;
+    HANDLE mapping = (mSize > 0) ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    CloseHandle(file);
+    if(mapping == NULL)
+    {
+        return false;
+    }
+
+    mData = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+#else
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if(file < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    fstat(file, &info);
+    mSize = (size_t)info.st_size;
+    void* data = (mSize > 0) ? mmap(NULL, mSize, PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    ::close(file);
+    mData = (data != MAP_FAILED) ? (const uint8_t*)data : nullptr;
+#endif
+
+    if(mData == nullptr)
+    {
+        mSize = 0;
+        return false;
+    }
+
+    mHeader = (const SceneFileHeader*)mData;
+    bool valid = mSize >= sizeof(SceneFileHeader) && std::memcmp(mHeader->magic, "RSCN", 4) == 0 && mHeader->version == VERSION
+        && (uint64_t)mHeader->modelsOffset + (uint64_t)mHeader->modelCount * NAME_LENGTH <= mSize
+        && (uint64_t)mHeader->entitiesOffset + (uint64_t)mHeader->entityCount * 21 <= mSize
+        && (uint64_t)mHeader->lightsOffset + (uint64_t)mHeader->lightCount * sizeof(SceneLight) <= mSize
+        && mHeader->entitiesOffset % 4 == 0 && mHeader->lightsOffset % 4 == 0;
+
+    for(uint32_t i = 0; valid && i < mHeader->modelCount; i = i + 1)
+    {
+        valid = getModelName(i)[NAME_LENGTH - 1] == '\0';
+    }
+    for(uint32_t i = 0; valid && i < mHeader->entityCount; i = i + 1)
+    {
+        valid = getEntityModels()[i] < mHeader->modelCount;
+    }
+
+    if(!valid)
+    {
+        std::cerr << "Fichier de scene invalide : " << filename << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Libérer la projection
+void SceneFile::close()
+{
+    if(mData != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(mData);
+#else
+        munmap((void*)mData, mSize);
+#endif
+    }
+    mData = nullptr;
+    mSize = 0;
+    mHeader = nullptr;
+}
@@ -0,0 +1,82 @@
+#ifndef SCENE_FILE_HPP
+#define SCENE_FILE_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+// Lumière ponctuelle de la scène (table des lumières du fichier, 32 octets)
+struct SceneLight
+{
+    enum Type : uint32_t
+    {
+        LAMP = 0, // Lampe fixe, précalculée dans l'éclairage statique
+        FIRE = 1 // Feu : couleur et intensité qui varient à chaque image
+    };
+
+    glm::vec3 position;
+    float diffuse; // Intensité diffuse (blanc pour une lampe, intensité de base pour un feu)
+    float constant; // Atténuation
+    float linear;
+    float exponent;
+    uint32_t type;
+};
+
+// En-tête du fichier de scène binaire (les décalages sont comptés depuis le début du fichier)
+struct SceneFileHeader
+{
+    char magic[4]; // "RSCN"
+    uint32_t version;
+    uint64_t sourceSize; // Taille et date du fichier texte compilé (recompilation s'il change)
+    int64_t sourceTime;
+    uint32_t modelCount; // Table des noms de modèles (NAME_LENGTH octets par nom)
+    uint32_t entityCount; // Colonnes des entités : modèle, x, y, z, rotation Y (4 octets), drapeaux (1 octet)
+    uint32_t lightCount; // Table des lumières (SceneLight)
+    uint32_t modelsOffset;
+    uint32_t entitiesOffset;
+    uint32_t lightsOffset;
+};
+
+// Fichier de scène : tables des modèles référencés, des entités (en colonnes, comme EntityStore)
+// et des lumières. La scène est écrite sous forme texte (une ligne par entité ou lumière) puis
+// compilée en binaire ; le binaire est projeté en mémoire (mmap) et ses colonnes sont copiées
+// telles quelles dans les tableaux de la scène, sans analyse au chargement.
+class SceneFile
+{
+public:
+    static const uint32_t VERSION = 1;
+    static const int NAME_LENGTH = 32; // Nom de modèle, zéro final compris
+
+    SceneFile();
+    ~SceneFile();
+
+    static bool compile(const std::string& textFilename, const std::string& binaryFilename); // Compiler la forme texte en binaire
+    static bool isUpToDate(const std::string& textFilename, const std::string& binaryFilename); // Binaire compilé depuis la version actuelle du texte
+
+    bool open(const std::string& filename); // Projeter le fichier binaire en mémoire et vérifier son en-tête
+    void close(); // Libérer la projection
+
+    uint32_t getModelCount() const { return mHeader->modelCount; }
+    const char* getModelName(uint32_t index) const { return (const char*)(mData + mHeader->modelsOffset) + index * NAME_LENGTH; }
+
+    uint32_t getEntityCount() const { return mHeader->entityCount; }
+    const uint32_t* getEntityModels() const { return (const uint32_t*)(mData + mHeader->entitiesOffset); } // Index dans la table des modèles
+    const float* getPositionsX() const { return getColumn(1); }
+    const float* getPositionsY() const { return getColumn(2); }
+    const float* getPositionsZ() const { return getColumn(3); }
+    const float* getYaws() const { return getColumn(4); } // Rotations Y en degrés
+    const uint8_t* getFlags() const { return (const uint8_t*)getColumn(5); } // Drapeaux de EntityStore
+
+    uint32_t getLightCount() const { return mHeader->lightCount; }
+    const SceneLight* getLights() const { return (const SceneLight*)(mData + mHeader->lightsOffset); }
+
+private:
+    const float* getColumn(int column) const { return (const float*)(mData + mHeader->entitiesOffset + (size_t)column * mHeader->entityCount * 4); }
+
+    const uint8_t* mData; // Fichier projeté (le fichier est fermé dès la projection créée)
+    size_t mSize;
+    const SceneFileHeader* mHeader;
+};
+
+#endif // SCENE_FILE_HPP
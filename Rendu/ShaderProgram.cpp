@@ -53,6 +53,30 @@ bool ShaderProgram::loadShaders(const char* vsFilename, const char* fsFilename)
     return true;
 }
 
+// Charger un compute shader seul dans le programme
+bool ShaderProgram::loadComputeShader(const char* csFilename)
+{
+    string csString = fileToString(csFilename); // Lire le fichier du Compute Shader
+    const GLchar* csSourcePtr = csString.c_str();
+
+    GLuint cs = glCreateShader(GL_COMPUTE_SHADER); // Creation du Compute Shader
+    glShaderSource(cs, 1, &csSourcePtr, NULL);
+
+    glCompileShader(cs); // Compilation du shader
+    checkCompileErrors(cs, ShaderType::COMPUTE); // Verifier les erreurs de compilation
+
+    mHandle = glCreateProgram(); // Creation du programme de shader
+    glAttachShader(mHandle, cs);
+    glLinkProgram(mHandle); // Lien du programme de shader
+    checkCompileErrors(mHandle, ShaderType::PROGRAM); // Verifier les erreurs de liaison
+
+    glDeleteShader(cs); // Suppression du Compute Shader
+
+    mUniformLocations.clear(); // Initialisation des uniformes
+
+    return true;
+}
+
 // Utiliser le programme de shader
 void ShaderProgram::use() 
 {
@@ -114,7 +138,7 @@ void ShaderProgram::checkCompileErrors(GLuint object, ShaderType type)
         }
     }
 
-    else // VERTEX ou FRAGMENT
+    else // VERTEX, FRAGMENT ou COMPUTE
     {
         glGetShaderiv(object, GL_COMPILE_STATUS, &status); // Obtenir le status de la compilation
 
@@ -199,6 +223,18 @@ void ShaderProgram::setUniform(const GLchar* name, const GLfloat f)
     glUniform1f(localisation, f); // Definir l'uniforme
 }
 
+// Definir un uniform de type int ou bool
+void ShaderProgram::setUniform(const GLchar* name, const GLint i)
+{
+    GLint localisation = getUniformLocation(name); // Obtenir l'emplacement de l'uniforme
+    if (localisation == -1) 
+    {
+        std::cerr << "Uniform '" << name << "' non trouve dans le shader." << std::endl;
+        return;
+    }
+    glUniform1i(localisation, i); // Definir l'uniforme
+}
+
 // Definir un uniform de type sampler2D
 void ShaderProgram::setUniformSampler(const GLchar* name, const GLint slot)
 {
@@ -18,10 +18,12 @@ public:
     {
         VERTEX,
         FRAGMENT,
+        COMPUTE,
         PROGRAM
     };
 
     bool loadShaders(const char* vsFilename, const char* fsFilename); // Charger les shaders
+    bool loadComputeShader(const char* csFilename); // Charger un compute shader (OpenGL 4.3)
     void use(); // Utiliser le programme de shader
 
     void setUniform(const GLchar* name, const glm::vec2& v); // Definir un uniform de type vec2
@@ -29,6 +31,7 @@ public:
     void setUniform(const GLchar* name, const glm::vec4& v); // Definir un uniform de type vec4
     void setUniform(const GLchar* name, const glm::mat4& m); // Definir un uniform de type mat4
     void setUniform(const GLchar* name, const GLfloat f); // Definir un uniform de type float
+    void setUniform(const GLchar* name, const GLint i); // Definir un uniform de type int ou bool
     void setUniformSampler(const GLchar* name, const GLint slot); // Definir un uniform de type sampler2D
 
     GLuint getProgram() const; // Obtenir l'identifiant du programme de shader
@@ -0,0 +1,48 @@
+#version 330 core
+
+// Oiseaux de la nuée instanciés : orientés selon leur vitesse, battement d'ailes (avec lighting_sun.frag ou gbuffer.frag)
+
+layout (location = 0) in vec3 pos;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 texCoord;
+layout (location = 3) in vec4 instancePosition; // Position, phase du battement d'ailes
+layout (location = 4) in vec4 instanceVelocity; // Vitesse, amplitude du battement
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 modelScale; // Échelle du modèle
+uniform float halfSpan; // Demi-envergure (bout des ailes en z local)
+uniform float time;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out vec4 Baked; // R : soleil, G : lampes / 2, A : occlusion ambiante
+flat out uint LightMask;
+flat out int BakeOffset;
+flat out float LodFade;
+
+void main()
+{
+	// Repère du vol : le modèle regarde vers +x, ailes selon z
+	vec3 forward = normalize(instanceVelocity.xyz);
+	vec3 up = normalize(vec3(0.0f, 1.0f, 0.0f) - forward * forward.y);
+	vec3 side = cross(forward, up);
+
+	// Battement : les ailes montent et descendent d'autant plus qu'elles s'éloignent du corps
+	vec3 local = pos * modelScale;
+	float wing = clamp(abs(local.z) / halfSpan, 0.0f, 1.0f);
+	local.y = local.y + sin(time * 12.0f + instancePosition.w) * instanceVelocity.w * wing * halfSpan * 0.5f;
+
+	vec3 n = normal / modelScale;
+	FragPos = instancePosition.xyz + forward * local.x + up * local.y + side * local.z;
+	Normal = forward * n.x + up * n.y + side * n.z;
+
+	TexCoord = texCoord;
+	Baked = vec4(1.0f);
+	LightMask = 0u;
+	BakeOffset = -1;
+	LodFade = 0.0f;
+
+	gl_Position = projection * view * vec4(FragPos, 1.0f);
+}
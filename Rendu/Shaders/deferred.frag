@@ -0,0 +1,222 @@
+#version 330 core
+
+struct Material
+{
+    vec3 ambient;
+    vec3 specular;
+    float shininess;
+};
+
+struct DirectionalLight
+{
+	vec3 direction;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+};
+
+struct PointLight
+{
+	vec3 position;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+
+	float constant;
+	float linear;
+	float exponent;
+	float radius; // Rayon d'influence
+};
+
+struct SpotLight
+{
+	vec3 position;
+	vec3 direction;
+	float cosInnerCone;
+	float cosOuterCone;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	bool on;
+
+	float constant;
+	float linear;
+	float exponent;
+};
+
+
+#define POINT_LIGHTS 3
+#define SHADOW_CASCADES 3
+
+uniform sampler2D gAlbedo;
+uniform sampler2D gNormal;
+uniform sampler2D gDepth;
+uniform mat4 invViewProjection;
+uniform vec2 screenSize;
+
+uniform DirectionalLight sunLight;
+uniform PointLight pointLights[POINT_LIGHTS];
+uniform SpotLight spotLight;
+uniform Material material;
+uniform vec3 viewPos;
+uniform mat4 view;
+uniform sampler2DArrayShadow shadowMap; // Cascades d'ombre du soleil
+uniform mat4 lightSpaceMatrices[SHADOW_CASCADES];
+uniform vec3 cascadeSplits; // Distance de fin de chaque cascade
+
+out vec4 frag_color;
+
+
+// Décoder une normale encodée en octaèdre
+vec3 octDecode(vec2 e)
+{
+	e = e * 2.0f - 1.0f;
+	vec3 n = vec3(e.xy, 1.0f - abs(e.x) - abs(e.y));
+	if (n.z < 0.0f)
+	{
+		n.xy = (1.0f - abs(n.yx)) * vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+	}
+	return normalize(n);
+}
+
+
+// Facteur d'ombre du soleil (1 : éclairé, 0 : dans l'ombre)
+float calcShadow(vec3 fragPos, vec3 normal)
+{
+	// Choix de la cascade selon la profondeur dans l'espace vue
+	float viewDepth = -(view * vec4(fragPos, 1.0f)).z;
+	if (viewDepth > cascadeSplits.z)
+	{
+		return 1.0f; // Au-delà de la distance des ombres
+	}
+	int cascade = (viewDepth > cascadeSplits.x) ? ((viewDepth > cascadeSplits.y) ? 2 : 1) : 0;
+
+	// Position dans la cascade, décalée le long de la normale contre l'acné
+	vec4 lightPos = lightSpaceMatrices[cascade] * vec4(fragPos + normal * 0.05f * float(cascade + 1), 1.0f);
+	vec3 projPos = lightPos.xyz / lightPos.w * 0.5f + 0.5f;
+
+	// PCF : 4 comparaisons filtrées par le matériel
+	vec2 texelSize = 1.0f / vec2(textureSize(shadowMap, 0).xy);
+	float shadow = 0.0f;
+	shadow = shadow + texture(shadowMap, vec4(projPos.xy + vec2(-0.5f, -0.5f) * texelSize, float(cascade), projPos.z));
+	shadow = shadow + texture(shadowMap, vec4(projPos.xy + vec2( 0.5f, -0.5f) * texelSize, float(cascade), projPos.z));
+	shadow = shadow + texture(shadowMap, vec4(projPos.xy + vec2(-0.5f,  0.5f) * texelSize, float(cascade), projPos.z));
+	shadow = shadow + texture(shadowMap, vec4(projPos.xy + vec2( 0.5f,  0.5f) * texelSize, float(cascade), projPos.z));
+	return shadow * 0.25f;
+}
+
+
+// Calculer l'effet de la lumière directionnelle
+vec3 calcDirectionalLightColor(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 albedo, float shadow)
+{
+	vec3 lightDir = normalize(-light.direction);
+
+	// Diffus
+    float NdotL = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * NdotL * albedo;
+
+    // Spéculaire (Blinn-Phong)
+	vec3 halfDir = normalize(lightDir + viewDir);
+	float NDotH = max(dot(normal, halfDir), 0.0f);
+	vec3 specular = light.specular * material.specular * pow(NDotH, material.shininess);
+
+	return (diffuse + specular) * shadow;
+}
+
+
+// Calculer l'effet de la lumière ponctuelle
+vec3 calcPointLightColor(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo)
+{
+	vec3 lightDir = normalize(light.position - fragPos);
+
+	// Diffus
+    float NdotL = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * NdotL * albedo;
+
+    // Spéculaire (Blinn-Phong)
+	vec3 halfDir = normalize(lightDir + viewDir);
+	float NDotH = max(dot(normal, halfDir), 0.0f);
+	vec3 specular = light.specular * material.specular * pow(NDotH, material.shininess);
+
+	// Atténuation (nulle au-delà du rayon d'influence)
+	float d = length(light.position - fragPos);
+	float attenuation = 1.0f / (light.constant + light.linear * d + light.exponent * (d * d));
+	attenuation = attenuation * step(d, light.radius);
+
+	diffuse = diffuse * attenuation;
+	specular = specular * attenuation;
+
+	return (diffuse + specular);
+}
+
+
+// Calculer l'effet de la lampe torche
+vec3 calcSpotLightColor(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo)
+{
+	vec3 lightDir = normalize(light.position - fragPos);
+	vec3 spotDir  = normalize(light.direction);
+
+	float cosDir = dot(-lightDir, spotDir);  // angle entre le vecteur direction de la lumière et celui de la lampe torche
+	float spotIntensity = smoothstep(light.cosOuterCone, light.cosInnerCone, cosDir);
+
+	// Diffus
+    float NdotL = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * NdotL * albedo;
+
+    // Spéculaire (Blinn-Phong)
+	vec3 halfDir = normalize(lightDir + viewDir);
+	float NDotH = max(dot(normal, halfDir), 0.0f);
+	vec3 specular = light.specular * material.specular * pow(NDotH, material.shininess);
+
+	// Atténuation
+	float d = length(light.position - fragPos);
+	float attenuation = 1.0f / (light.constant + light.linear * d + light.exponent * (d * d));
+
+	diffuse = diffuse * attenuation * spotIntensity;
+	specular = specular * attenuation * spotIntensity;
+
+	return (diffuse + specular);
+}
+
+
+void main()
+{
+	vec2 uv = gl_FragCoord.xy / screenSize;
+	float depth = texture(gDepth, uv).r;
+
+	// Aucun objet : on garde la couleur de fond
+	if (depth >= 1.0f)
+	{
+		discard;
+	}
+
+	// Reconstruction de la position à partir de la profondeur
+	vec4 clipPos = vec4(vec3(uv, depth) * 2.0f - 1.0f, 1.0f);
+	vec4 worldPos = invViewProjection * clipPos;
+	vec3 fragPos = worldPos.xyz / worldPos.w;
+
+	vec3 albedo = texture(gAlbedo, uv).rgb;
+	vec3 normal = octDecode(texture(gNormal, uv).rg);
+	vec3 viewDir = normalize(viewPos - fragPos);
+
+    // Ambiant
+	vec3 ambient = spotLight.ambient * material.ambient * albedo;
+	vec3 outColor = vec3(0.0f);
+
+	// Ajouter la couleur de la lumière du soleil
+	outColor = outColor + calcDirectionalLightColor(sunLight, normal, viewDir, albedo, calcShadow(fragPos, normal));
+
+	// Appliquer chaque lumière ponctuelle
+	for(int i = 0; i < POINT_LIGHTS; i++)
+	{
+		outColor = outColor + calcPointLightColor(pointLights[i], normal, fragPos, viewDir, albedo);
+	}
+
+	// Appliquer la lumière de la lampe torche si elle est activée
+	if (spotLight.on)
+	{
+		outColor = outColor + calcSpotLightColor(spotLight, normal, fragPos, viewDir, albedo);
+	}
+
+	frag_color = vec4(ambient + outColor, 1.0f);
+}
@@ -0,0 +1,8 @@
+#version 330 core
+
+// Triangle plein écran généré à partir de gl_VertexID (aucun VBO)
+void main()
+{
+	vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	gl_Position = vec4(p * 2.0f - 1.0f, 0.0f, 1.0f);
+}
@@ -0,0 +1,49 @@
+#version 330 core
+
+struct Material 
+{
+    sampler2D diffuseMap;
+};
+
+in vec2 TexCoord;
+in vec3 Normal;
+flat in float LodFade; // Fondu vers l'imposteur (0 : maillage seul)
+
+uniform Material material;
+
+layout (location = 0) out vec4 gAlbedo;
+layout (location = 1) out vec2 gNormal;
+
+
+// Encoder une normale unitaire en octaèdre dans [0, 1]²
+vec2 octEncode(vec3 n)
+{
+	n = n / (abs(n.x) + abs(n.y) + abs(n.z));
+	vec2 e = n.xy;
+	if (n.z < 0.0f)
+	{
+		e = (1.0f - abs(n.yx)) * vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+	}
+	return e * 0.5f + 0.5f;
+}
+
+
+// Seuil de tramage ordonné 4x4 du pixel (fondu entre maillage et imposteur)
+float ditherThreshold()
+{
+	const float bayer[16] = float[16](0.0f, 8.0f, 2.0f, 10.0f, 12.0f, 4.0f, 14.0f, 6.0f, 3.0f, 11.0f, 1.0f, 9.0f, 15.0f, 7.0f, 13.0f, 5.0f);
+	ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+	return (bayer[p.y * 4 + p.x] + 0.5f) / 16.0f;
+}
+
+
+void main()
+{ 
+	if (ditherThreshold() < LodFade)
+	{
+		discard; // Pixel dessiné par l'imposteur
+	}
+
+	gAlbedo = vec4(vec3(texture(material.diffuseMap, TexCoord)), 1.0f);
+	gNormal = octEncode(normalize(Normal));
+}
@@ -0,0 +1,25 @@
+#version 330 core
+
+layout (location = 0) in vec3 pos;			
+layout (location = 1) in vec3 normal;	
+layout (location = 2) in vec2 texCoord;
+layout (location = 3) in mat4 instanceModel; // Matrice de modèle de l'instance
+layout (location = 7) in mat3 instanceNormalMatrix; // Matrice des normales précalculée
+layout (location = 12) in float instanceLodFade; // Fondu vers l'imposteur (0 : maillage seul)
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 Normal;
+out vec2 TexCoord;
+flat out float LodFade;
+
+void main()
+{
+    Normal = instanceNormalMatrix * normal;
+
+	TexCoord = texCoord;
+	LodFade = instanceLodFade;
+
+	gl_Position = projection * view * instanceModel * vec4(pos, 1.0f);
+}
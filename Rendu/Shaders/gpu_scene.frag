@@ -0,0 +1,91 @@
+#version 430 core
+
+// Scène dessinée par le GPU (avec gpu_scene.vert) : soleil, ombres et ambiant, texture lue dans un tableau
+
+struct Material
+{
+    vec3 ambient;
+    vec3 specular;
+    float shininess;
+};
+
+struct DirectionalLight
+{
+	vec3 direction;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+};
+
+struct SpotLight
+{
+	vec3 position;
+	vec3 direction;
+	float cosInnerCone;
+	float cosOuterCone;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	bool on;
+
+	float constant;
+	float linear;
+	float exponent;
+};
+
+
+in vec2 TexCoord;
+in vec3 FragPos;
+in vec3 Normal;
+flat in float Layer; // Couche du tableau de textures
+
+#define SHADOW_CASCADES 3
+
+uniform DirectionalLight sunLight;
+uniform SpotLight spotLight; // Seule la composante ambiante est utilisée
+uniform Material material;
+uniform sampler2DArray diffuseMaps; // Une couche par modèle
+uniform vec3 viewPos;
+uniform mat4 view;
+uniform sampler2DArrayShadow shadowMap; // Cascades d'ombre du soleil
+uniform mat4 lightSpaceMatrices[SHADOW_CASCADES];
+uniform vec3 cascadeSplits; // Distance de fin de chaque cascade
+
+out vec4 frag_color;
+
+
+// Facteur d'ombre du soleil, une seule comparaison filtrée
+float calcShadow(vec3 fragPos, vec3 normal)
+{
+	float viewDepth = -(view * vec4(fragPos, 1.0f)).z;
+	if (viewDepth > cascadeSplits.z)
+	{
+		return 1.0f; // Au-delà de la distance des ombres
+	}
+	int cascade = (viewDepth > cascadeSplits.x) ? ((viewDepth > cascadeSplits.y) ? 2 : 1) : 0;
+
+	vec4 lightPos = lightSpaceMatrices[cascade] * vec4(fragPos + normal * 0.05f * float(cascade + 1), 1.0f);
+	vec3 projPos = lightPos.xyz / lightPos.w * 0.5f + 0.5f;
+	return texture(shadowMap, vec4(projPos.xy, float(cascade), projPos.z));
+}
+
+
+void main()
+{
+	vec3 normal = normalize(Normal);
+	vec3 viewDir = normalize(viewPos - FragPos);
+	vec3 albedo = vec3(texture(diffuseMaps, vec3(TexCoord, Layer)));
+
+    // Ambiant
+	vec3 ambient = spotLight.ambient * material.ambient * albedo;
+
+	float shadow = calcShadow(FragPos, normal);
+
+	// Soleil (Blinn-Phong)
+	vec3 lightDir = normalize(-sunLight.direction);
+	float NdotL = max(dot(normal, lightDir), 0.0f);
+	float NDotH = max(dot(normal, normalize(lightDir + viewDir)), 0.0f);
+	vec3 sun = sunLight.diffuse * NdotL * albedo + sunLight.specular * material.specular * pow(NDotH, material.shininess);
+
+	frag_color = vec4(ambient + sun * shadow, 1.0f);
+}
@@ -0,0 +1,39 @@
+#version 430 core
+
+// Scène dessinée par le GPU : l'instance est lue dans le SSBO à partir de l'index écrit par gpu_cull.comp
+
+layout (location = 0) in vec3 pos;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 texCoord;
+layout (location = 3) in uint instanceId; // Index de l'instance visible (un pas par instance)
+
+struct Instance
+{
+	mat4 model;
+	vec4 normalMatrix[3];
+	vec4 boundsMin;
+	vec4 boundsMax;
+	uvec4 info; // x : commande de dessin, y : couche de texture
+};
+
+layout (std430, binding = 0) readonly buffer Instances { Instance instances[]; };
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+flat out float Layer;
+
+void main()
+{
+	Instance instance = instances[instanceId];
+
+	FragPos = vec3(instance.model * vec4(pos, 1.0f));
+	Normal = mat3(instance.normalMatrix[0].xyz, instance.normalMatrix[1].xyz, instance.normalMatrix[2].xyz) * normal;
+	TexCoord = texCoord;
+	Layer = float(instance.info.y);
+
+	gl_Position = projection * view * vec4(FragPos, 1.0f);
+}
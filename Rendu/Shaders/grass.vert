@@ -0,0 +1,63 @@
+#version 330 core
+
+// Touffes d'herbe instanciées : densité selon la distance et vent (avec lighting_sun.frag ou gbuffer.frag)
+
+layout (location = 0) in vec3 pos;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 texCoord;
+layout (location = 3) in vec4 instancePosition; // Pied de la touffe, rotation Y
+layout (location = 4) in vec2 instanceParams; // Échelle, rang (ordre de disparition)
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 viewPos;
+uniform vec3 modelScale; // Échelle du modèle
+uniform float bladeHeight; // Hauteur du maillage (0 au pied, 1 en haut pour le vent)
+uniform vec2 fadeRange; // Distance de début de la baisse de densité, distance de densité nulle
+uniform float densityScale; // Réduction imposée par le budget de touffes
+uniform float fadeBand; // Part de la densité sur laquelle une touffe s'efface
+uniform float time;
+uniform vec2 windDirection; // Direction du vent (XZ, unitaire)
+uniform float windStrength; // Déplacement du haut des touffes
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out vec4 Baked; // R : soleil, G : lampes / 2, A : occlusion ambiante
+flat out uint LightMask;
+flat out int BakeOffset;
+flat out float LodFade;
+
+
+void main()
+{
+	// Densité au pied de la touffe (comme GrassField::getDensity) : la touffe s'efface quand son rang l'atteint
+	vec3 root = instancePosition.xyz;
+	float density = clamp((fadeRange.y - length(viewPos - root)) / (fadeRange.y - fadeRange.x), 0.0f, 1.0f) * densityScale;
+	LodFade = clamp((instanceParams.y - density) / fadeBand + 1.0f, 0.0f, 1.0f);
+	if (LodFade >= 1.0f)
+	{
+		gl_Position = vec4(2.0f, 2.0f, 2.0f, 1.0f); // Touffe disparue : hors du volume de vue, aucun fragment
+		return;
+	}
+
+	// Rotation Y et échelle de la touffe
+	float c = cos(instancePosition.w);
+	float s = sin(instancePosition.w);
+	vec3 local = pos * modelScale * instanceParams.x;
+	vec3 n = normal / modelScale;
+	FragPos = root + vec3(c * local.x + s * local.z, local.y, c * local.z - s * local.x);
+	Normal = vec3(c * n.x + s * n.z, n.y, c * n.z - s * n.x);
+
+	// Vent : rafales qui avancent dans sa direction et frémissement propre à chaque touffe, le pied reste fixe
+	float bend = clamp(pos.y / bladeHeight, 0.0f, 1.0f);
+	float gust = 0.5f + 0.35f * sin(time * 1.7f - dot(root.xz, windDirection) * 0.35f) + 0.15f * sin(time * 4.3f + instanceParams.y * 97.0f);
+	FragPos.xz = FragPos.xz + windDirection * windStrength * bend * bend * gust;
+
+	TexCoord = texCoord;
+	Baked = vec4(1.0f);
+	LightMask = 0u;
+	BakeOffset = -1;
+
+	gl_Position = projection * view * vec4(FragPos, 1.0f);
+}
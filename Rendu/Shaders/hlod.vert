@@ -0,0 +1,25 @@
+#version 330 core
+
+// Proxys des cellules lointaines de la forêt (avec impostor.frag ou impostor_gbuffer.frag)
+
+layout (location = 0) in vec3 pos; // Position en monde
+layout (location = 1) in vec3 texCoord; // Coordonnées dans l'atlas d'imposteurs et couche
+layout (location = 2) in vec2 rotation; // Cosinus et sinus de la rotation Y de l'arbre
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 TexCoord;
+out vec3 FragPos;
+flat out vec2 Rotation;
+flat out float LodFade;
+
+void main()
+{
+	FragPos = pos;
+	TexCoord = texCoord;
+	Rotation = rotation;
+	LodFade = 1.0f; // Pas de fondu : toute la carte est dessinée
+
+	gl_Position = projection * view * vec4(pos, 1.0f);
+}
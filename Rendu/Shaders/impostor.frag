@@ -0,0 +1,77 @@
+#version 330 core
+
+// Imposteurs des objets lointains : soleil et ambiant comme le niveau d'ombrage SUN_ONLY (sans ombres)
+
+struct Material
+{
+    vec3 ambient;
+    sampler2D diffuseMap;
+    vec3 specular;
+    float shininess;
+};
+
+struct DirectionalLight
+{
+	vec3 direction;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+};
+
+struct SpotLight
+{
+	vec3 position;
+	vec3 direction;
+	float cosInnerCone;
+	float cosOuterCone;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	bool on;
+
+	float constant;
+	float linear;
+	float exponent;
+};
+
+in vec3 TexCoord;
+in vec3 FragPos;
+flat in vec2 Rotation;
+flat in float LodFade;
+
+uniform DirectionalLight sunLight;
+uniform SpotLight spotLight; // Seule la composante ambiante est utilisée
+uniform Material material;
+uniform sampler2DArray impostorAlbedo; // Alpha : couverture
+uniform sampler2DArray impostorNormal; // Normale locale dans [0, 1]
+
+out vec4 frag_color;
+
+
+// Seuil de tramage ordonné 4x4 du pixel (fondu entre maillage et imposteur)
+float ditherThreshold()
+{
+	const float bayer[16] = float[16](0.0f, 8.0f, 2.0f, 10.0f, 12.0f, 4.0f, 14.0f, 6.0f, 3.0f, 11.0f, 1.0f, 9.0f, 15.0f, 7.0f, 13.0f, 5.0f);
+	ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+	return (bayer[p.y * 4 + p.x] + 0.5f) / 16.0f;
+}
+
+
+void main()
+{
+	vec4 albedo = texture(impostorAlbedo, TexCoord);
+	if (albedo.a < 0.5f || ditherThreshold() >= LodFade)
+	{
+		discard; // Hors de la silhouette, ou pixel encore dessiné par le maillage
+	}
+
+	// Normale locale vers le monde (rotation Y de l'instance)
+	vec3 n = texture(impostorNormal, TexCoord).xyz * 2.0f - 1.0f;
+	vec3 normal = normalize(vec3(Rotation.x * n.x + Rotation.y * n.z, n.y, -Rotation.y * n.x + Rotation.x * n.z));
+
+	vec3 ambient = spotLight.ambient * material.ambient * albedo.rgb;
+	vec3 lightDir = normalize(-sunLight.direction);
+	vec3 sun = sunLight.diffuse * max(dot(normal, lightDir), 0.0f) * albedo.rgb;
+
+	frag_color = vec4(ambient + sun, 1.0f);
+}
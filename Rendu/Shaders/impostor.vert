@@ -0,0 +1,40 @@
+#version 330 core
+
+layout (location = 0) in vec4 instanceSphere; // Centre de la sphère englobante en monde, rayon
+layout (location = 1) in vec4 instanceParams; // Cosinus et sinus de la rotation Y, couche de l'atlas, fondu
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 viewPos;
+uniform int frames; // Directions par côté de l'atlas
+
+out vec3 TexCoord; // Coordonnées dans l'atlas et couche
+out vec3 FragPos;
+flat out vec2 Rotation; // Cosinus et sinus de la rotation Y (normales de l'atlas vers le monde)
+flat out float LodFade;
+
+void main()
+{
+	// Quad face à la caméra en bande de 4 sommets, même construction du haut que le précalcul
+	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0f - 1.0f;
+	vec3 center = instanceSphere.xyz;
+	vec3 toCamera = normalize(viewPos - center);
+	vec3 right = normalize(cross(vec3(0.0f, 1.0f, 0.0f), toCamera));
+	vec3 up = cross(toCamera, right);
+	FragPos = center + (right * corner.x + up * corner.y) * instanceSphere.w;
+
+	// Direction de la caméra dans l'espace du modèle (rotation Y inverse), limitée à l'hémisphère supérieur
+	float c = instanceParams.x;
+	float s = instanceParams.y;
+	vec3 direction = vec3(c * toCamera.x - s * toCamera.z, max(toCamera.y, 0.0f), s * toCamera.x + c * toCamera.z);
+
+	// Hémi-octaèdre : direction -> case de l'atlas la plus proche
+	vec2 p = direction.xz / (abs(direction.x) + abs(direction.y) + abs(direction.z));
+	vec2 uv = vec2(p.x + p.y, p.x - p.y) * 0.5f + 0.5f;
+	vec2 frame = clamp(floor(uv * float(frames)), 0.0f, float(frames - 1));
+	TexCoord = vec3((frame + corner * 0.5f + 0.5f) / float(frames), instanceParams.z);
+
+	Rotation = instanceParams.xy;
+	LodFade = instanceParams.w;
+	gl_Position = projection * view * vec4(FragPos, 1.0f);
+}
@@ -0,0 +1,20 @@
+#version 330 core
+
+struct Material 
+{
+    sampler2D diffuseMap;
+};
+
+in vec3 Normal;
+in vec2 TexCoord;
+
+uniform Material material;
+
+layout (location = 0) out vec4 outAlbedo; // Alpha : couverture
+layout (location = 1) out vec4 outNormal; // Normale locale ramenée dans [0, 1]
+
+void main()
+{
+	outAlbedo = vec4(vec3(texture(material.diffuseMap, TexCoord)), 1.0f);
+	outNormal = vec4(normalize(Normal) * 0.5f + 0.5f, 1.0f);
+}
@@ -0,0 +1,17 @@
+#version 330 core
+
+layout (location = 0) in vec3 pos;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 texCoord;
+
+uniform mat4 viewProjection; // Caméra orthographique de l'image de l'atlas (espace du modèle)
+
+out vec3 Normal;
+out vec2 TexCoord;
+
+void main()
+{
+	Normal = normal;
+	TexCoord = texCoord;
+	gl_Position = viewProjection * vec4(pos, 1.0f);
+}
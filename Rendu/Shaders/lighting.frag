@@ -26,6 +26,7 @@ struct PointLight
 	float constant;
 	float linear;
 	float exponent;
+	float radius; // Rayon d'influence
 };
 
 struct SpotLight
@@ -48,20 +49,55 @@ struct SpotLight
 in vec2 TexCoord;
 in vec3 FragPos;
 in vec3 Normal;
+in vec4 Baked; // R : soleil, G : lampes / 2, A : occlusion ambiante
+flat in uint LightMask; // Lumières ponctuelles qui touchent l'objet (bit i : pointLights[i])
+flat in int BakeOffset; // Objet précalculé si >= 0 : ombres et lampes statiques lues dans Baked
+flat in float LodFade; // Fondu vers l'imposteur (0 : maillage seul)
 
 #define POINT_LIGHTS 3
+#define SHADOW_CASCADES 3
 
 uniform DirectionalLight sunLight;
 uniform PointLight pointLights[POINT_LIGHTS];
 uniform SpotLight spotLight;
 uniform Material material;
 uniform vec3 viewPos;
+uniform mat4 view;
+uniform sampler2DArrayShadow shadowMap; // Cascades d'ombre du soleil
+uniform mat4 lightSpaceMatrices[SHADOW_CASCADES];
+uniform vec3 cascadeSplits; // Distance de fin de chaque cascade
 
 out vec4 frag_color;
 
 
+// Facteur d'ombre du soleil (1 : éclairé, 0 : dans l'ombre)
+float calcShadow(vec3 fragPos, vec3 normal)
+{
+	// Choix de la cascade selon la profondeur dans l'espace vue
+	float viewDepth = -(view * vec4(fragPos, 1.0f)).z;
+	if (viewDepth > cascadeSplits.z)
+	{
+		return 1.0f; // Au-delà de la distance des ombres
+	}
+	int cascade = (viewDepth > cascadeSplits.x) ? ((viewDepth > cascadeSplits.y) ? 2 : 1) : 0;
+
+	// Position dans la cascade, décalée le long de la normale contre l'acné
+	vec4 lightPos = lightSpaceMatrices[cascade] * vec4(fragPos + normal * 0.05f * float(cascade + 1), 1.0f);
+	vec3 projPos = lightPos.xyz / lightPos.w * 0.5f + 0.5f;
+
+	// PCF : 4 comparaisons filtrées par le matériel
+	vec2 texelSize = 1.0f / vec2(textureSize(shadowMap, 0).xy);
+	float shadow = 0.0f;
+	shadow = shadow + texture(shadowMap, vec4(projPos.xy + vec2(-0.5f, -0.5f) * texelSize, float(cascade), projPos.z));
+	shadow = shadow + texture(shadowMap, vec4(projPos.xy + vec2( 0.5f, -0.5f) * texelSize, float(cascade), projPos.z));
+	shadow = shadow + texture(shadowMap, vec4(projPos.xy + vec2(-0.5f,  0.5f) * texelSize, float(cascade), projPos.z));
+	shadow = shadow + texture(shadowMap, vec4(projPos.xy + vec2( 0.5f,  0.5f) * texelSize, float(cascade), projPos.z));
+	return shadow * 0.25f;
+}
+
+
 // Calculer l'effet de la lumière directionnelle
-vec3 calcDirectionalLightColor(DirectionalLight light, vec3 normal, vec3 viewDir)
+vec3 calcDirectionalLightColor(DirectionalLight light, vec3 normal, vec3 viewDir, float shadow)
 {
 	vec3 lightDir = normalize(-light.direction);
 
@@ -74,7 +110,7 @@ vec3 calcDirectionalLightColor(DirectionalLight light, vec3 normal, vec3 viewDir
 	float NDotH = max(dot(normal, halfDir), 0.0f);
 	vec3 specular = light.specular * material.specular * pow(NDotH, material.shininess);
 
-	return (diffuse + specular);
+	return (diffuse + specular) * shadow;
 }
 
 
@@ -92,9 +128,10 @@ vec3 calcPointLightColor(PointLight light, vec3 normal, vec3 fragPos, vec3 viewD
 	float NDotH = max(dot(normal, halfDir), 0.0f);
 	vec3 specular = light.specular * material.specular * pow(NDotH, material.shininess);
 
-	// Atténuation
+	// Atténuation (nulle au-delà du rayon d'influence)
 	float d = length(light.position - FragPos);
 	float attenuation = 1.0f / (light.constant + light.linear * d + light.exponent * (d * d));
+	attenuation = attenuation * step(d, light.radius);
 
 	diffuse = diffuse * attenuation;
 	specular = specular * attenuation;
@@ -132,8 +169,22 @@ vec3 calcSpotLightColor(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir
 }
 
 
+// Seuil de tramage ordonné 4x4 du pixel (fondu entre maillage et imposteur)
+float ditherThreshold()
+{
+	const float bayer[16] = float[16](0.0f, 8.0f, 2.0f, 10.0f, 12.0f, 4.0f, 14.0f, 6.0f, 3.0f, 11.0f, 1.0f, 9.0f, 15.0f, 7.0f, 13.0f, 5.0f);
+	ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+	return (bayer[p.y * 4 + p.x] + 0.5f) / 16.0f;
+}
+
+
 void main()
 { 
+	if (ditherThreshold() < LodFade)
+	{
+		discard; // Pixel dessiné par l'imposteur
+	}
+
 	vec3 normal = normalize(Normal);  
 	vec3 viewDir = normalize(viewPos - FragPos);
 
@@ -141,13 +192,29 @@ void main()
 	vec3 ambient = spotLight.ambient * material.ambient * vec3(texture(material.diffuseMap, TexCoord));
 	vec3 outColor = vec3(0.0f);	
 
-	// Ajouter la couleur de la lumière du soleil
-	outColor = outColor + calcDirectionalLightColor(sunLight, normal, viewDir);
+	// Ajouter la couleur de la lumière du soleil, ombre précalculée ou lue dans les cascades
+	float shadow;
+	if (BakeOffset >= 0)
+	{
+		ambient = ambient * Baked.a;
+		shadow = Baked.r;
+
+		// Lampes statiques précalculées (diffus seulement), retirées de lightIndices
+		outColor = outColor + Baked.g * 2.0f * vec3(texture(material.diffuseMap, TexCoord));
+	}
+	else
+	{
+		shadow = calcShadow(FragPos, normal);
+	}
+	outColor = outColor + calcDirectionalLightColor(sunLight, normal, viewDir, shadow);
 
-	// Appliquer chaque lumière ponctuelle
+	// Appliquer les lumières ponctuelles qui touchent l'objet
 	for(int i = 0; i < POINT_LIGHTS; i++)
 	{
-		outColor = outColor + calcPointLightColor(pointLights[i], normal, FragPos, viewDir);
+		if ((LightMask & (1u << i)) != 0u)
+		{
+			outColor = outColor + calcPointLightColor(pointLights[i], normal, FragPos, viewDir);
+		}
 	}
 
 	// Appliquer la lumière de la lampe torche si elle est activée
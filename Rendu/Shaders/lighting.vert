@@ -3,21 +3,39 @@
 layout (location = 0) in vec3 pos;			
 layout (location = 1) in vec3 normal;	
 layout (location = 2) in vec2 texCoord;
+layout (location = 3) in mat4 instanceModel; // Matrice de modèle de l'instance
+layout (location = 7) in mat3 instanceNormalMatrix; // Matrice des normales précalculée
+layout (location = 10) in uint instanceLightMask; // Lumières ponctuelles qui touchent l'instance
+layout (location = 11) in int instanceBakeOffset; // Premier texel précalculé (-1 : pas de précalcul)
+layout (location = 12) in float instanceLodFade; // Fondu vers l'imposteur (0 : maillage seul)
 
-uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
+uniform samplerBuffer bakedLighting; // Éclairage précalculé, un texel par sommet
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
+out vec4 Baked; // R : soleil, G : lampes / 2, A : occlusion ambiante
+flat out uint LightMask;
+flat out int BakeOffset;
+flat out float LodFade;
 
 void main()
 {
-    FragPos = vec3(model * vec4(pos, 1.0f));
-    Normal = mat3(transpose(inverse(model))) * normal;
+    FragPos = vec3(instanceModel * vec4(pos, 1.0f));
+    Normal = instanceNormalMatrix * normal;
+    LightMask = instanceLightMask;
+    BakeOffset = instanceBakeOffset;
+    LodFade = instanceLodFade;
 
 	TexCoord = texCoord;
 
-	gl_Position = projection * view *  model * vec4(pos, 1.0f);
+	Baked = vec4(1.0f);
+	if (instanceBakeOffset >= 0)
+	{
+		Baked = texelFetch(bakedLighting, instanceBakeOffset + gl_VertexID);
+	}
+
+	gl_Position = projection * view * vec4(FragPos, 1.0f);
 }
@@ -0,0 +1,42 @@
+#version 330 core
+
+// Ombrage par sommet (Gouraud) : l'éclairage est interpolé, seule la texture est lue par pixel
+
+struct Material
+{
+    vec3 ambient;
+    sampler2D diffuseMap;
+    vec3 specular;
+    float shininess;
+};
+
+in vec2 TexCoord;
+in vec3 Ambient;
+in vec3 Diffuse;
+in vec3 Specular;
+flat in float LodFade; // Fondu vers l'imposteur (0 : maillage seul)
+
+uniform Material material;
+
+out vec4 frag_color;
+
+
+// Seuil de tramage ordonné 4x4 du pixel (fondu entre maillage et imposteur)
+float ditherThreshold()
+{
+	const float bayer[16] = float[16](0.0f, 8.0f, 2.0f, 10.0f, 12.0f, 4.0f, 14.0f, 6.0f, 3.0f, 11.0f, 1.0f, 9.0f, 15.0f, 7.0f, 13.0f, 5.0f);
+	ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+	return (bayer[p.y * 4 + p.x] + 0.5f) / 16.0f;
+}
+
+
+void main()
+{
+	if (ditherThreshold() < LodFade)
+	{
+		discard; // Pixel dessiné par l'imposteur
+	}
+
+	vec3 albedo = vec3(texture(material.diffuseMap, TexCoord));
+	frag_color = vec4((Ambient + Diffuse) * albedo + Specular, 1.0f);
+}
@@ -0,0 +1,160 @@
+#version 330 core
+
+// Ombrage par sommet (Gouraud) : niveau d'ombrage des objets à moyenne distance
+
+struct Material
+{
+    vec3 ambient;
+    sampler2D diffuseMap;
+    vec3 specular;
+    float shininess;
+};
+
+struct DirectionalLight
+{
+	vec3 direction;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+};
+
+struct PointLight
+{
+	vec3 position;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+
+	float constant;
+	float linear;
+	float exponent;
+	float radius; // Rayon d'influence
+};
+
+struct SpotLight
+{
+	vec3 position;
+	vec3 direction;
+	float cosInnerCone;
+	float cosOuterCone;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	bool on;
+
+	float constant;
+	float linear;
+	float exponent;
+};
+
+layout (location = 0) in vec3 pos;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 texCoord;
+layout (location = 3) in mat4 instanceModel; // Matrice de modèle de l'instance
+layout (location = 7) in mat3 instanceNormalMatrix; // Matrice des normales précalculée
+layout (location = 10) in uint instanceLightMask; // Lumières ponctuelles qui touchent l'instance
+layout (location = 11) in int instanceBakeOffset; // Premier texel précalculé (-1 : pas de précalcul)
+layout (location = 12) in float instanceLodFade; // Fondu vers l'imposteur (0 : maillage seul)
+
+#define POINT_LIGHTS 3
+#define SHADOW_CASCADES 3
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform DirectionalLight sunLight;
+uniform PointLight pointLights[POINT_LIGHTS];
+uniform SpotLight spotLight;
+uniform Material material;
+uniform vec3 viewPos;
+uniform sampler2DArrayShadow shadowMap; // Cascades d'ombre du soleil
+uniform mat4 lightSpaceMatrices[SHADOW_CASCADES];
+uniform vec3 cascadeSplits; // Distance de fin de chaque cascade
+uniform samplerBuffer bakedLighting; // Éclairage précalculé, un texel par sommet
+
+out vec2 TexCoord;
+out vec3 Ambient; // Lumière ambiante
+out vec3 Diffuse; // Lumière diffuse, multipliée par la texture dans le fragment shader
+out vec3 Specular; // Lumière spéculaire
+flat out float LodFade;
+
+
+// Facteur d'ombre du soleil au sommet, une seule comparaison filtrée
+float calcShadow(vec3 worldPos, vec3 n)
+{
+	float viewDepth = -(view * vec4(worldPos, 1.0f)).z;
+	if (viewDepth > cascadeSplits.z)
+	{
+		return 1.0f; // Au-delà de la distance des ombres
+	}
+	int cascade = (viewDepth > cascadeSplits.x) ? ((viewDepth > cascadeSplits.y) ? 2 : 1) : 0;
+
+	vec4 lightPos = lightSpaceMatrices[cascade] * vec4(worldPos + n * 0.05f * float(cascade + 1), 1.0f);
+	vec3 projPos = lightPos.xyz / lightPos.w * 0.5f + 0.5f;
+	return texture(shadowMap, vec4(projPos.xy, float(cascade), projPos.z));
+}
+
+
+// Ajouter la contribution d'une lumière (Blinn-Phong)
+void addLight(vec3 lightDir, vec3 diffuseColor, vec3 specularColor, float factor, vec3 n, vec3 viewDir)
+{
+	float NdotL = max(dot(n, lightDir), 0.0f);
+	float NDotH = max(dot(n, normalize(lightDir + viewDir)), 0.0f);
+
+	Diffuse = Diffuse + diffuseColor * NdotL * factor;
+	Specular = Specular + specularColor * material.specular * pow(NDotH, material.shininess) * factor;
+}
+
+
+void main()
+{
+	vec3 worldPos = vec3(instanceModel * vec4(pos, 1.0f));
+	vec3 n = normalize(instanceNormalMatrix * normal);
+	vec3 viewDir = normalize(viewPos - worldPos);
+
+	TexCoord = texCoord;
+	LodFade = instanceLodFade;
+	Diffuse = vec3(0.0f);
+	Specular = vec3(0.0f);
+	Ambient = spotLight.ambient * material.ambient;
+
+	// Soleil, ombre précalculée ou lue dans les cascades
+	float shadow;
+	if (instanceBakeOffset >= 0)
+	{
+		vec4 baked = texelFetch(bakedLighting, instanceBakeOffset + gl_VertexID);
+		Ambient = Ambient * baked.a;
+		shadow = baked.r;
+		Diffuse = Diffuse + vec3(baked.g * 2.0f); // Lampes statiques précalculées
+	}
+	else
+	{
+		shadow = calcShadow(worldPos, n);
+	}
+	addLight(normalize(-sunLight.direction), sunLight.diffuse, sunLight.specular, shadow, n, viewDir);
+
+	// Lumières ponctuelles qui touchent l'objet
+	for (int i = 0; i < POINT_LIGHTS; i++)
+	{
+		if ((instanceLightMask & (1u << i)) == 0u)
+		{
+			continue;
+		}
+
+		PointLight light = pointLights[i];
+		float d = length(light.position - worldPos);
+		float attenuation = step(d, light.radius) / (light.constant + light.linear * d + light.exponent * (d * d));
+		addLight(normalize(light.position - worldPos), light.diffuse, light.specular, attenuation, n, viewDir);
+	}
+
+	// Lampe torche
+	if (spotLight.on)
+	{
+		vec3 lightDir = normalize(spotLight.position - worldPos);
+		float spotIntensity = smoothstep(spotLight.cosOuterCone, spotLight.cosInnerCone, dot(-lightDir, normalize(spotLight.direction)));
+		float d = length(spotLight.position - worldPos);
+		float attenuation = 1.0f / (spotLight.constant + spotLight.linear * d + spotLight.exponent * (d * d));
+		addLight(lightDir, spotLight.diffuse, spotLight.specular, attenuation * spotIntensity, n, viewDir);
+	}
+
+	gl_Position = projection * view * vec4(worldPos, 1.0f);
+}
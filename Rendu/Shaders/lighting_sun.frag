@@ -0,0 +1,116 @@
+#version 330 core
+
+// Soleil et ambiant seulement : niveau d'ombrage des objets lointains (avec lighting.vert)
+
+struct Material
+{
+    vec3 ambient;
+    sampler2D diffuseMap;
+    vec3 specular;
+    float shininess;
+};
+
+struct DirectionalLight
+{
+	vec3 direction;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+};
+
+struct SpotLight
+{
+	vec3 position;
+	vec3 direction;
+	float cosInnerCone;
+	float cosOuterCone;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	bool on;
+
+	float constant;
+	float linear;
+	float exponent;
+};
+
+
+in vec2 TexCoord;
+in vec3 FragPos;
+in vec3 Normal;
+in vec4 Baked; // R : soleil, G : lampes / 2, A : occlusion ambiante
+flat in int BakeOffset; // Objet précalculé si >= 0
+flat in float LodFade; // Fondu vers l'imposteur (0 : maillage seul)
+
+#define SHADOW_CASCADES 3
+
+uniform DirectionalLight sunLight;
+uniform SpotLight spotLight; // Seule la composante ambiante est utilisée
+uniform Material material;
+uniform vec3 viewPos;
+uniform mat4 view;
+uniform sampler2DArrayShadow shadowMap; // Cascades d'ombre du soleil
+uniform mat4 lightSpaceMatrices[SHADOW_CASCADES];
+uniform vec3 cascadeSplits; // Distance de fin de chaque cascade
+
+out vec4 frag_color;
+
+
+// Facteur d'ombre du soleil, une seule comparaison filtrée
+float calcShadow(vec3 fragPos, vec3 normal)
+{
+	float viewDepth = -(view * vec4(fragPos, 1.0f)).z;
+	if (viewDepth > cascadeSplits.z)
+	{
+		return 1.0f; // Au-delà de la distance des ombres
+	}
+	int cascade = (viewDepth > cascadeSplits.x) ? ((viewDepth > cascadeSplits.y) ? 2 : 1) : 0;
+
+	vec4 lightPos = lightSpaceMatrices[cascade] * vec4(fragPos + normal * 0.05f * float(cascade + 1), 1.0f);
+	vec3 projPos = lightPos.xyz / lightPos.w * 0.5f + 0.5f;
+	return texture(shadowMap, vec4(projPos.xy, float(cascade), projPos.z));
+}
+
+
+// Seuil de tramage ordonné 4x4 du pixel (fondu entre maillage et imposteur)
+float ditherThreshold()
+{
+	const float bayer[16] = float[16](0.0f, 8.0f, 2.0f, 10.0f, 12.0f, 4.0f, 14.0f, 6.0f, 3.0f, 11.0f, 1.0f, 9.0f, 15.0f, 7.0f, 13.0f, 5.0f);
+	ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+	return (bayer[p.y * 4 + p.x] + 0.5f) / 16.0f;
+}
+
+
+void main()
+{
+	if (ditherThreshold() < LodFade)
+	{
+		discard; // Pixel dessiné par l'imposteur
+	}
+
+	vec3 normal = normalize(Normal);
+	vec3 viewDir = normalize(viewPos - FragPos);
+	vec3 albedo = vec3(texture(material.diffuseMap, TexCoord));
+
+    // Ambiant
+	vec3 ambient = spotLight.ambient * material.ambient * albedo;
+
+	float shadow;
+	if (BakeOffset >= 0)
+	{
+		ambient = ambient * Baked.a;
+		shadow = Baked.r;
+	}
+	else
+	{
+		shadow = calcShadow(FragPos, normal);
+	}
+
+	// Soleil (Blinn-Phong)
+	vec3 lightDir = normalize(-sunLight.direction);
+	float NdotL = max(dot(normal, lightDir), 0.0f);
+	float NDotH = max(dot(normal, normalize(lightDir + viewDir)), 0.0f);
+	vec3 sun = sunLight.diffuse * NdotL * albedo + sunLight.specular * material.specular * pow(NDotH, material.shininess);
+
+	frag_color = vec4(ambient + sun * shadow, 1.0f);
+}
@@ -0,0 +1,6 @@
+#version 330 core
+
+// Requête d'occlusion : aucune couleur écrite
+void main()
+{
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+uniform mat4 viewProjection;
+uniform vec3 boxMin;
+uniform vec3 boxMax;
+
+// Boîte en bande de 14 sommets générée à partir de gl_VertexID (aucun VBO)
+void main()
+{
+	int bit = 1 << gl_VertexID;
+	vec3 corner = vec3((0x287a & bit) != 0, (0x02af & bit) != 0, (0x31e3 & bit) != 0);
+	gl_Position = viewProjection * vec4(mix(boxMin, boxMax, corner), 1.0f);
+}
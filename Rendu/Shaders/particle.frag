@@ -0,0 +1,18 @@
+#version 330 core
+
+// Particules : disque aux bords adoucis, couleur prémultipliée (mélange GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+
+in vec2 Corner;
+in vec4 Color;
+
+out vec4 frag_color;
+
+void main()
+{
+	float falloff = 1.0f - dot(Corner, Corner);
+	if (falloff <= 0.0f)
+	{
+		discard;
+	}
+	frag_color = Color * falloff * falloff;
+}
@@ -0,0 +1,21 @@
+#version 330 core
+
+// Particules : quads face à la caméra construits dans l'espace de vue (avec particle.frag)
+
+layout (location = 0) in vec4 instancePosition; // Centre de la particule, taille
+layout (location = 1) in vec4 instanceColor; // Couleur prémultipliée (alpha 0 : additive)
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 Corner; // Coin du quad dans [-1, 1]
+out vec4 Color;
+
+void main()
+{
+	// Quad en bande de 4 sommets, coins générés à partir de gl_VertexID
+	Corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0f - 1.0f;
+	vec4 center = view * vec4(instancePosition.xyz, 1.0f);
+	Color = instanceColor;
+	gl_Position = projection * vec4(center.xy + Corner * 0.5f * instancePosition.w, center.zw);
+}
@@ -0,0 +1,6 @@
+#version 330 core
+
+// Profondeur seulement : aucune couleur écrite
+void main()
+{
+}
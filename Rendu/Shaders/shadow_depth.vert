@@ -0,0 +1,11 @@
+#version 330 core
+
+layout (location = 0) in vec3 pos;
+
+uniform mat4 model;
+uniform mat4 lightSpace; // Projection * vue de la cascade
+
+void main()
+{
+	gl_Position = lightSpace * model * vec4(pos, 1.0f);
+}
@@ -0,0 +1,59 @@
+#version 330 core
+
+// Terrain CDLOD : grille d'un noeud posée sur la carte de hauteur (avec lighting.frag ou gbuffer.frag)
+
+layout (location = 0) in vec2 gridPos; // Sommet de la grille (coordonnées entières)
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 viewPos;
+uniform sampler2D heightMap; // Fenêtre torique des échantillons autour de la caméra
+uniform float heightMapSize; // Texels par côté
+uniform float sampleSpacing; // Distance entre deux échantillons
+uniform vec2 nodeOffset; // Coin minimum du noeud
+uniform float nodeSpacing; // Côté d'un quad de la grille du noeud
+uniform vec2 morphRange; // Début de la transition vers la grille grossière, inverse de sa longueur
+uniform float textureScale; // Répétitions de la texture par unité
+uniform int lightMask; // Lumières ponctuelles qui touchent le terrain
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out vec4 Baked; // R : soleil, G : lampes / 2, A : occlusion ambiante
+flat out uint LightMask;
+flat out int BakeOffset;
+flat out float LodFade;
+
+
+// Hauteur en (x, z) : filtrage bilinéaire des échantillons (comme Heightfield::getHeight)
+float heightAt(vec2 position)
+{
+	vec2 uv = (position / sampleSpacing + 0.5f) / heightMapSize;
+	return textureLod(heightMap, uv, 0.0f).r;
+}
+
+
+void main()
+{
+	// Distance au sommet de la grille du noeud, puis glissement des sommets impairs vers la grille deux fois plus grossière
+	vec2 position = nodeOffset + gridPos * nodeSpacing;
+	float distance = length(viewPos - vec3(position.x, heightAt(position), position.y));
+	float morph = clamp((distance - morphRange.x) * morphRange.y, 0.0f, 1.0f);
+	position = position - fract(gridPos * 0.5f) * 2.0f * nodeSpacing * morph;
+
+	// Normale par différences centrées au pas de la grille
+	float left = heightAt(position - vec2(nodeSpacing, 0.0f));
+	float right = heightAt(position + vec2(nodeSpacing, 0.0f));
+	float down = heightAt(position - vec2(0.0f, nodeSpacing));
+	float up = heightAt(position + vec2(0.0f, nodeSpacing));
+	Normal = normalize(vec3(left - right, 2.0f * nodeSpacing, down - up));
+
+	FragPos = vec3(position.x, heightAt(position), position.y);
+	TexCoord = position * textureScale;
+	Baked = vec4(1.0f);
+	LightMask = uint(lightMask);
+	BakeOffset = -1;
+	LodFade = 0.0f;
+
+	gl_Position = projection * view * vec4(FragPos, 1.0f);
+}
@@ -0,0 +1,69 @@
+#include "ShadingLod.hpp"
+#include "Simd.hpp"
+
+
+// Distances de changement de niveau
+void ShadingLod::setDistances(float gouraudDistance, float sunOnlyDistance, float hysteresis)
+{
+    mThresholds[0] = gouraudDistance;
+    mThresholds[1] = sunOnlyDistance;
+    mHysteresis = hysteresis;
+}
+
+// Choisir le niveau de chaque objet selon la distance entre la caméra et sa boîte englobante
+void ShadingLod::update(const AABBArray& bounds, glm::vec3 viewPos)
+{
+    // Un nouvel objet commence au niveau le plus détaillé
+    mLevels.resize(bounds.size(), FULL);
+    mDistances.resize(bounds.paddedSize());
+
+    // Distance au carré caméra / boîte, 4 boîtes à la fois
+    float4 cx(viewPos.x), cy(viewPos.y), cz(viewPos.z);
+    float4 zero = float4::zero();
+    for(size_t i = 0; i < bounds.paddedSize(); i = i + 4)
+    {
+        float4 dx = max4(max4(float4::load(&bounds.minX[i]) - cx, cx - float4::load(&bounds.maxX[i])), zero);
+        float4 dy = max4(max4(float4::load(&bounds.minY[i]) - cy, cy - float4::load(&bounds.maxY[i])), zero);
+        float4 dz = max4(max4(float4::load(&bounds.minZ[i]) - cz, cz - float4::load(&bounds.maxZ[i])), zero);
+        (dx * dx + dy * dy + dz * dz).store(&mDistances[i]);
+    }
+
+    // Hystérésis : on ne passe au niveau suivant qu'au-delà de la distance + marge,
+    // et on ne revient au précédent qu'en deçà de la distance - marge
+    for(size_t i = 0; i < bounds.size(); i = i + 1)
+    {
+        int level = mLevels[i];
+        float d2 = mDistances[i];
+
+        while(level < LEVEL_COUNT - 1)
+        {
+            float limit = mThresholds[level] + mHysteresis;
+            if(d2 <= limit * limit)
+            {
+                break;
+            }
+            level = level + 1;
+        }
+
+        while(level > FULL)
+        {
+            float limit = glm::max(0.0f, mThresholds[level - 1] - mHysteresis);
+            if(d2 >= limit * limit)
+            {
+                break;
+            }
+            level = level - 1;
+        }
+
+        mLevels[i] = (uint8_t)level;
+    }
+}
+
+// Remettre à zéro les compteurs de l'image
+void ShadingLod::resetCounts()
+{
+    for(int i = 0; i < LEVEL_COUNT; i = i + 1)
+    {
+        mDrawCounts[i] = 0;
+    }
+}
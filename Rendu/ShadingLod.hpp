@@ -0,0 +1,42 @@
+#ifndef SHADING_LOD_HPP
+#define SHADING_LOD_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "Bounds.hpp"
+
+// Niveaux de détail de l'ombrage : les objets lointains passent à un éclairage par sommet,
+// puis au soleil et à l'ambiant seulement. Une marge (hystérésis) autour de chaque distance
+// évite les changements de niveau répétés d'un objet à la limite.
+class ShadingLod
+{
+public:
+    enum Level
+    {
+        FULL = 0, // Blinn-Phong par pixel, toutes les lumières
+        GOURAUD = 1, // Éclairage par sommet
+        SUN_ONLY = 2, // Soleil et ambiant seulement
+        LEVEL_COUNT = 3
+    };
+
+    void setDistances(float gouraudDistance, float sunOnlyDistance, float hysteresis); // Distances de changement de niveau
+    void update(const AABBArray& bounds, glm::vec3 viewPos); // Choisir le niveau de chaque objet
+
+    int getLevel(size_t index) const { return mLevels[index]; } // Niveau d'un objet
+    float getDistance(size_t index) const { return std::sqrt(mDistances[index]); } // Distance entre la caméra et la boîte d'un objet
+    void resetCounts(); // Remettre à zéro les compteurs de l'image
+    void countDraw(int level, int count) { mDrawCounts[level] = mDrawCounts[level] + count; } // Compter des objets dessinés
+    int getDrawCount(int level) const { return mDrawCounts[level]; } // Objets dessinés dans l'image à un niveau
+
+private:
+    std::vector<uint8_t> mLevels; // Niveau de chaque objet
+    std::vector<float> mDistances; // Distance au carré entre la caméra et chaque boîte
+    float mThresholds[LEVEL_COUNT - 1] = { 40.0f, 90.0f }; // Distance de début des niveaux GOURAUD et SUN_ONLY
+    float mHysteresis = 5.0f; // Marge de part et d'autre de chaque distance
+    int mDrawCounts[LEVEL_COUNT] = { 0, 0, 0 }; // Objets dessinés par niveau
+};
+
+#endif // SHADING_LOD_HPP
@@ -0,0 +1,199 @@
+#include "ShadowMaps.hpp"
+#include <iostream>
+#include <string>
+#include <glm/gtc/matrix_transform.hpp>
+
+
+ShadowMaps::ShadowMaps() : mFBO(0), mDepthArray(0), mResolution(0), mLightView(1.0f), mSunDirection(0.0f)
+{
+}
+
+ShadowMaps::~ShadowMaps()
+{
+    glDeleteFramebuffers(1, &mFBO);
+    glDeleteTextures(1, &mDepthArray);
+}
+
+// Création du tableau de textures de profondeur (une couche par cascade)
+bool ShadowMaps::init(int resolution)
+{
+    mResolution = resolution;
+
+    glGenTextures(1, &mDepthArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mDepthArray);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, mResolution, mResolution, CASCADE_COUNT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR); // Filtrage matériel des comparaisons (PCF 2x2)
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    float border[4] = { 1.0f, 1.0f, 1.0f, 1.0f }; // Hors de la cascade : pas d'ombre
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    glGenFramebuffers(1, &mFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, mDepthArray, 0, 0);
+    glDrawBuffer(GL_NONE); // Profondeur seulement
+    glReadBuffer(GL_NONE);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if(status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "Erreur : framebuffer des ombres incomplet (" << status << ")" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// La géométrie statique a changé : vider le cache
+void ShadowMaps::invalidate()
+{
+    for(int i = 0; i < CASCADE_COUNT; i = i + 1)
+    {
+        mCascades[i].valid = false;
+    }
+}
+
+// Choisir les cascades à redessiner pour cette image
+void ShadowMaps::update(const glm::mat4& view, float fov, float aspect, float nearPlane, const glm::vec3& sunDirection)
+{
+    // Le soleil a tourné au-delà du seuil : nouvelle orientation et cache vidé
+    if(glm::dot(sunDirection, mSunDirection) < SUN_CACHE_THRESHOLD)
+    {
+        mSunDirection = sunDirection;
+        glm::vec3 up = (glm::abs(sunDirection.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        mLightView = glm::lookAt(glm::vec3(0.0f), sunDirection, up);
+        invalidate();
+    }
+
+    float splitNear = nearPlane;
+    for(int i = 0; i < CASCADE_COUNT; i = i + 1)
+    {
+        // Découpage "pratique" : mélange logarithmique / linéaire
+        float t = (float)(i + 1) / (float)CASCADE_COUNT;
+        float logSplit = nearPlane * powf(SHADOW_DISTANCE / nearPlane, t);
+        float linearSplit = nearPlane + (SHADOW_DISTANCE - nearPlane) * t;
+        float splitFar = SPLIT_LAMBDA * logSplit + (1.0f - SPLIT_LAMBDA) * linearSplit;
+
+        glm::vec3 center;
+        float radius;
+        computeSliceSphere(view, fov, aspect, splitNear, splitFar, center, radius);
+
+        Cascade& cascade = mCascades[i];
+        cascade.splitFar = splitFar;
+
+        // Cascade en cache : on la garde tant que la tranche courante reste dans la zone couverte
+        if(i >= FIRST_CACHED_CASCADE && cascade.valid && glm::distance(center, cascade.center) + radius <= cascade.radius)
+        {
+            cascade.render = false;
+        }
+        else
+        {
+            fitCascade(cascade, center, (i >= FIRST_CACHED_CASCADE) ? radius * CACHE_MARGIN : radius);
+            cascade.render = true;
+        }
+
+        splitNear = splitFar;
+    }
+}
+
+// Sphère englobant une tranche du frustum de la caméra
+void ShadowMaps::computeSliceSphere(const glm::mat4& view, float fov, float aspect, float nearZ, float farZ, glm::vec3& center, float& radius) const
+{
+    glm::mat4 invViewProj = glm::inverse(glm::perspective(glm::radians(fov), aspect, nearZ, farZ) * view);
+    glm::vec3 corners[8];
+
+    center = glm::vec3(0.0f);
+    for(int i = 0; i < 8; i = i + 1)
+    {
+        glm::vec4 corner = invViewProj * glm::vec4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+        corners[i] = glm::vec3(corner) / corner.w;
+        center = center + corners[i];
+    }
+    center = center / 8.0f;
+
+    radius = 0.0f;
+    for(int i = 0; i < 8; i = i + 1)
+    {
+        radius = glm::max(radius, glm::length(corners[i] - center));
+    }
+}
+
+// Construire la projection orthographique de la cascade.
+// Le rayon est arrondi et le centre aligné sur les texels pour éviter le scintillement des ombres.
+void ShadowMaps::fitCascade(Cascade& cascade, const glm::vec3& center, float radius)
+{
+    radius = ceilf(radius);
+    float texelSize = 2.0f * radius / (float)mResolution;
+
+    glm::vec3 lightCenter = glm::vec3(mLightView * glm::vec4(center, 1.0f));
+    glm::vec2 snapped = glm::floor(glm::vec2(lightCenter.x, lightCenter.y) / texelSize) * texelSize;
+
+    cascade.center = center;
+    cascade.radius = radius;
+    cascade.snappedCenter = snapped;
+    cascade.nearZ = -lightCenter.z - radius - CASTER_EXTENT;
+    cascade.farZ = -lightCenter.z + radius;
+
+    glm::mat4 projection = glm::ortho(snapped.x - radius, snapped.x + radius, snapped.y - radius, snapped.y + radius, cascade.nearZ, cascade.farZ);
+    cascade.lightSpace = projection * mLightView;
+    cascade.valid = false;
+}
+
+// Lier la cascade en écriture
+void ShadowMaps::beginCascade(int cascade)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, mDepthArray, 0, cascade);
+    glViewport(0, 0, mResolution, mResolution);
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    // Décalage de profondeur contre l'acné des ombres
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.0f, 4.0f);
+}
+
+// Fin du rendu de la cascade : son contenu peut être réutilisé
+void ShadowMaps::endCascade(int cascade)
+{
+    mCascades[cascade].valid = true;
+}
+
+// Retour au framebuffer par défaut
+void ShadowMaps::endPass(int width, int height)
+{
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+}
+
+// La boîte projette-t-elle une ombre dans la cascade ?
+// La zone est étendue vers le soleil (nearZ) pour garder les objets hors de la tranche.
+bool ShadowMaps::intersectsCascade(const AABB& box, int cascade) const
+{
+    const Cascade& c = mCascades[cascade];
+    AABB lightBox = transformAABB(box, mLightView);
+
+    return lightBox.max.x >= c.snappedCenter.x - c.radius && lightBox.min.x <= c.snappedCenter.x + c.radius
+        && lightBox.max.y >= c.snappedCenter.y - c.radius && lightBox.min.y <= c.snappedCenter.y + c.radius
+        && lightBox.max.z >= -c.farZ && lightBox.min.z <= -c.nearZ;
+}
+
+// Envoyer les matrices des cascades et lier la texture
+void ShadowMaps::applyUniforms(ShaderProgram& shader, GLuint unit)
+{
+    shader.setUniformSampler("shadowMap", unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mDepthArray);
+    glActiveTexture(GL_TEXTURE0);
+
+    for(int i = 0; i < CASCADE_COUNT; i = i + 1)
+    {
+        std::string name = "lightSpaceMatrices[" + std::to_string(i) + "]";
+        shader.setUniform(name.c_str(), mCascades[i].lightSpace);
+    }
+    shader.setUniform("cascadeSplits", glm::vec3(mCascades[0].splitFar, mCascades[1].splitFar, mCascades[2].splitFar));
+}
@@ -0,0 +1,68 @@
+#ifndef SHADOW_MAPS_HPP
+#define SHADOW_MAPS_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Bounds.hpp"
+
+#define GLEW_STATIC
+
+// Ombres du soleil par cascades (Cascaded Shadow Maps).
+// La cascade 0 (proche) est redessinée à chaque image. Les cascades lointaines couvrent une zone
+// plus large que nécessaire et restent en cache tant que la caméra reste dans cette zone, que la
+// direction du soleil ne change pas au-delà d'un seuil et que la géométrie statique ne change pas.
+class ShadowMaps
+{
+public:
+    static const int CASCADE_COUNT = 3; // Nombre de cascades
+    static const int FIRST_CACHED_CASCADE = 1; // Première cascade mise en cache
+
+    ShadowMaps();
+    ~ShadowMaps();
+
+    bool init(int resolution = 2048); // Création du tableau de textures de profondeur
+    void update(const glm::mat4& view, float fov, float aspect, float nearPlane, const glm::vec3& sunDirection); // Choisir les cascades à redessiner
+    void invalidate(); // La géométrie statique a changé : vider le cache
+
+    bool needsRender(int cascade) const { return mCascades[cascade].render; } // Cascade à redessiner cette image
+    void beginCascade(int cascade); // Lier la cascade en écriture
+    void endCascade(int cascade); // Fin du rendu de la cascade
+    void endPass(int width, int height); // Retour au framebuffer par défaut
+
+    const glm::mat4& getLightSpaceMatrix(int cascade) const { return mCascades[cascade].lightSpace; }
+    bool intersectsCascade(const AABB& box, int cascade) const; // La boîte projette-t-elle une ombre dans la cascade ?
+    void applyUniforms(ShaderProgram& shader, GLuint unit); // Envoyer les matrices et lier la texture
+
+private:
+    struct Cascade
+    {
+        glm::vec3 center = glm::vec3(0.0f); // Centre de la zone couverte
+        float radius = 0.0f; // Rayon de la zone couverte
+        float splitFar = 0.0f; // Distance de fin de la cascade (espace vue)
+        float nearZ = 0.0f, farZ = 0.0f; // Plans de la projection orthographique
+        glm::vec2 snappedCenter = glm::vec2(0.0f); // Centre aligné sur les texels (espace lumière)
+        glm::mat4 lightSpace = glm::mat4(1.0f); // Projection * vue de la lumière
+        bool valid = false; // Contenu du cache utilisable
+        bool render = false; // À redessiner cette image
+    };
+
+    void computeSliceSphere(const glm::mat4& view, float fov, float aspect, float nearZ, float farZ, glm::vec3& center, float& radius) const; // Sphère englobant une tranche du frustum
+    void fitCascade(Cascade& cascade, const glm::vec3& center, float radius); // Construire la projection de la cascade
+
+    Cascade mCascades[CASCADE_COUNT];
+    GLuint mFBO, mDepthArray; // Framebuffer et tableau de textures de profondeur
+    int mResolution; // Taille d'une cascade en texels
+
+    glm::mat4 mLightView; // Rotation de la lumière (origine fixe pour l'alignement sur les texels)
+    glm::vec3 mSunDirection; // Direction du soleil utilisée par le cache
+
+    const float SHADOW_DISTANCE = 120.0f; // Distance maximale des ombres
+    const float SPLIT_LAMBDA = 0.75f; // Mélange entre découpage logarithmique et linéaire
+    const float CACHE_MARGIN = 1.3f; // Marge des cascades en cache
+    const float CASTER_EXTENT = 100.0f; // Distance supplémentaire vers le soleil pour les objets qui projettent une ombre
+    const float SUN_CACHE_THRESHOLD = 0.9995f; // Cosinus de l'angle du soleil au-delà duquel le cache est vidé
+};
+
+#endif // SHADOW_MAPS_HPP
@@ -0,0 +1,98 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cmath>
+
+// Petite abstraction SIMD sur 4 flottants : SSE sur x86-64 (toujours disponible),
+// version scalaire sinon. Les comparaisons renvoient un masque (tous les bits à 1 ou à 0).
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+struct float4
+{
+#ifdef SIMD_SSE
+    __m128 v;
+
+    float4() {}
+    float4(__m128 x) : v(x) {}
+    explicit float4(float x) : v(_mm_set1_ps(x)) {}
+    float4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+
+    static float4 load(const float* p) { return _mm_loadu_ps(p); } // Lecture de 4 flottants
+    void store(float* p) const { _mm_storeu_ps(p, v); } // Écriture de 4 flottants
+    static float4 zero() { return _mm_setzero_ps(); }
+#else
+    float v[4];
+
+    float4() {}
+    explicit float4(float x) { v[0] = v[1] = v[2] = v[3] = x; }
+    float4(float a, float b, float c, float d) { v[0] = a; v[1] = b; v[2] = c; v[3] = d; }
+
+    static float4 load(const float* p) { return float4(p[0], p[1], p[2], p[3]); }
+    void store(float* p) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+    static float4 zero() { return float4(0.0f); }
+#endif
+};
+
+#ifdef SIMD_SSE
+
+inline float4 operator+(float4 a, float4 b) { return _mm_add_ps(a.v, b.v); }
+inline float4 operator-(float4 a, float4 b) { return _mm_sub_ps(a.v, b.v); }
+inline float4 operator*(float4 a, float4 b) { return _mm_mul_ps(a.v, b.v); }
+inline float4 operator/(float4 a, float4 b) { return _mm_div_ps(a.v, b.v); }
+inline float4 operator&(float4 a, float4 b) { return _mm_and_ps(a.v, b.v); }
+inline float4 operator|(float4 a, float4 b) { return _mm_or_ps(a.v, b.v); }
+inline float4 min4(float4 a, float4 b) { return _mm_min_ps(a.v, b.v); }
+inline float4 max4(float4 a, float4 b) { return _mm_max_ps(a.v, b.v); }
+inline float4 sqrt4(float4 a) { return _mm_sqrt_ps(a.v); }
+inline float4 abs4(float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+inline float4 cmplt(float4 a, float4 b) { return _mm_cmplt_ps(a.v, b.v); }
+inline float4 cmple(float4 a, float4 b) { return _mm_cmple_ps(a.v, b.v); }
+inline float4 cmpgt(float4 a, float4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline float4 cmpge(float4 a, float4 b) { return _mm_cmpge_ps(a.v, b.v); }
+inline float4 select(float4 mask, float4 a, float4 b) { return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); } // mask ? a : b
+inline int movemask(float4 mask) { return _mm_movemask_ps(mask.v); } // Bit i : voie i du masque
+inline void transpose4(float4& a, float4& b, float4& c, float4& d) { _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v); } // Lignes <-> colonnes (SoA <-> AoS)
+
+#else
+
+#define SIMD_LANES(expr) float4 r; for(int i = 0; i < 4; i = i + 1) { r.v[i] = (expr); } return r;
+#define SIMD_MASK(cond) ((cond) ? maskTrue() : 0.0f)
+
+inline float maskTrue() { union { unsigned int u; float f; } m; m.u = 0xFFFFFFFFu; return m.f; }
+inline unsigned int bitsOf(float f) { union { float f; unsigned int u; } m; m.f = f; return m.u; }
+inline float floatOf(unsigned int u) { union { unsigned int u; float f; } m; m.u = u; return m.f; }
+
+inline float4 operator+(float4 a, float4 b) { SIMD_LANES(a.v[i] + b.v[i]) }
+inline float4 operator-(float4 a, float4 b) { SIMD_LANES(a.v[i] - b.v[i]) }
+inline float4 operator*(float4 a, float4 b) { SIMD_LANES(a.v[i] * b.v[i]) }
+inline float4 operator/(float4 a, float4 b) { SIMD_LANES(a.v[i] / b.v[i]) }
+inline float4 operator&(float4 a, float4 b) { SIMD_LANES(floatOf(bitsOf(a.v[i]) & bitsOf(b.v[i]))) }
+inline float4 operator|(float4 a, float4 b) { SIMD_LANES(floatOf(bitsOf(a.v[i]) | bitsOf(b.v[i]))) }
+inline float4 min4(float4 a, float4 b) { SIMD_LANES(a.v[i] < b.v[i] ? a.v[i] : b.v[i]) }
+inline float4 max4(float4 a, float4 b) { SIMD_LANES(a.v[i] > b.v[i] ? a.v[i] : b.v[i]) }
+inline float4 sqrt4(float4 a) { SIMD_LANES(sqrtf(a.v[i])) }
+inline float4 abs4(float4 a) { SIMD_LANES(fabsf(a.v[i])) }
+inline float4 cmplt(float4 a, float4 b) { SIMD_LANES(SIMD_MASK(a.v[i] < b.v[i])) }
+inline float4 cmple(float4 a, float4 b) { SIMD_LANES(SIMD_MASK(a.v[i] <= b.v[i])) }
+inline float4 cmpgt(float4 a, float4 b) { SIMD_LANES(SIMD_MASK(a.v[i] > b.v[i])) }
+inline float4 cmpge(float4 a, float4 b) { SIMD_LANES(SIMD_MASK(a.v[i] >= b.v[i])) }
+inline float4 select(float4 mask, float4 a, float4 b) { SIMD_LANES(bitsOf(mask.v[i]) ? a.v[i] : b.v[i]) }
+inline int movemask(float4 mask) { int m = 0; for(int i = 0; i < 4; i = i + 1) { m |= (bitsOf(mask.v[i]) >> 31) << i; } return m; }
+inline void transpose4(float4& a, float4& b, float4& c, float4& d)
+{
+    float4 rows[4] = { a, b, c, d };
+    a = float4(rows[0].v[0], rows[1].v[0], rows[2].v[0], rows[3].v[0]);
+    b = float4(rows[0].v[1], rows[1].v[1], rows[2].v[1], rows[3].v[1]);
+    c = float4(rows[0].v[2], rows[1].v[2], rows[2].v[2], rows[3].v[2]);
+    d = float4(rows[0].v[3], rows[1].v[3], rows[2].v[3], rows[3].v[3]);
+}
+
+#undef SIMD_LANES
+#undef SIMD_MASK
+
+#endif
+
+#endif // SIMD_HPP
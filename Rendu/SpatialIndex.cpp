@@ -0,0 +1,343 @@
+#include "SpatialIndex.hpp"
+
+
+// Zone couverte (XZ) et nombre de niveaux : le niveau L contient 4^L cellules
+void SpatialIndex::init(glm::vec2 worldMin, float worldSize, int depth)
+{
+    mWorldMin = worldMin;
+    mWorldSize = worldSize;
+    mDepth = glm::max(depth, 1);
+
+    mLevelOffsets.resize(mDepth);
+    uint32_t total = 0;
+    for(int level = 0; level < mDepth; level = level + 1)
+    {
+        mLevelOffsets[level] = total;
+        total = total + (1u << (2 * level));
+    }
+
+    mNodes.assign(total, Node());
+    mEntries.clear();
+    mCount = 0;
+}
+
+// Retirer tous les objets
+void SpatialIndex::clear()
+{
+    init(mWorldMin, mWorldSize, mDepth);
+}
+
+// Nœud où ranger une boîte : le niveau le plus fin dont les cellules sont au moins aussi grandes que la boîte
+// (avec la marge d'une demi-cellule de chaque côté, elle tient alors dans la cellule de son centre)
+uint32_t SpatialIndex::findNode(const AABB& box) const
+{
+    float extent = glm::max(box.max.x - box.min.x, box.max.z - box.min.z);
+
+    int level = 0;
+    while(level + 1 < mDepth && extent <= mWorldSize / (float)(1 << (level + 1)))
+    {
+        level = level + 1;
+    }
+
+    // Les centres hors de la zone sont rangés dans les cellules du bord (la boîte du nœud reste exacte)
+    int dim = 1 << level;
+    glm::vec3 center = box.getCenter();
+    int x = (int)glm::floor((center.x - mWorldMin.x) / mWorldSize * (float)dim);
+    int z = (int)glm::floor((center.z - mWorldMin.y) / mWorldSize * (float)dim);
+    x = glm::clamp(x, 0, dim - 1);
+    z = glm::clamp(z, 0, dim - 1);
+
+    return nodeIndex(level, x, z);
+}
+
+// Nœud parent (INVALID_NODE pour la racine)
+uint32_t SpatialIndex::parentIndex(uint32_t node) const
+{
+    int level = mDepth - 1;
+    while(level > 0 && node < mLevelOffsets[level])
+    {
+        level = level - 1;
+    }
+    if(level == 0)
+    {
+        return INVALID_NODE;
+    }
+
+    uint32_t local = node - mLevelOffsets[level];
+    int dim = 1 << level;
+    int x = (int)(local % (uint32_t)dim);
+    int z = (int)(local / (uint32_t)dim);
+    return nodeIndex(level - 1, x / 2, z / 2);
+}
+
+// Ajouter un objet : la boîte et le nombre d'objets de chaque ancêtre sont mis à jour
+void SpatialIndex::insert(uint32_t id, const AABB& box)
+{
+    if(id >= mEntries.size())
+    {
+        mEntries.resize(id + 1);
+    }
+    if(mEntries[id].node != INVALID_NODE)
+    {
+        move(id, box);
+        return;
+    }
+    if(box.isEmpty())
+    {
+        return; // Objet sans géométrie : jamais trouvé
+    }
+
+    uint32_t node = findNode(box);
+    Entry& entry = mEntries[id];
+    entry.box = box;
+    entry.node = node;
+    entry.slot = (uint32_t)mNodes[node].objects.size();
+    mNodes[node].objects.push_back(id);
+
+    for(uint32_t n = node; n != INVALID_NODE; n = parentIndex(n))
+    {
+        mNodes[n].bounds.expand(box.min);
+        mNodes[n].bounds.expand(box.max);
+        mNodes[n].count = mNodes[n].count + 1;
+    }
+    mCount = mCount + 1;
+}
+
+// Retirer un objet : le dernier objet du nœud prend sa place
+void SpatialIndex::remove(uint32_t id)
+{
+    if(!contains(id))
+    {
+        return;
+    }
+
+    Entry& entry = mEntries[id];
+    std::vector<uint32_t>& objects = mNodes[entry.node].objects;
+    uint32_t last = objects.back();
+    objects[entry.slot] = last;
+    mEntries[last].slot = entry.slot;
+    objects.pop_back();
+
+    for(uint32_t n = entry.node; n != INVALID_NODE; n = parentIndex(n))
+    {
+        mNodes[n].count = mNodes[n].count - 1;
+        if(mNodes[n].count == 0)
+        {
+            mNodes[n].bounds = AABB(); // Sous-arbre vide : la boîte peut repartir de zéro
+        }
+    }
+
+    entry.node = INVALID_NODE;
+    mCount = mCount - 1;
+}
+
+// Déplacer un objet : il ne change de nœud que s'il sort de sa cellule
+void SpatialIndex::move(uint32_t id, const AABB& box)
+{
+    if(!contains(id))
+    {
+        insert(id, box);
+        return;
+    }
+    if(box.isEmpty())
+    {
+        remove(id);
+        return;
+    }
+
+    uint32_t node = findNode(box);
+    if(node != mEntries[id].node)
+    {
+        remove(id);
+        insert(id, box);
+        return;
+    }
+
+    mEntries[id].box = box;
+    for(uint32_t n = node; n != INVALID_NODE; n = parentIndex(n))
+    {
+        mNodes[n].bounds.expand(box.min);
+        mNodes[n].bounds.expand(box.max);
+    }
+}
+
+
+// Requêtes--------------------------------------------------------
+
+// Objets au moins en partie dans la pyramide : un sous-arbre entièrement dedans est ajouté sans autre test
+void SpatialIndex::queryFrustum(const Frustum& frustum, std::vector<uint32_t>& result) const
+{
+    if(!mNodes.empty())
+    {
+        frustumNode(frustum, 0, 0, 0, result);
+    }
+}
+
+// Objets qui touchent la sphère
+void SpatialIndex::querySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const
+{
+    if(!mNodes.empty())
+    {
+        sphereNode(center, radius, 0, 0, 0, result);
+    }
+}
+
+// Objets traversés par le rayon entre 0 et maxDistance (direction normalisée ou non : distance en unités de direction)
+void SpatialIndex::queryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, std::vector<uint32_t>& result) const
+{
+    if(!mNodes.empty())
+    {
+        rayNode(origin, 1.0f / direction, maxDistance, 0, 0, 0, result);
+    }
+}
+
+// Tous les objets d'un sous-arbre
+void SpatialIndex::collectAll(int level, int x, int z, std::vector<uint32_t>& result) const
+{
+    const Node& node = mNodes[nodeIndex(level, x, z)];
+    if(node.count == 0)
+    {
+        return;
+    }
+
+    result.insert(result.end(), node.objects.begin(), node.objects.end());
+    if(level + 1 < mDepth)
+    {
+        for(int c = 0; c < 4; c = c + 1)
+        {
+            collectAll(level + 1, x * 2 + (c & 1), z * 2 + (c >> 1), result);
+        }
+    }
+}
+
+void SpatialIndex::frustumNode(const Frustum& frustum, int level, int x, int z, std::vector<uint32_t>& result) const
+{
+    const Node& node = mNodes[nodeIndex(level, x, z)];
+    if(node.count == 0)
+    {
+        return;
+    }
+
+    Overlap overlap = frustumOverlap(frustum, node.bounds);
+    if(overlap == OUTSIDE)
+    {
+        return;
+    }
+    if(overlap == INSIDE)
+    {
+        collectAll(level, x, z, result);
+        return;
+    }
+
+    for(uint32_t id : node.objects)
+    {
+        if(frustumOverlap(frustum, mEntries[id].box) != OUTSIDE)
+        {
+            result.push_back(id);
+        }
+    }
+
+    if(level + 1 < mDepth)
+    {
+        for(int c = 0; c < 4; c = c + 1)
+        {
+            frustumNode(frustum, level + 1, x * 2 + (c & 1), z * 2 + (c >> 1), result);
+        }
+    }
+}
+
+void SpatialIndex::sphereNode(const glm::vec3& center, float radius, int level, int x, int z, std::vector<uint32_t>& result) const
+{
+    const Node& node = mNodes[nodeIndex(level, x, z)];
+    if(node.count == 0 || !sphereOverlap(center, radius, node.bounds))
+    {
+        return;
+    }
+
+    for(uint32_t id : node.objects)
+    {
+        if(sphereOverlap(center, radius, mEntries[id].box))
+        {
+            result.push_back(id);
+        }
+    }
+
+    if(level + 1 < mDepth)
+    {
+        for(int c = 0; c < 4; c = c + 1)
+        {
+            sphereNode(center, radius, level + 1, x * 2 + (c & 1), z * 2 + (c >> 1), result);
+        }
+    }
+}
+
+void SpatialIndex::rayNode(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance, int level, int x, int z, std::vector<uint32_t>& result) const
+{
+    const Node& node = mNodes[nodeIndex(level, x, z)];
+    if(node.count == 0 || !rayOverlap(origin, invDirection, maxDistance, node.bounds))
+    {
+        return;
+    }
+
+    for(uint32_t id : node.objects)
+    {
+        if(rayOverlap(origin, invDirection, maxDistance, mEntries[id].box))
+        {
+            result.push_back(id);
+        }
+    }
+
+    if(level + 1 < mDepth)
+    {
+        for(int c = 0; c < 4; c = c + 1)
+        {
+            rayNode(origin, invDirection, maxDistance, level + 1, x * 2 + (c & 1), z * 2 + (c >> 1), result);
+        }
+    }
+}
+
+
+// Tests-----------------------------------------------------------
+
+// Position d'une boîte par rapport à la pyramide : coin le plus avancé derrière un plan -> dehors,
+// coin le plus reculé devant tous les plans -> entièrement dedans
+SpatialIndex::Overlap SpatialIndex::frustumOverlap(const Frustum& frustum, const AABB& box)
+{
+    Overlap overlap = INSIDE;
+    for(int p = 0; p < 6; p = p + 1)
+    {
+        const glm::vec4& plane = frustum.planes[p];
+        glm::vec3 positive(plane.x >= 0.0f ? box.max.x : box.min.x, plane.y >= 0.0f ? box.max.y : box.min.y, plane.z >= 0.0f ? box.max.z : box.min.z);
+        glm::vec3 negative(plane.x >= 0.0f ? box.min.x : box.max.x, plane.y >= 0.0f ? box.min.y : box.max.y, plane.z >= 0.0f ? box.min.z : box.max.z);
+
+        if(glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+        {
+            return OUTSIDE;
+        }
+        if(glm::dot(glm::vec3(plane), negative) + plane.w < 0.0f)
+        {
+            overlap = PARTIAL;
+        }
+    }
+    return overlap;
+}
+
+// La sphère touche la boîte : distance au carré entre le centre et le point le plus proche de la boîte
+bool SpatialIndex::sphereOverlap(const glm::vec3& center, float radius, const AABB& box)
+{
+    glm::vec3 d = glm::max(glm::max(box.min - center, center - box.max), glm::vec3(0.0f));
+    return glm::dot(d, d) <= radius * radius;
+}
+
+// Le rayon traverse la boîte entre 0 et maxDistance (méthode des dalles)
+bool SpatialIndex::rayOverlap(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance, const AABB& box)
+{
+    glm::vec3 t0 = (box.min - origin) * invDirection;
+    glm::vec3 t1 = (box.max - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+
+    float enter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.0f));
+    float exit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, maxDistance));
+    return enter <= exit;
+}
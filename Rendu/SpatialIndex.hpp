@@ -0,0 +1,74 @@
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Bounds.hpp"
+
+// Index spatial des objets de la scène : quadtree lâche sur le plan XZ (la forêt est presque plate).
+// Un objet est rangé dans la cellule la plus fine deux fois plus grande que lui qui contient son centre,
+// trouvée directement par calcul (pas de descente). Les cellules sont stockées niveau par niveau
+// dans un tableau complet. Chaque nœud garde la boîte de tous les objets de son sous-arbre
+// (agrandie à l'insertion, jamais réduite) et leur nombre, pour élaguer les branches vides.
+class SpatialIndex
+{
+public:
+    void init(glm::vec2 worldMin, float worldSize, int depth); // Zone couverte (XZ) et nombre de niveaux
+    void clear(); // Retirer tous les objets
+
+    void insert(uint32_t id, const AABB& box); // Ajouter un objet (id : index de l'objet dans la scène, boîte vide ignorée)
+    void remove(uint32_t id); // Retirer un objet
+    void move(uint32_t id, const AABB& box); // Déplacer un objet
+
+    // Requêtes : les identifiants trouvés sont ajoutés à la fin de result
+    void queryFrustum(const Frustum& frustum, std::vector<uint32_t>& result) const; // Objets au moins en partie dans la pyramide
+    void querySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const; // Objets qui touchent la sphère
+    void queryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, std::vector<uint32_t>& result) const; // Objets traversés par le rayon
+
+    size_t size() const { return mCount; } // Nombre d'objets
+    bool contains(uint32_t id) const { return id < mEntries.size() && mEntries[id].node != INVALID_NODE; } // L'objet est dans l'index
+    const AABB& getBounds(uint32_t id) const { return mEntries[id].box; } // Boîte d'un objet
+
+private:
+    static const uint32_t INVALID_NODE = 0xFFFFFFFF;
+
+    struct Node
+    {
+        AABB bounds; // Boîte des objets du sous-arbre
+        uint32_t count = 0; // Nombre d'objets du sous-arbre
+        std::vector<uint32_t> objects; // Objets rangés dans ce nœud
+    };
+
+    struct Entry
+    {
+        AABB box; // Boîte de l'objet
+        uint32_t node = INVALID_NODE; // Nœud qui contient l'objet
+        uint32_t slot = 0; // Position dans la liste du nœud
+    };
+
+    enum Overlap { OUTSIDE, PARTIAL, INSIDE };
+
+    uint32_t findNode(const AABB& box) const; // Nœud où ranger une boîte
+    uint32_t nodeIndex(int level, int x, int z) const { return mLevelOffsets[level] + (uint32_t)z * (1u << level) + (uint32_t)x; }
+    uint32_t parentIndex(uint32_t node) const; // Nœud parent (INVALID_NODE pour la racine)
+    void collectAll(int level, int x, int z, std::vector<uint32_t>& result) const; // Tous les objets d'un sous-arbre
+    void frustumNode(const Frustum& frustum, int level, int x, int z, std::vector<uint32_t>& result) const;
+    void sphereNode(const glm::vec3& center, float radius, int level, int x, int z, std::vector<uint32_t>& result) const;
+    void rayNode(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance, int level, int x, int z, std::vector<uint32_t>& result) const;
+
+    static Overlap frustumOverlap(const Frustum& frustum, const AABB& box); // Position d'une boîte par rapport à la pyramide
+    static bool sphereOverlap(const glm::vec3& center, float radius, const AABB& box); // La sphère touche la boîte
+    static bool rayOverlap(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance, const AABB& box); // Le rayon traverse la boîte
+
+    glm::vec2 mWorldMin = glm::vec2(0.0f); // Coin de la zone couverte
+    float mWorldSize = 1.0f; // Côté de la zone couverte
+    int mDepth = 1; // Nombre de niveaux
+    std::vector<uint32_t> mLevelOffsets; // Premier nœud de chaque niveau
+    std::vector<Node> mNodes; // Nœuds, niveau par niveau
+    std::vector<Entry> mEntries; // Objets, par identifiant
+    size_t mCount = 0; // Nombre d'objets
+};
+
+#endif // SPATIAL_INDEX_HPP
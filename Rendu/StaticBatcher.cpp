@@ -0,0 +1,142 @@
+#include "StaticBatcher.hpp"
+#include <cmath>
+#include <algorithm>
+
+
+// Origine et taille des cellules (vide les lots)
+void StaticBatcher::init(glm::vec2 worldMin, float cellSize)
+{
+    mWorldMin = worldMin;
+    mCellSize = cellSize;
+    mObjects.clear();
+    mBatches.clear();
+    mRebuilt.clear();
+    mBounds.clear();
+    mObjectCount = 0;
+}
+
+// Lot du matériau et de la cellule du centre de l'objet, créé s'il n'existe pas
+int StaticBatcher::findBatch(const Object& object)
+{
+    glm::vec3 center = transformAABB(object.bounds, object.world).getCenter();
+    glm::ivec2 cell((int)std::floor((center.x - mWorldMin.x) / mCellSize), (int)std::floor((center.z - mWorldMin.y) / mCellSize));
+
+    for(size_t b = 0; b < mBatches.size(); b = b + 1)
+    {
+        const Batch& batch = mBatches[b];
+        if(batch.material == object.material && batch.cell == cell && batch.castShadow == object.castShadow)
+        {
+            return (int)b;
+        }
+    }
+
+    Batch batch;
+    batch.material = object.material;
+    batch.cell = cell;
+    batch.castShadow = object.castShadow;
+    batch.dirty = true;
+    mBatches.push_back(std::move(batch));
+    mBounds.push(AABB());
+    return (int)mBatches.size() - 1;
+}
+
+// Retirer un objet de son lot (le lot sera refait)
+void StaticBatcher::detach(uint32_t object)
+{
+    int b = mObjects[object].batch;
+    if(b < 0)
+    {
+        return;
+    }
+
+    std::vector<uint32_t>& objects = mBatches[b].objects;
+    objects.erase(std::find(objects.begin(), objects.end(), object));
+    mBatches[b].dirty = true;
+    mObjects[object].batch = -1;
+    mObjectCount = mObjectCount - 1;
+}
+
+// Ajouter un objet de la scène à son lot
+void StaticBatcher::add(uint32_t object, const std::vector<Vertex>& vertices, const AABB& bounds, uint32_t material, const glm::mat4& world, bool castShadow)
+{
+    if(vertices.empty())
+    {
+        return;
+    }
+
+    if(object >= mObjects.size())
+    {
+        mObjects.resize(object + 1);
+    }
+    detach(object);
+
+    Object& entry = mObjects[object];
+    entry.vertices = &vertices;
+    entry.bounds = bounds;
+    entry.material = material;
+    entry.world = world;
+    entry.castShadow = castShadow;
+    entry.batch = findBatch(entry);
+
+    mBatches[entry.batch].objects.push_back(object);
+    mBatches[entry.batch].dirty = true;
+    mObjectCount = mObjectCount + 1;
+}
+
+// Déplacer un objet : son lot est refait, et celui de sa nouvelle cellule s'il en change
+void StaticBatcher::move(uint32_t object, const glm::mat4& world)
+{
+    if(!isBatched(object))
+    {
+        return;
+    }
+
+    Object entry = mObjects[object];
+    add(object, *entry.vertices, entry.bounds, entry.material, world, entry.castShadow);
+}
+
+// Retirer un objet
+void StaticBatcher::remove(uint32_t object)
+{
+    if(object < mObjects.size())
+    {
+        detach(object);
+    }
+}
+
+// Refaire les lots modifiés : sommets de chaque objet transformés en monde (normales par l'inverse transposée)
+size_t StaticBatcher::rebuild()
+{
+    mRebuilt.clear();
+    for(size_t b = 0; b < mBatches.size(); b = b + 1)
+    {
+        Batch& batch = mBatches[b];
+        if(!batch.dirty)
+        {
+            continue;
+        }
+
+        std::vector<Vertex>& vertices = batch.vertices;
+        vertices.clear();
+        AABB bounds;
+        for(uint32_t object : batch.objects)
+        {
+            const Object& entry = mObjects[object];
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(entry.world)));
+            for(const Vertex& vertex : *entry.vertices)
+            {
+                Vertex world;
+                world.position = glm::vec3(entry.world * glm::vec4(vertex.position, 1.0f));
+                world.normal = glm::normalize(normalMatrix * vertex.normal);
+                world.texCoords = vertex.texCoords;
+                vertices.push_back(world);
+                bounds.expand(world.position);
+            }
+        }
+
+        mBounds.set(b, bounds);
+        batch.dirty = false;
+        mRebuilt.push_back((uint32_t)b);
+    }
+    return mRebuilt.size();
+}
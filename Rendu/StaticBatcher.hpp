@@ -0,0 +1,68 @@
+#ifndef STATIC_BATCHER_HPP
+#define STATIC_BATCHER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Mesh.hpp"
+#include "Bounds.hpp"
+
+// Lots statiques : les sommets des objets qui ne bougent pas sont transformés une fois en monde
+// et fusionnés par matériau (texture) et par cellule d'une grille XZ (un lot = un dessin).
+// Les cellules gardent des lots assez petits pour être éliminés contre la pyramide de vue.
+// Ajouter, déplacer ou retirer un objet marque seulement ses lots ; rebuild ne refait que ceux-là
+// et donne leur liste, l'appelant envoyant leurs sommets au GPU (aucun appel OpenGL ici).
+class StaticBatcher
+{
+public:
+    void init(glm::vec2 worldMin, float cellSize); // Origine et taille des cellules (vide les lots)
+    void add(uint32_t object, const std::vector<Vertex>& vertices, const AABB& bounds, uint32_t material, const glm::mat4& world, bool castShadow); // Ajouter un objet de la scène (sommets et boîte locaux, gardés par l'appelant)
+    void move(uint32_t object, const glm::mat4& world); // Déplacer un objet (peut changer de cellule)
+    void remove(uint32_t object); // Retirer un objet
+    size_t rebuild(); // Refaire les lots modifiés (renvoie leur nombre)
+
+    bool isBatched(uint32_t object) const { return object < mObjects.size() && mObjects[object].batch >= 0; } // Objet dessiné par un lot
+    size_t size() const { return mBatches.size(); } // Nombre de lots (un lot vidé garde sa place)
+    const std::vector<Vertex>& getVertices(size_t batch) const { return mBatches[batch].vertices; } // Sommets en monde du lot
+    uint32_t getMaterial(size_t batch) const { return mBatches[batch].material; }
+    bool castsShadow(size_t batch) const { return mBatches[batch].castShadow; }
+    const std::vector<uint32_t>& getObjects(size_t batch) const { return mBatches[batch].objects; } // Objets du lot
+    const std::vector<uint32_t>& getRebuilt() const { return mRebuilt; } // Lots refaits par le dernier rebuild
+    const AABBArray& getBounds() const { return mBounds; } // Boîte de chaque lot (tests SIMD)
+    size_t getObjectCount() const { return mObjectCount; } // Objets dans les lots
+
+private:
+    struct Object
+    {
+        const std::vector<Vertex>* vertices = nullptr;
+        AABB bounds;
+        uint32_t material = 0;
+        glm::mat4 world = glm::mat4(1.0f);
+        bool castShadow = false;
+        int batch = -1; // Lot de l'objet (-1 : pas dans un lot)
+    };
+
+    struct Batch
+    {
+        uint32_t material;
+        glm::ivec2 cell;
+        bool castShadow;
+        std::vector<uint32_t> objects;
+        std::vector<Vertex> vertices;
+        bool dirty;
+    };
+
+    int findBatch(const Object& object); // Lot du matériau et de la cellule de l'objet (créé s'il n'existe pas)
+    void detach(uint32_t object); // Retirer un objet de son lot
+
+    glm::vec2 mWorldMin = glm::vec2(0.0f);
+    float mCellSize = 1.0f;
+    std::vector<Object> mObjects; // Par index d'objet de la scène
+    std::vector<Batch> mBatches;
+    std::vector<uint32_t> mRebuilt;
+    AABBArray mBounds;
+    size_t mObjectCount = 0;
+};
+
+#endif // STATIC_BATCHER_HPP
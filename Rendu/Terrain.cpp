@@ -0,0 +1,302 @@
+#include "Terrain.hpp"
+#include <cmath>
+#include <algorithm>
+
+
+// Boîte au moins en partie dans la pyramide : coin le plus avancé devant chaque plan
+static bool isInFrustum(const Frustum& frustum, const AABB& box)
+{
+    for(int p = 0; p < 6; p = p + 1)
+    {
+        const glm::vec4& plane = frustum.planes[p];
+        glm::vec3 positive(plane.x >= 0.0f ? box.max.x : box.min.x, plane.y >= 0.0f ? box.max.y : box.min.y, plane.z >= 0.0f ? box.max.z : box.min.z);
+        if(glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// La sphère touche la boîte : distance au carré entre le centre et le point le plus proche de la boîte
+static bool touchesSphere(const AABB& box, const glm::vec3& center, float radius)
+{
+    glm::vec3 d = glm::max(glm::max(box.min - center, center - box.max), glm::vec3(0.0f));
+    return glm::dot(d, d) <= radius * radius;
+}
+
+
+Terrain::Terrain() : mHeightfield(nullptr), mTexture(nullptr), mOrigin(0), mLoaded(false), mStreamedSamples(0), mIndexCount(0), mVAO(0), mVBO(0), mEBO(0), mHeightMap(0)
+{
+}
+
+Terrain::~Terrain()
+{
+    glDeleteVertexArrays(1, &mVAO);
+    glDeleteBuffers(1, &mVBO);
+    glDeleteBuffers(1, &mEBO);
+    glDeleteTextures(1, &mHeightMap);
+}
+
+// Grille commune à tous les noeuds et fenêtre de hauteurs (remplie à la première mise à jour)
+void Terrain::init(const Heightfield& heightfield, Texture2D* texture, const TerrainSettings& settings)
+{
+    mHeightfield = &heightfield;
+    mTexture = texture;
+    mSettings = settings;
+
+    mRanges.clear();
+    float range = mSettings.lodDistance;
+    for(int l = 0; l < mSettings.levelCount; l = l + 1)
+    {
+        mRanges.push_back(range);
+        range = range * 2.0f;
+    }
+
+    // Sommets aux coordonnées entières de la grille, deux triangles par quad
+    int n = mSettings.gridSize;
+    std::vector<glm::vec2> vertices;
+    for(int z = 0; z <= n; z = z + 1)
+    {
+        for(int x = 0; x <= n; x = x + 1)
+        {
+            vertices.push_back(glm::vec2((float)x, (float)z));
+        }
+    }
+
+    // Indices rangés par quart de la grille : un quart se dessine seul avec un quart des indices
+    std::vector<GLuint> indices;
+    int half = n / 2;
+    for(int quadrant = 0; quadrant < 4; quadrant = quadrant + 1)
+    {
+        int x0 = (quadrant & 1) * half;
+        int z0 = (quadrant >> 1) * half;
+        for(int z = z0; z < z0 + half; z = z + 1)
+        {
+            for(int x = x0; x < x0 + half; x = x + 1)
+            {
+                GLuint i = (GLuint)(z * (n + 1) + x);
+                GLuint row = (GLuint)(n + 1);
+                indices.insert(indices.end(), { i, i + row, i + 1, i + 1, i + row, i + row + 1 });
+            }
+        }
+    }
+    mIndexCount = (GLsizei)indices.size();
+
+    if(mVAO == 0)
+    {
+        glGenVertexArrays(1, &mVAO);
+        glGenBuffers(1, &mVBO);
+        glGenBuffers(1, &mEBO);
+        glGenTextures(1, &mHeightMap);
+    }
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (GLvoid*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Fenêtre torique : l'échantillon (x, z) est dans le texel (x, z) modulo la taille, répété au-delà
+    glBindTexture(GL_TEXTURE_2D, mHeightMap);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, mSettings.textureSize, mSettings.textureSize, 0, GL_RED, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    mLoaded = false;
+}
+
+// Côté d'un noeud : la grille du niveau 0 a un échantillon par quad
+float Terrain::getNodeSize(int level) const
+{
+    return mSettings.gridSize * mHeightfield->getSettings().spacing * (float)(1 << level);
+}
+
+// Boîte d'un noeud, hauteurs bornées par celles de toute la carte
+AABB Terrain::getNodeBounds(glm::vec2 offset, int level) const
+{
+    float size = getNodeSize(level);
+    AABB box;
+    box.min = glm::vec3(offset.x, mHeightfield->getMinHeight(), offset.y);
+    box.max = glm::vec3(offset.x + size, mHeightfield->getMaxHeight(), offset.y + size);
+    return box;
+}
+
+// Un noeud à portée de son niveau est dessiné entier s'il est hors de la portée du niveau plus fin, sinon
+// ses enfants sont choisis à leur tour ; le quart d'un enfant hors de sa portée est dessiné par le parent
+// (grille et transition du parent, comme ses voisins de même niveau : pas de fissure)
+bool Terrain::selectNode(glm::vec2 offset, int level, const glm::vec3& viewPos, const Frustum& frustum)
+{
+    AABB box = getNodeBounds(offset, level);
+    if(!touchesSphere(box, viewPos, mRanges[level]))
+    {
+        return false;
+    }
+    if(!isInFrustum(frustum, box))
+    {
+        return true; // Hors champ : ni le noeud ni ses enfants
+    }
+    if(level == 0 || !touchesSphere(box, viewPos, mRanges[level - 1]))
+    {
+        mNodes.push_back({ offset, level, -1 });
+        return true;
+    }
+
+    float half = getNodeSize(level - 1);
+    for(int child = 0; child < 4; child = child + 1)
+    {
+        glm::vec2 childOffset = offset + glm::vec2((float)(child & 1), (float)(child >> 1)) * half;
+        if(!selectNode(childOffset, level - 1, viewPos, frustum) && isInFrustum(frustum, getNodeBounds(childOffset, level - 1)))
+        {
+            mNodes.push_back({ offset, level, child });
+        }
+    }
+    return true;
+}
+
+// Suivre la caméra : fenêtre recentrée par pas entiers, seules les bandes entrées dans la fenêtre sont calculées
+void Terrain::streamWindow(const glm::vec3& viewPos)
+{
+    int size = mSettings.textureSize;
+    int step = mSettings.streamStep;
+    float spacing = mHeightfield->getSettings().spacing;
+    glm::ivec2 center((int)std::floor(viewPos.x / spacing / step) * step, (int)std::floor(viewPos.z / spacing / step) * step);
+    glm::ivec2 origin = center - size / 2;
+
+    if(mLoaded && origin == mOrigin)
+    {
+        return;
+    }
+
+    if(!mLoaded || std::abs(origin.x - mOrigin.x) >= size || std::abs(origin.y - mOrigin.y) >= size)
+    {
+        uploadRegion(origin.x, origin.y, size, size);
+    }
+    else
+    {
+        // Colonnes entrées, sur toute la hauteur de la nouvelle fenêtre
+        if(origin.x > mOrigin.x)
+        {
+            uploadRegion(mOrigin.x + size, origin.y, origin.x - mOrigin.x, size);
+        }
+        else if(origin.x < mOrigin.x)
+        {
+            uploadRegion(origin.x, origin.y, mOrigin.x - origin.x, size);
+        }
+
+        // Lignes entrées, sur les colonnes communes aux deux fenêtres
+        int x0 = std::max(origin.x, mOrigin.x);
+        int x1 = std::min(origin.x, mOrigin.x) + size;
+        if(origin.y > mOrigin.y)
+        {
+            uploadRegion(x0, mOrigin.y + size, x1 - x0, origin.y - mOrigin.y);
+        }
+        else if(origin.y < mOrigin.y)
+        {
+            uploadRegion(x0, origin.y, x1 - x0, mOrigin.y - origin.y);
+        }
+    }
+
+    mOrigin = origin;
+    mLoaded = true;
+}
+
+// Bloc d'échantillons découpé aux bords de la texture (au plus 4 envois)
+void Terrain::uploadRegion(int x, int z, int width, int height)
+{
+    int size = mSettings.textureSize;
+    glBindTexture(GL_TEXTURE_2D, mHeightMap);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    for(int z0 = z; z0 < z + height; )
+    {
+        int tz = ((z0 % size) + size) % size;
+        int h = std::min(z + height - z0, size - tz);
+        for(int x0 = x; x0 < x + width; )
+        {
+            int tx = ((x0 % size) + size) % size;
+            int w = std::min(x + width - x0, size - tx);
+
+            mSamples.resize((size_t)w * h);
+            mHeightfield->getSamples(x0, z0, w, h, mSamples.data());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, tx, tz, w, h, GL_RED, GL_FLOAT, mSamples.data());
+            mStreamedSamples = mStreamedSamples + mSamples.size();
+            x0 = x0 + w;
+        }
+        z0 = z0 + h;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Fenêtre de hauteurs, puis noeuds de l'image depuis les racines à portée du dernier niveau
+void Terrain::update(const glm::vec3& viewPos, const Frustum& frustum)
+{
+    mStreamedSamples = 0;
+    streamWindow(viewPos);
+
+    mNodes.clear();
+    int top = mSettings.levelCount - 1;
+    float rootSize = getNodeSize(top);
+    float range = mRanges[top];
+    int x0 = (int)std::floor((viewPos.x - range) / rootSize);
+    int x1 = (int)std::floor((viewPos.x + range) / rootSize);
+    int z0 = (int)std::floor((viewPos.z - range) / rootSize);
+    int z1 = (int)std::floor((viewPos.z + range) / rootSize);
+    for(int z = z0; z <= z1; z = z + 1)
+    {
+        for(int x = x0; x <= x1; x = x + 1)
+        {
+            selectNode(glm::vec2((float)x, (float)z) * rootSize, top, viewPos, frustum);
+        }
+    }
+}
+
+// Un dessin de la grille par noeud : position, pas de la grille et zone de transition de son niveau
+// (le dernier niveau ne glisse vers aucune grille)
+void Terrain::draw(ShaderProgram& shader, GLuint heightUnit)
+{
+    if(mNodes.empty())
+    {
+        return;
+    }
+
+    shader.use();
+    mTexture->bind(0);
+    shader.setUniformSampler("heightMap", heightUnit);
+    glBindTexture(GL_TEXTURE_2D, mHeightMap);
+    glActiveTexture(GL_TEXTURE0);
+    shader.setUniform("heightMapSize", (float)mSettings.textureSize);
+    shader.setUniform("sampleSpacing", mHeightfield->getSettings().spacing);
+    shader.setUniform("textureScale", mSettings.textureScale);
+
+    glBindVertexArray(mVAO);
+    for(const Node& node : mNodes)
+    {
+        glm::vec2 morphRange(1e30f, 1.0f);
+        if(node.level < mSettings.levelCount - 1)
+        {
+            float end = mRanges[node.level];
+            float previous = node.level > 0 ? mRanges[node.level - 1] : 0.0f;
+            float start = end - mSettings.morphRatio * (end - previous);
+            morphRange = glm::vec2(start, 1.0f / (end - start));
+        }
+
+        shader.setUniform("nodeOffset", node.offset);
+        shader.setUniform("nodeSpacing", getNodeSize(node.level) / mSettings.gridSize);
+        shader.setUniform("morphRange", morphRange);
+        if(node.quadrant < 0)
+        {
+            glDrawElements(GL_TRIANGLES, mIndexCount, GL_UNSIGNED_INT, (GLvoid*)0);
+        }
+        else
+        {
+            GLsizei count = mIndexCount / 4;
+            glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, (GLvoid*)(node.quadrant * count * sizeof(GLuint)));
+        }
+    }
+    glBindVertexArray(0);
+}
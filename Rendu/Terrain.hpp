@@ -0,0 +1,73 @@
+#ifndef TERRAIN_HPP
+#define TERRAIN_HPP
+
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Texture2D.hpp"
+#include "Bounds.hpp"
+#include "Heightfield.hpp"
+
+#define GLEW_STATIC
+
+// Paramètres du rendu du terrain
+struct TerrainSettings
+{
+    int gridSize = 16; // Quads par côté de la grille d'un noeud
+    int levelCount = 3; // Niveaux de détail (noeud du niveau l : gridSize * spacing * 2^l de côté)
+    float lodDistance = 50.0f; // Fin du niveau 0, doublée à chaque niveau (fin du dernier : distance d'affichage)
+    float morphRatio = 0.25f; // Part de chaque niveau où les sommets glissent vers la grille du niveau suivant
+    int textureSize = 1024; // Échantillons par côté de la fenêtre de la carte de hauteur (puissance de 2)
+    int streamStep = 16; // La fenêtre suit la caméra par pas de streamStep échantillons
+    float textureScale = 0.1f; // Répétitions de la texture du sol par unité
+};
+
+// Terrain en CDLOD (niveaux de détail continus selon la distance) : un quadtree de noeuds choisis à chaque
+// image selon la distance à la caméra, tous dessinés avec la même grille. Le shader lit la hauteur de chaque
+// sommet dans la carte de hauteur et fait glisser les sommets impairs vers la grille deux fois plus grossière
+// à l'approche de la fin de leur niveau : aucune fissure ni saut entre les niveaux.
+// La carte de hauteur est une fenêtre torique autour de la caméra (GL_REPEAT) : quand la caméra avance,
+// seules les bandes d'échantillons qui entrent dans la fenêtre sont calculées et envoyées.
+class Terrain
+{
+public:
+    Terrain();
+    ~Terrain();
+
+    void init(const Heightfield& heightfield, Texture2D* texture, const TerrainSettings& settings = TerrainSettings()); // Grille, fenêtre de hauteurs
+    void update(const glm::vec3& viewPos, const Frustum& frustum); // Suivre la caméra avec la fenêtre, choisir les noeuds visibles
+    void draw(ShaderProgram& shader, GLuint heightUnit); // Dessiner les noeuds (view, projection, viewPos et éclairage fixés par l'appelant)
+
+    size_t getNodeCount() const { return mNodes.size(); } // Noeuds dessinés dans l'image
+    size_t getStreamedSamples() const { return mStreamedSamples; } // Échantillons envoyés dans l'image
+
+private:
+    struct Node
+    {
+        glm::vec2 offset; // Coin minimum du noeud (XZ)
+        int level;
+        int quadrant; // Quart du noeud à dessiner (-1 : noeud entier)
+    };
+
+    float getNodeSize(int level) const; // Côté d'un noeud du niveau
+    AABB getNodeBounds(glm::vec2 offset, int level) const; // Boîte d'un noeud (hauteurs bornées par la carte)
+    bool selectNode(glm::vec2 offset, int level, const glm::vec3& viewPos, const Frustum& frustum); // Choisir un noeud, ses enfants ou ses quarts (false : hors de la portée du niveau)
+    void streamWindow(const glm::vec3& viewPos); // Recentrer la fenêtre de hauteurs
+    void uploadRegion(int x, int z, int width, int height); // Calculer et envoyer un bloc d'échantillons (coordonnées de la grille)
+
+    const Heightfield* mHeightfield;
+    Texture2D* mTexture;
+    TerrainSettings mSettings;
+    std::vector<float> mRanges; // Fin de chaque niveau
+    std::vector<Node> mNodes; // Noeuds de l'image
+    std::vector<float> mSamples; // Bloc en cours d'envoi
+    glm::ivec2 mOrigin; // Premier échantillon de la fenêtre
+    bool mLoaded; // Fenêtre remplie
+    size_t mStreamedSamples;
+    GLsizei mIndexCount; // Indices de la grille, rangés par quart
+    GLuint mVAO, mVBO, mEBO, mHeightMap;
+};
+
+#endif // TERRAIN_HPP
@@ -17,6 +17,7 @@ public :
     bool loadTexture(const string& filename, bool generateMipMaps = true); // Charger une texture
     void bind(GLuint texUnit = 0); // Lier la texture
     void unbind(GLuint texUnit = 0); // Delier la texture
+    GLuint getId() const { return mTexture; } // Identifiant de la texture
 
 private :
     GLuint mTexture; // Identifiant de la texture
@@ -0,0 +1,152 @@
+#include <cmath>
+
+#include "TransformStore.hpp"
+#include "Simd.hpp"
+
+
+// Vider le stockage
+void TransformStore::clear()
+{
+    mPosX.clear(); mPosY.clear(); mPosZ.clear();
+    mCos.clear(); mSin.clear();
+    mScaleX.clear(); mScaleY.clear(); mScaleZ.clear();
+    mStatic.clear();
+    mDirty.clear();
+    mDirtyList.clear();
+    mUpdated.clear();
+    mMatrices.clear();
+}
+
+// Ajouter un objet (rotation en degrés) : ses matrices seront calculées au prochain update
+uint32_t TransformStore::add(glm::vec3 position, float rotationY, glm::vec3 scale, bool isStatic)
+{
+    uint32_t index = (uint32_t)mMatrices.size();
+
+    // Nouveau groupe de 4 : remplissage par des objets neutres (échelle 1, pas de division par zéro)
+    if(index % 4 == 0)
+    {
+        mPosX.resize(index + 4, 0.0f); mPosY.resize(index + 4, 0.0f); mPosZ.resize(index + 4, 0.0f);
+        mCos.resize(index + 4, 1.0f); mSin.resize(index + 4, 0.0f);
+        mScaleX.resize(index + 4, 1.0f); mScaleY.resize(index + 4, 1.0f); mScaleZ.resize(index + 4, 1.0f);
+    }
+
+    mMatrices.push_back(TransformMatrices());
+    mStatic.push_back(isStatic ? 1 : 0);
+    mDirty.push_back(0);
+
+    mPosX[index] = position.x; mPosY[index] = position.y; mPosZ[index] = position.z;
+    mScaleX[index] = scale.x; mScaleY[index] = scale.y; mScaleZ[index] = scale.z;
+    mCos[index] = std::cos(glm::radians(rotationY));
+    mSin[index] = std::sin(glm::radians(rotationY));
+
+    markDirty(index);
+    return index;
+}
+
+// Déplacer un objet dynamique
+void TransformStore::setPosition(uint32_t index, glm::vec3 position)
+{
+    mPosX[index] = position.x; mPosY[index] = position.y; mPosZ[index] = position.z;
+    markDirty(index);
+}
+
+// Tourner un objet dynamique (degrés) : le sinus et le cosinus sont calculés ici, pas à chaque matrice
+void TransformStore::setRotation(uint32_t index, float rotationY)
+{
+    mCos[index] = std::cos(glm::radians(rotationY));
+    mSin[index] = std::sin(glm::radians(rotationY));
+    markDirty(index);
+}
+
+// Changer l'échelle d'un objet dynamique
+void TransformStore::setScale(uint32_t index, glm::vec3 scale)
+{
+    mScaleX[index] = scale.x; mScaleY[index] = scale.y; mScaleZ[index] = scale.z;
+    markDirty(index);
+}
+
+// Marquer un objet à recalculer (une seule entrée dans la liste par objet)
+void TransformStore::markDirty(uint32_t index)
+{
+    if(mDirty[index] == 0)
+    {
+        mDirty[index] = 1;
+        mDirtyList.push_back(index);
+    }
+}
+
+// Recalculer les matrices des objets modifiés : chaque groupe de 4 qui contient un objet sale est calculé en entier
+size_t TransformStore::update()
+{
+    mUpdated.clear();
+    for(uint32_t index : mDirtyList)
+    {
+        if(mDirty[index] != 0) // Sinon déjà calculé avec son groupe
+        {
+            computeBlock(index & ~3u);
+        }
+    }
+    mDirtyList.clear();
+
+    return mUpdated.size();
+}
+
+// Recalculer toutes les matrices
+void TransformStore::updateAll()
+{
+    mUpdated.clear();
+    for(size_t i = 0; i < mMatrices.size(); i = i + 4)
+    {
+        computeBlock(i);
+    }
+    mDirtyList.clear();
+}
+
+// Matrices de 4 objets : modèle = translation * rotation Y * échelle, normales = rotation Y * échelle⁻¹.
+//  colonne 0 = ( c.sx, 0, -s.sx)   colonne 1 = (0, sy, 0)   colonne 2 = (s.sz, 0, c.sz)
+void TransformStore::computeBlock(size_t first)
+{
+    float4 c = float4::load(&mCos[first]);
+    float4 s = float4::load(&mSin[first]);
+    float4 sx = float4::load(&mScaleX[first]);
+    float4 sy = float4::load(&mScaleY[first]);
+    float4 sz = float4::load(&mScaleZ[first]);
+    float4 one(1.0f);
+    float4 invX = one / sx;
+    float4 invZ = one / sz;
+
+    // Termes des matrices, une voie par objet
+    float terms[10][4];
+    (c * sx).store(terms[0]);
+    (float4::zero() - s * sx).store(terms[1]);
+    sy.store(terms[2]);
+    (s * sz).store(terms[3]);
+    (c * sz).store(terms[4]);
+    (c * invX).store(terms[5]);
+    (float4::zero() - s * invX).store(terms[6]);
+    (one / sy).store(terms[7]);
+    (s * invZ).store(terms[8]);
+    (c * invZ).store(terms[9]);
+
+    size_t count = glm::min(mMatrices.size() - first, (size_t)4);
+    for(size_t k = 0; k < count; k = k + 1)
+    {
+        size_t i = first + k;
+        TransformMatrices& m = mMatrices[i];
+
+        m.world[0] = glm::vec4(terms[0][k], 0.0f, terms[1][k], 0.0f);
+        m.world[1] = glm::vec4(0.0f, terms[2][k], 0.0f, 0.0f);
+        m.world[2] = glm::vec4(terms[3][k], 0.0f, terms[4][k], 0.0f);
+        m.world[3] = glm::vec4(mPosX[i], mPosY[i], mPosZ[i], 1.0f);
+
+        m.normal[0] = glm::vec4(terms[5][k], 0.0f, terms[6][k], 0.0f);
+        m.normal[1] = glm::vec4(0.0f, terms[7][k], 0.0f, 0.0f);
+        m.normal[2] = glm::vec4(terms[8][k], 0.0f, terms[9][k], 0.0f);
+
+        if(mDirty[i] != 0)
+        {
+            mDirty[i] = 0;
+            mUpdated.push_back((uint32_t)i);
+        }
+    }
+}
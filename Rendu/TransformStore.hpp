@@ -0,0 +1,52 @@
+#ifndef TRANSFORM_STORE_HPP
+#define TRANSFORM_STORE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Matrices d'un objet : modèle et normales (colonnes vec4, même disposition que le début de InstanceData)
+struct TransformMatrices
+{
+    glm::mat4 world; // Matrice de modèle
+    glm::vec4 normal[3]; // Matrice des normales (inverse transposée de la partie 3x3)
+};
+
+// Transformations des objets (translation, rotation autour de Y, échelle) stockées en SoA.
+// Les matrices sont gardées en cache : seules celles des objets modifiés (drapeau "sale")
+// sont recalculées, 4 objets à la fois. Un objet statique n'est calculé qu'une fois.
+// La taille est complétée à un multiple de 4 (échelle 1 pour le remplissage).
+class TransformStore
+{
+public:
+    void clear(); // Vider le stockage
+    uint32_t add(glm::vec3 position, float rotationY, glm::vec3 scale, bool isStatic); // Ajouter un objet (rotation en degrés)
+
+    void setPosition(uint32_t index, glm::vec3 position); // Déplacer un objet dynamique
+    void setRotation(uint32_t index, float rotationY); // Tourner un objet dynamique (degrés)
+    void setScale(uint32_t index, glm::vec3 scale); // Changer l'échelle d'un objet dynamique
+
+    size_t update(); // Recalculer les matrices des objets modifiés (renvoie le nombre de matrices calculées)
+    void updateAll(); // Recalculer toutes les matrices
+
+    size_t size() const { return mMatrices.size(); } // Nombre d'objets
+    bool isStatic(uint32_t index) const { return mStatic[index] != 0; } // Objet qui ne bouge jamais
+    const TransformMatrices& getMatrices(uint32_t index) const { return mMatrices[index]; } // Matrices d'un objet
+    const glm::mat4& getWorld(uint32_t index) const { return mMatrices[index].world; } // Matrice de modèle d'un objet
+    const std::vector<uint32_t>& getUpdated() const { return mUpdated; } // Objets recalculés par le dernier update
+
+private:
+    void markDirty(uint32_t index); // Marquer un objet à recalculer
+    void computeBlock(size_t first); // Calculer les matrices de 4 objets consécutifs
+
+    std::vector<float> mPosX, mPosY, mPosZ; // Positions
+    std::vector<float> mCos, mSin; // Cosinus et sinus de la rotation (calculés une fois par changement)
+    std::vector<float> mScaleX, mScaleY, mScaleZ; // Échelles
+    std::vector<uint8_t> mStatic; // Objet statique
+    std::vector<uint8_t> mDirty; // Matrices à recalculer
+    std::vector<uint32_t> mDirtyList; // Objets marqués depuis le dernier update
+    std::vector<uint32_t> mUpdated; // Objets recalculés par le dernier update
+    std::vector<TransformMatrices> mMatrices; // Matrices en cache
+};
+
+#endif // TRANSFORM_STORE_HPP
@@ -0,0 +1,358 @@
+#include "WorldStreamer.hpp"
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Place libre, pas de morceau en cours de génération
+static const int64_t NO_CHUNK = INT64_MIN;
+
+
+WorldStreamer::WorldStreamer() : mPendingCount(0), mDrawnCount(0), mVBO(0), mBuilding(NO_CHUNK), mStop(false)
+{
+}
+
+WorldStreamer::~WorldStreamer()
+{
+    if(mWorker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mWake.notify_one();
+        mWorker.join();
+    }
+    glDeleteBuffers(1, &mVBO);
+}
+
+// Créer le buffer des places (budget mémoire), les générateurs des couches et le thread de chargement
+void WorldStreamer::init(const StreamSettings& settings, const std::vector<StreamModel>& models)
+{
+    mSettings = settings;
+    mModels = models;
+
+    // Tuiles des générateurs = morceaux du monde
+    mGenerators.clear();
+    for(ForestSettings layer : mSettings.layers)
+    {
+        layer.worldMin = glm::vec2(-0.5f * WORLD_CHUNKS * mSettings.chunkSize);
+        layer.worldSize = WORLD_CHUNKS * mSettings.chunkSize;
+        layer.tileSize = mSettings.chunkSize;
+        mGenerators.push_back(ForestGenerator(layer));
+    }
+
+    size_t slotBytes = mSettings.chunkCapacity * sizeof(InstanceData);
+    size_t slotCount = glm::max(mSettings.memoryBudget / slotBytes, (size_t)1);
+    mSlotChunks.assign(slotCount, NO_CHUNK);
+    mFreeSlots.clear();
+    mSlotBounds.clear();
+    for(size_t s = 0; s < slotCount; s = s + 1)
+    {
+        mFreeSlots.push_back((int)(slotCount - 1 - s));
+        mSlotBounds.push(AABB());
+    }
+    mSlotVisible.assign(mSlotBounds.paddedSize(), 0);
+
+    // Un seul buffer pour toutes les places : jamais réalloué pendant l'exploration
+    glGenBuffers(1, &mVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    glBufferData(GL_ARRAY_BUFFER, slotCount * slotBytes, NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    mWorker = std::thread(&WorldStreamer::workerLoop, this);
+    std::cout << "Monde par morceaux : " << slotCount << " places de " << mSettings.chunkCapacity << " instances (" << (slotCount * slotBytes) / 1024 << " Ko)" << std::endl;
+}
+
+// Distance horizontale de la caméra au rectangle du morceau
+float WorldStreamer::getDistance(int64_t key, glm::vec2 position) const
+{
+    glm::vec2 chunkMin = glm::vec2((float)keyX(key), (float)keyZ(key)) * mSettings.chunkSize;
+    glm::vec2 d = glm::max(glm::max(chunkMin - position, position - (chunkMin + mSettings.chunkSize)), glm::vec2(0.0f));
+    return glm::length(d);
+}
+
+// Générer le contenu d'un morceau : objets de chaque couche posés sur le relief, rangés par modèle
+// (matrices, matrices des normales et boîte englobante calculées ici, pas sur le thread de rendu)
+WorldStreamer::ChunkData WorldStreamer::buildChunk(int64_t key) const
+{
+    int x = keyX(key);
+    int z = keyZ(key);
+
+    std::vector<ForestInstance> placed;
+    for(const ForestGenerator& generator : mGenerators)
+    {
+        generator.generateTile(x + WORLD_CHUNKS / 2, z + WORLD_CHUNKS / 2, placed);
+    }
+    std::stable_sort(placed.begin(), placed.end(), [](const ForestInstance& a, const ForestInstance& b) { return a.model < b.model; });
+
+    ChunkData data;
+    data.key = key;
+    for(size_t i = 0; i < placed.size() && data.instances.size() < mSettings.chunkCapacity; i = i + 1)
+    {
+        ForestInstance object = placed[i];
+        if(object.model >= mModels.size() || mModels[object.model].mesh == nullptr || mModels[object.model].texture == nullptr)
+        {
+            continue;
+        }
+
+        // Les objets de la scène fixe couvrent déjà sa zone
+        glm::vec2 position(object.position.x, object.position.z);
+        if(position.x >= mSettings.residentMin.x && position.y >= mSettings.residentMin.y && position.x < mSettings.residentMax.x && position.y < mSettings.residentMax.y)
+        {
+            continue;
+        }
+
+        if(mSettings.ground != nullptr)
+        {
+            object.position.y = mSettings.ground->getHeight(position.x, position.y);
+        }
+
+        glm::mat4 world = glm::translate(glm::mat4(1.0f), object.position);
+        world = glm::rotate(world, glm::radians(object.yaw), glm::vec3(0.0f, 1.0f, 0.0f));
+        world = glm::scale(world, mModels[object.model].scale);
+
+        AABB box = transformAABB(mModels[object.model].mesh->getBounds(), world);
+        data.bounds.expand(box.min);
+        data.bounds.expand(box.max);
+
+        if(data.ranges.empty() || data.ranges.back().model != object.model)
+        {
+            data.ranges.push_back({ object.model, (GLuint)data.instances.size(), 0 });
+        }
+        data.ranges.back().count = data.ranges.back().count + 1;
+        data.instances.push_back(InstanceBuffer::makeInstance(world));
+    }
+    return data;
+}
+
+// Thread de chargement : génère les morceaux demandés un par un, le plus proche d'abord
+void WorldStreamer::workerLoop()
+{
+    while(true)
+    {
+        int64_t key;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [this]() { return mStop || !mRequests.empty(); });
+            if(mStop)
+            {
+                return;
+            }
+            key = mRequests.front();
+            mRequests.pop_front();
+            mBuilding = key;
+        }
+
+        ChunkData data = buildChunk(key);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCompleted.push_back(std::move(data));
+        mBuilding = NO_CHUNK;
+    }
+}
+
+// Copier un morceau prêt dans une place libre du buffer
+void WorldStreamer::upload(ChunkData& data)
+{
+    int slot = mFreeSlots.back();
+    mFreeSlots.pop_back();
+
+    GLuint first = (GLuint)(slot * mSettings.chunkCapacity);
+    if(!data.instances.empty())
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+        glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(InstanceData), data.instances.size() * sizeof(InstanceData), data.instances.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    Chunk chunk;
+    chunk.slot = slot;
+    chunk.ranges = data.ranges;
+    for(Range& range : chunk.ranges)
+    {
+        range.first = range.first + first;
+    }
+    chunk.instanceCount = data.instances.size();
+
+    mChunks[data.key] = chunk;
+    mSlotChunks[slot] = data.key;
+    mSlotBounds.set(slot, data.bounds);
+}
+
+// Rendre la place d'un morceau (son contenu sera écrasé par le prochain morceau envoyé)
+void WorldStreamer::unload(int64_t key)
+{
+    auto it = mChunks.find(key);
+    if(it == mChunks.end())
+    {
+        return;
+    }
+
+    mSlotChunks[it->second.slot] = NO_CHUNK;
+    mSlotBounds.set(it->second.slot, AABB());
+    mFreeSlots.push_back(it->second.slot);
+    mChunks.erase(it);
+}
+
+// Décharger les morceaux trop loin, demander les morceaux proches manquants (au plus une place chacun),
+// recevoir les morceaux générés et en envoyer quelques-uns au GPU, puis tester les places contre la pyramide
+void WorldStreamer::update(const glm::vec3& viewPos, const Frustum& frustum)
+{
+    glm::vec2 position(viewPos.x, viewPos.z);
+    float unloadDistance = mSettings.loadDistance + mSettings.hysteresis;
+
+    // Déchargement derrière la caméra (au-delà de la marge d'hystérésis)
+    std::vector<int64_t> farChunks;
+    for(const auto& entry : mChunks)
+    {
+        if(getDistance(entry.first, position) > unloadDistance)
+        {
+            farChunks.push_back(entry.first);
+        }
+    }
+    for(int64_t key : farChunks)
+    {
+        unload(key);
+    }
+
+    // Morceaux voulus, du plus proche au plus lointain, pas plus que de places
+    std::vector<std::pair<float, int64_t>> wanted;
+    int radius = (int)std::ceil(mSettings.loadDistance / mSettings.chunkSize);
+    int centerX = (int)std::floor(position.x / mSettings.chunkSize);
+    int centerZ = (int)std::floor(position.y / mSettings.chunkSize);
+    for(int z = centerZ - radius; z <= centerZ + radius; z = z + 1)
+    {
+        for(int x = centerX - radius; x <= centerX + radius; x = x + 1)
+        {
+            glm::vec2 chunkMin = glm::vec2((float)x, (float)z) * mSettings.chunkSize;
+            bool outside = x < -WORLD_CHUNKS / 2 || x >= WORLD_CHUNKS / 2 || z < -WORLD_CHUNKS / 2 || z >= WORLD_CHUNKS / 2;
+            glm::vec2 chunkMax = chunkMin + mSettings.chunkSize;
+            bool resident = chunkMin.x >= mSettings.residentMin.x && chunkMin.y >= mSettings.residentMin.y && chunkMax.x <= mSettings.residentMax.x && chunkMax.y <= mSettings.residentMax.y;
+            int64_t key = makeKey(x, z);
+            float distance = getDistance(key, position);
+            if(!outside && !resident && distance <= mSettings.loadDistance)
+            {
+                wanted.push_back({ distance, key });
+            }
+        }
+    }
+    std::sort(wanted.begin(), wanted.end());
+    wanted.resize(glm::min(wanted.size(), mSlotChunks.size()));
+
+    // Morceaux générés reçus, nouvelle liste de demandes (remplace l'ancienne : les morceaux dépassés ne sont plus générés)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for(ChunkData& data : mCompleted)
+        {
+            mReady.push_back(std::move(data));
+        }
+        mCompleted.clear();
+
+        mRequests.clear();
+        for(const auto& entry : wanted)
+        {
+            int64_t key = entry.second;
+            bool ready = std::any_of(mReady.begin(), mReady.end(), [key](const ChunkData& data) { return data.key == key; });
+            if(mChunks.count(key) == 0 && key != mBuilding && !ready)
+            {
+                mRequests.push_back(key);
+            }
+        }
+        mPendingCount = mRequests.size() + mReady.size() + (mBuilding != NO_CHUNK ? 1 : 0);
+    }
+    mWake.notify_one();
+
+    // Envoi de quelques morceaux par image ; sans place libre, le morceau chargé le plus lointain cède la sienne s'il est plus loin
+    int uploads = 0;
+    while(!mReady.empty() && uploads < mSettings.uploadsPerFrame)
+    {
+        ChunkData data = std::move(mReady.front());
+        mReady.pop_front();
+
+        float distance = getDistance(data.key, position);
+        if(mChunks.count(data.key) != 0 || distance > unloadDistance)
+        {
+            continue;
+        }
+
+        if(mFreeSlots.empty())
+        {
+            int64_t farthest = NO_CHUNK;
+            float farthestDistance = distance;
+            for(const auto& entry : mChunks)
+            {
+                float d = getDistance(entry.first, position);
+                if(d > farthestDistance)
+                {
+                    farthest = entry.first;
+                    farthestDistance = d;
+                }
+            }
+            if(farthest == NO_CHUNK)
+            {
+                continue;
+            }
+            unload(farthest);
+        }
+
+        upload(data);
+        uploads = uploads + 1;
+    }
+
+    frustumCullAABB(mSlotBounds, frustum, mSlotVisible.data());
+    mDrawnCount = 0;
+    for(size_t slot = 0; slot < mSlotChunks.size(); slot = slot + 1)
+    {
+        mSlotVisible[slot] = mSlotVisible[slot] && mSlotChunks[slot] != NO_CHUNK;
+        mDrawnCount = mDrawnCount + mSlotVisible[slot];
+    }
+}
+
+// Dessiner les morceaux visibles : un dessin instancié par modèle et par morceau, rangés par modèle
+void WorldStreamer::draw(ShaderProgram& shader)
+{
+    if(mDrawnCount == 0)
+    {
+        return;
+    }
+
+    std::vector<Range> draws;
+    for(size_t s = 0; s < mSlotChunks.size(); s = s + 1)
+    {
+        if(mSlotVisible[s])
+        {
+            const Chunk& chunk = mChunks[mSlotChunks[s]];
+            draws.insert(draws.end(), chunk.ranges.begin(), chunk.ranges.end());
+        }
+    }
+    std::stable_sort(draws.begin(), draws.end(), [](const Range& a, const Range& b) { return a.model < b.model; });
+
+    shader.use();
+    uint32_t currentModel = 0xFFFFFFFF;
+    for(const Range& range : draws)
+    {
+        const StreamModel& model = mModels[range.model];
+        if(range.model != currentModel)
+        {
+            model.texture->bind(0);
+            model.mesh->bindVertexArray(false);
+            currentModel = range.model;
+        }
+
+        InstanceBuffer::bindAttributes(mVBO, range.first);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, model.mesh->getVertexCount(), range.count);
+    }
+    glBindVertexArray(0);
+}
+
+// Octets d'instances utilisés par les morceaux chargés
+size_t WorldStreamer::getResidentBytes() const
+{
+    size_t count = 0;
+    for(const auto& entry : mChunks)
+    {
+        count = count + entry.second.instanceCount;
+    }
+    return count * sizeof(InstanceData);
+}
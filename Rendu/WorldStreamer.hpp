@@ -0,0 +1,130 @@
+#ifndef WORLD_STREAMER_HPP
+#define WORLD_STREAMER_HPP
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgram.hpp"
+#include "Texture2D.hpp"
+#include "Mesh.hpp"
+#include "Bounds.hpp"
+#include "InstanceBuffer.hpp"
+#include "ForestGenerator.hpp"
+#include "Heightfield.hpp"
+
+#define GLEW_STATIC
+
+// Modèle des morceaux du monde (même index que l'identifiant du modèle)
+struct StreamModel
+{
+    const Mesh* mesh;
+    Texture2D* texture;
+    glm::vec3 scale; // Échelle du modèle
+};
+
+// Paramètres du chargement par morceaux
+struct StreamSettings
+{
+    float chunkSize = 100.0f; // Côté d'un morceau
+    float loadDistance = 250.0f; // Morceaux chargés à moins de cette distance de la caméra
+    float hysteresis = 50.0f; // Marge avant de décharger un morceau (pas d'aller-retour à la limite)
+    size_t memoryBudget = 4 << 20; // Octets d'instances résidentes (nombre de places du buffer)
+    size_t chunkCapacity = 256; // Instances par place (un morceau)
+    int uploadsPerFrame = 4; // Morceaux envoyés au GPU par image au plus (pas d'à-coups)
+    glm::vec2 residentMin = glm::vec2(0.0f); // Zone de la scène fixe : morceaux entièrement dedans jamais chargés, objets dedans retirés
+    glm::vec2 residentMax = glm::vec2(0.0f);
+    const Heightfield* ground = nullptr; // Relief du terrain : objets posés sur le sol (nullptr : sol plat en 0)
+    std::vector<ForestSettings> layers; // Végétation et accessoires : graine, espacement et tables (zone et tuiles fixées par le streamer)
+};
+
+// Monde découpé en morceaux chargés autour de la caméra. Un thread de chargement génère le contenu
+// des morceaux demandés (végétation et accessoires posés sur le relief : instances prêtes à envoyer), du plus proche
+// au plus lointain. Chaque morceau prêt est copié dans une place libre d'un buffer d'instances
+// unique, de taille fixée par le budget mémoire ; la place est rendue quand le morceau est déchargé
+// et resservira au suivant. Aucun buffer n'est créé ou détruit pendant l'exploration.
+class WorldStreamer
+{
+public:
+    static const int WORLD_CHUNKS = 8192; // Morceaux par côté du monde (centré sur l'origine)
+
+    WorldStreamer();
+    ~WorldStreamer();
+
+    void init(const StreamSettings& settings, const std::vector<StreamModel>& models); // Créer le buffer et lancer le thread de chargement
+    void update(const glm::vec3& viewPos, const Frustum& frustum); // Demander, recevoir et décharger les morceaux, morceaux visibles
+    void draw(ShaderProgram& shader); // Dessiner les morceaux visibles (texture diffuse sur l'unité 0)
+
+    size_t getSlotCount() const { return mSlotChunks.size(); } // Places du buffer (budget)
+    size_t getResidentCount() const { return mChunks.size(); } // Morceaux chargés
+    size_t getPendingCount() const { return mPendingCount; } // Morceaux demandés, pas encore reçus
+    size_t getDrawnCount() const { return mDrawnCount; } // Morceaux dessinés dans l'image
+    size_t getResidentBytes() const; // Octets d'instances utilisés par les morceaux chargés
+
+private:
+    // Instances consécutives d'un même modèle dans la place d'un morceau
+    struct Range
+    {
+        uint32_t model;
+        GLuint first;
+        GLsizei count;
+    };
+
+    // Morceau chargé
+    struct Chunk
+    {
+        int slot; // Place dans le buffer
+        std::vector<Range> ranges;
+        size_t instanceCount;
+    };
+
+    // Contenu d'un morceau, préparé par le thread de chargement
+    struct ChunkData
+    {
+        int64_t key;
+        AABB bounds;
+        std::vector<Range> ranges;
+        std::vector<InstanceData> instances;
+    };
+
+    static int64_t makeKey(int x, int z) { return ((int64_t)x << 32) | (uint32_t)z; }
+    static int keyX(int64_t key) { return (int)(key >> 32); }
+    static int keyZ(int64_t key) { return (int)(uint32_t)key; }
+
+    float getDistance(int64_t key, glm::vec2 position) const; // Distance horizontale de la caméra au morceau
+    ChunkData buildChunk(int64_t key) const; // Générer le contenu d'un morceau (thread de chargement)
+    void workerLoop(); // Boucle du thread de chargement
+    void upload(ChunkData& data); // Copier un morceau prêt dans une place libre
+    void unload(int64_t key); // Rendre la place d'un morceau
+
+    StreamSettings mSettings;
+    std::vector<StreamModel> mModels;
+    std::vector<ForestGenerator> mGenerators; // Une couche par générateur, tuiles = morceaux
+
+    std::unordered_map<int64_t, Chunk> mChunks; // Morceaux chargés
+    std::vector<int64_t> mSlotChunks; // Morceau de chaque place (INT64_MIN : libre)
+    std::vector<int> mFreeSlots;
+    AABBArray mSlotBounds; // Boîte de chaque place (vide si libre), tests SIMD contre la pyramide de vue
+    std::vector<uint8_t> mSlotVisible;
+    std::deque<ChunkData> mReady; // Morceaux reçus, en attente d'envoi
+    size_t mPendingCount;
+    size_t mDrawnCount;
+    GLuint mVBO;
+
+    // Partagé avec le thread de chargement
+    std::thread mWorker;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::deque<int64_t> mRequests; // Morceaux à générer, du plus proche au plus lointain
+    int64_t mBuilding; // Morceau en cours de génération (INT64_MIN : aucun)
+    std::vector<ChunkData> mCompleted; // Morceaux générés, pas encore reçus
+    bool mStop;
+};
+
+#endif // WORLD_STREAMER_HPP